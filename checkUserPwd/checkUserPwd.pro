@@ -19,12 +19,17 @@ DEFINES += QT_DEPRECATED_WARNINGS
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
-LIBS += -L/usr/lib/ -lcrypt
+LIBS += -L/usr/lib/ -lpam
 
 target.source += $$TARGET
 target.path = /usr/bin
+
+pam.files = pam.d/checkuserpwd
+pam.path = /etc/pam.d
+
 INSTALLS += \
     target \
+    pam \
 
 SOURCES += \
     main.cpp
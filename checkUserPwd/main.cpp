@@ -19,68 +19,152 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <cstring>
-#include <crypt.h>
+#include <unistd.h>
+#include <pwd.h>
+#include <sys/types.h>
+#include <security/pam_appl.h>
 
-#define SHADOW_FILE "/etc/shadow"
-#define BUFF_SIZE 256
+/* 通过PAM校验用户密码，密码只经由标准输入传递，不再出现在命令行中
+ *
+ * checkuserpwd <user>       从标准输入读取一行密码，校验一次
+ * checkuserpwd --server     常驻模式：循环读取 "用户名\0密码\0"，
+ *                           每个请求回复一行 Success 或 Failed
+ *
+ * 本程序以setuid root安装，非root调用者只能校验自己的密码；
+ * 失败延时沿用pam_unix的默认值，失败次数由pam_faillock持久记录
+ **/
+
+#define PAM_SERVICE   "checkuserpwd"
 #define SIZE 256
 
-static bool checkpwd(char * name, char * currentPwd);
+static bool isAllowedUser(const char * username);
+static bool checkpwd(const char * username, const char * currentPwd);
+static bool readField(char * buf, int size, int delim);
+static void clearBuf(char * buf, int size);
 
 int main(int argc, char *argv[])
 {
-//    QApplication a(argc, argv);
-//    Widget w;
-//    w.show();
-//    return a.exec();
-    if (3 == argc){
-        if (checkpwd(argv[1], argv[2]))
+    char name[SIZE] = {0};
+    char pwd[SIZE] = {0};
+
+    // 常驻模式下每个回复都要立即送达调用方
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    if (2 == argc && 0 == strcmp(argv[1], "--server")){
+        while (readField(name, SIZE, '\0') && readField(pwd, SIZE, '\0')){
+            bool ok = checkpwd(name, pwd);
+            clearBuf(pwd, SIZE);
+            printf(ok ? "Success\n" : "Failed\n");
+        }
+        return 0;
+    }
+
+    if (2 == argc){
+        if (readField(pwd, SIZE, '\n') && checkpwd(argv[1], pwd))
             printf("Success\n");
+        clearBuf(pwd, SIZE);
+        return 0;
+    }
+
+    fprintf(stderr, "usage: checkuserpwd <user> | checkuserpwd --server\n");
+    return 1;
+}
+
+static int conversation(int num_msg, const struct pam_message ** msg,
+                        struct pam_response ** resp, void * appdata_ptr){
+    const char * password = static_cast<const char *>(appdata_ptr);
+
+    if (num_msg <= 0)
+        return PAM_CONV_ERR;
+
+    struct pam_response * reply = static_cast<struct pam_response *>(calloc(num_msg, sizeof(struct pam_response)));
+    if (reply == NULL)
+        return PAM_BUF_ERR;
+
+    for (int i = 0; i < num_msg; i++){
+        switch (msg[i]->msg_style) {
+        case PAM_PROMPT_ECHO_OFF:
+            reply[i].resp = strdup(password);
+            break;
+        case PAM_PROMPT_ECHO_ON:
+        case PAM_ERROR_MSG:
+        case PAM_TEXT_INFO:
+            reply[i].resp = NULL;
+            break;
+        default:
+            free(reply);
+            return PAM_CONV_ERR;
+        }
     }
 
-    return 0;
+    *resp = reply;
+    return PAM_SUCCESS;
 }
 
-static bool checkpwd(char * username, char * currentPwd){
-
-    char buf[BUFF_SIZE] = {0};  /*缓冲区*/
-    FILE *fp = NULL/*,*fd = NULL,*fp_check_shadow = NULL*/;           /*文件指针*/
-    int len = 0;             /*行字符个数*/
-    int line_len = 0;
-    char name[SIZE]={0};
-    char pwd[SIZE]={0};
-    char tmp_1[SIZE]={0};
-    char tmp_2[SIZE]={0};
-    char tmp_3[SIZE]={0};
-    char tmp_4[SIZE]={0};
-    char tmp_5[SIZE]={0};
-    char tmp_6[SIZE]={0};
-    char tmp_7[SIZE]={0};
-
-    if((fp = fopen(SHADOW_FILE,"r")) == NULL){
-        perror("/etc/shadow fail to read\n");
+// 真实uid为0时可校验任意用户，否则只能校验调用者自己
+static bool isAllowedUser(const char * username){
+    uid_t uid = getuid();
+    if (uid == 0)
+        return true;
+
+    struct passwd * pw = getpwuid(uid);
+    if (pw == NULL || pw->pw_name == NULL)
+        return false;
+
+    return strcmp(pw->pw_name, username) == 0;
+}
+
+static bool checkpwd(const char * username, const char * currentPwd){
+    pam_handle_t * pamh = NULL;
+    struct pam_conv conv = {conversation, const_cast<char *>(currentPwd)};
+
+    if (username[0] == '\0')
+        return false;
+
+    if (!isAllowedUser(username)){
+        fprintf(stderr, "checkuserpwd: permission denied for user %s\n", username);
         return false;
     }
 
-    while(fgets(buf,BUFF_SIZE,fp) != NULL){
-        line_len = strlen(buf);
-        len += line_len;
-        sscanf(buf,"%[^:]:%[^:]:%[^:]:%[^:]:%[^:]:%[^:]:%[^:]:%[^:]:%[^:]",name,pwd,tmp_1,tmp_2,tmp_3,tmp_4,tmp_5,tmp_6,tmp_7);
-        //printf("line_name:%s  username:%s   pwd:%s\n",name,username,pwd);
-
-        if(0 == strcmp(name,username)){
-            char * encrypted = NULL;
-            encrypted = crypt(currentPwd, pwd);
-            if ( encrypted && strcmp(encrypted, pwd) == 0){
-                return true;
-            } else {
-                return false;
-            }
-        }
+    int ret = pam_start(PAM_SERVICE, username, &conv, &pamh);
+    if (ret != PAM_SUCCESS){
+        fprintf(stderr, "pam_start failed: %s\n", pam_strerror(pamh, ret));
+        return false;
     }
 
+    ret = pam_authenticate(pamh, PAM_SILENT | PAM_DISALLOW_NULL_AUTHTOK);
+    pam_end(pamh, ret);
 
+    return ret == PAM_SUCCESS;
+}
+
+static bool readField(char * buf, int size, int delim){
+    int len = 0;
+    int ch;
+
+    while ((ch = fgetc(stdin)) != EOF){
+        if (ch == delim){
+            buf[len] = '\0';
+            return true;
+        }
+        // 超长字段丢弃，按校验失败处理
+        if (len < size - 1)
+            buf[len++] = static_cast<char>(ch);
+    }
+
+    // 单次模式下密码末尾可以没有换行
+    if (delim == '\n' && len > 0){
+        buf[len] = '\0';
+        return true;
+    }
     return false;
 }
+
+static void clearBuf(char * buf, int size){
+    volatile char * p = buf;
+    while (size--)
+        *p++ = 0;
+}
@@ -0,0 +1,26 @@
+#-------------------------------------------------
+#
+# desktop文件索引私有库，各插件链接同一份实例
+#
+#-------------------------------------------------
+include(../../env.pri)
+
+QT       -= gui
+
+TEMPLATE = lib
+
+TARGET = $$qtLibraryTarget(desktopentryindex)
+DESTDIR = $$PROJECT_COMPONENTLIBS
+target.path = $${COMPONENTLIB_INSTALL_DIRS}
+INSTALLS += target
+
+##加载glib库，用于解析desktop文件
+CONFIG        += link_pkgconfig \
+                 C++11
+PKGCONFIG     += glib-2.0
+
+SOURCES += \
+        desktopentryindex.cpp \
+
+HEADERS += \
+        desktopentryindex.h \
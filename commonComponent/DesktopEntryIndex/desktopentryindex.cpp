@@ -0,0 +1,394 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "desktopentryindex.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <algorithm>
+
+#include <QDebug>
+
+/* qt会将glib里的signals成员识别为宏，所以取消该宏
+ * 后面如果用到signals时，使用Q_SIGNALS代替即可
+ **/
+#ifdef signals
+#undef signals
+#endif
+
+#include <glib.h>
+
+static QString takeString(gchar * str){
+    QString result = QString::fromUtf8(str);
+    g_free(str);
+    return result;
+}
+
+static QStringList takeStringList(gchar ** list){
+    QStringList result;
+    if (list) {
+        for (int i = 0; list[i] != NULL; i++) {
+            result << QString::fromUtf8(list[i]);
+        }
+        g_strfreev(list);
+    }
+    return result;
+}
+
+static bool keyFileBoolean(GKeyFile * keyfile, const gchar * key){
+    GError * error = NULL;
+    gboolean retval = g_key_file_get_boolean(keyfile, G_KEY_FILE_DESKTOP_GROUP, key, &error);
+    if (error != NULL) {
+        g_error_free(error);
+        return false;
+    }
+    return retval;
+}
+
+DesktopEntryIndex * DesktopEntryIndex::instance(){
+    static QMutex mutex;
+    static DesktopEntryIndex * index = nullptr;
+
+    QMutexLocker locker(&mutex);
+    if (!index) {
+        // 首次调用可能来自后台线程，统一归属到主线程，监视器的信号在主线程处理
+        index = new DesktopEntryIndex;
+        if (qApp) {
+            if (index->thread() != qApp->thread()) {
+                index->moveToThread(qApp->thread());
+            }
+            index->setParent(qApp);
+        }
+    }
+    return index;
+}
+
+DesktopEntryIndex::DesktopEntryIndex(QObject *parent) :
+    QObject(parent),
+    mWatcher(nullptr)
+{
+    auto addDir = [this](const QString &path, DirKind kind) {
+        EntryDir dir;
+        dir.path = QDir::cleanPath(path);
+        dir.kind = kind;
+        dir.stale = true;
+        mDirs.append(dir);
+    };
+
+    addDir(QString::fromUtf8(g_get_user_data_dir()) + "/applications", ApplicationsDir);
+    const gchar * const * datadirs = g_get_system_data_dirs();
+    for (int i = 0; datadirs[i]; i++) {
+        addDir(QString::fromUtf8(datadirs[i]) + "/applications", ApplicationsDir);
+    }
+
+    const gchar * const * configdirs = g_get_system_config_dirs();
+    for (int i = 0; configdirs[i]; i++) {
+        addDir(QString::fromUtf8(configdirs[i]) + "/autostart", SystemAutostartDir);
+    }
+    addDir(QString::fromUtf8(g_get_user_config_dir()) + "/autostart", UserAutostartDir);
+}
+
+DesktopEntryIndex::~DesktopEntryIndex()
+{
+}
+
+DesktopEntry DesktopEntryIndex::application(const QString &id) const{
+    QMutexLocker locker(&mMutex);
+    ensureFresh();
+
+    int index = mById.value(normalizeId(id), -1);
+    if (index < 0)
+        return DesktopEntry();
+    return mApplications.at(index);
+}
+
+QList<DesktopEntry> DesktopEntryIndex::applicationsForExec(const QString &execName) const{
+    QMutexLocker locker(&mMutex);
+    ensureFresh();
+
+    QList<DesktopEntry> result;
+    QList<int> indexes = mByExec.values(execName);
+    // QMultiHash按插入的逆序返回，恢复为目录优先级顺序
+    for (int i = indexes.size() - 1; i >= 0; i--) {
+        result.append(mApplications.at(indexes.at(i)));
+    }
+    return result;
+}
+
+QList<DesktopEntry> DesktopEntryIndex::applicationsForMimeType(const QString &mimeType) const{
+    QMutexLocker locker(&mMutex);
+    ensureFresh();
+
+    QList<DesktopEntry> result;
+    QList<int> indexes = mByMimeType.values(mimeType);
+    for (int i = indexes.size() - 1; i >= 0; i--) {
+        result.append(mApplications.at(indexes.at(i)));
+    }
+    return result;
+}
+
+DesktopEntry DesktopEntryIndex::autostartEntry(const QString &id, AutostartScope scope) const{
+    QMutexLocker locker(&mMutex);
+    ensureFresh();
+
+    DirKind kind = (scope == SystemAutostart) ? SystemAutostartDir : UserAutostartDir;
+    QString desktopId = normalizeId(id);
+    for (const EntryDir &dir : mDirs) {
+        if (dir.kind != kind)
+            continue;
+        for (const DesktopEntry &entry : dir.entries) {
+            if (entry.id == desktopId)
+                return entry;
+        }
+    }
+    return DesktopEntry();
+}
+
+QList<DesktopEntry> DesktopEntryIndex::autostartEntries(AutostartScope scope) const{
+    QMutexLocker locker(&mMutex);
+    ensureFresh();
+
+    DirKind kind = (scope == SystemAutostart) ? SystemAutostartDir : UserAutostartDir;
+    QList<DesktopEntry> result;
+    for (const EntryDir &dir : mDirs) {
+        if (dir.kind == kind)
+            result.append(dir.entries);
+    }
+    return result;
+}
+
+DesktopEntry DesktopEntryIndex::reload(const QString &path){
+    QMutexLocker locker(&mMutex);
+    ensureFresh();
+
+    QString filePath = QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+    for (EntryDir &dir : mDirs) {
+        if (!filePath.startsWith(dir.path + "/"))
+            continue;
+
+        DesktopEntry entry = parse(filePath);
+        entry.id = filePath.mid(dir.path.length() + 1).replace('/', '-');
+
+        for (int i = 0; i < dir.entries.size(); i++) {
+            if (dir.entries.at(i).path == filePath) {
+                dir.entries.removeAt(i);
+                break;
+            }
+        }
+        if (entry.isValid()) {
+            dir.entries.append(entry);
+            std::sort(dir.entries.begin(), dir.entries.end(), [](const DesktopEntry &a, const DesktopEntry &b) {
+                return a.id < b.id;
+            });
+        }
+
+        if (dir.kind == ApplicationsDir)
+            rebuildLookup();
+        return entry;
+    }
+
+    // 不在索引目录中的文件直接解析
+    return parse(filePath);
+}
+
+DesktopEntry DesktopEntryIndex::parse(const QString &path){
+    DesktopEntry entry;
+    GKeyFile * keyfile = g_key_file_new();
+    QByteArray ba = path.toUtf8();
+
+    if (!g_key_file_load_from_file(keyfile, ba.constData(), G_KEY_FILE_NONE, NULL) ||
+            !g_key_file_has_group(keyfile, G_KEY_FILE_DESKTOP_GROUP)) {
+        g_key_file_free(keyfile);
+        return entry;
+    }
+
+    entry.path = path;
+    entry.id = QFileInfo(path).fileName();
+    entry.name = takeString(g_key_file_get_locale_string(keyfile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_NAME, NULL, NULL));
+    entry.comment = takeString(g_key_file_get_locale_string(keyfile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_COMMENT, NULL, NULL));
+    entry.icon = takeString(g_key_file_get_locale_string(keyfile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_ICON, NULL, NULL));
+    entry.exec = takeString(g_key_file_get_string(keyfile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_EXEC, NULL));
+    entry.execName = execBaseName(entry.exec);
+    entry.mimeTypes = takeStringList(g_key_file_get_string_list(keyfile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_MIME_TYPE, NULL, NULL));
+    entry.onlyShowIn = takeStringList(g_key_file_get_string_list(keyfile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_ONLY_SHOW_IN, NULL, NULL));
+    entry.notShowIn = takeStringList(g_key_file_get_string_list(keyfile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_NOT_SHOW_IN, NULL, NULL));
+    entry.noDisplay = keyFileBoolean(keyfile, G_KEY_FILE_DESKTOP_KEY_NO_DISPLAY);
+    entry.hidden = keyFileBoolean(keyfile, G_KEY_FILE_DESKTOP_KEY_HIDDEN);
+
+    g_key_file_free(keyfile);
+    return entry;
+}
+
+void DesktopEntryIndex::ensureFresh() const{
+    bool rescanned = false;
+    bool applicationsChanged = false;
+
+    for (EntryDir &dir : mDirs) {
+        if (!dir.stale)
+            continue;
+        scanDir(dir);
+        rescanned = true;
+        if (dir.kind == ApplicationsDir)
+            applicationsChanged = true;
+    }
+
+    if (applicationsChanged)
+        rebuildLookup();
+
+    if (rescanned) {
+        // 监视器只能在所属线程中修改
+        QMetaObject::invokeMethod(const_cast<DesktopEntryIndex *>(this), "updateWatcher", Qt::QueuedConnection);
+    }
+}
+
+void DesktopEntryIndex::scanDir(EntryDir &dir) const{
+    dir.stale = false;
+    dir.entries.clear();
+    dir.subdirs.clear();
+
+    if (!QFileInfo(dir.path).isDir())
+        return;
+
+    // 应用目录下的子目录按"子目录名-文件名"构成ID
+    QDirIterator::IteratorFlags flags = (dir.kind == ApplicationsDir) ? QDirIterator::Subdirectories
+                                                                      : QDirIterator::NoIteratorFlags;
+    if (dir.kind == ApplicationsDir) {
+        QDirIterator dirIt(dir.path, QDir::Dirs | QDir::NoDotAndDotDot, flags);
+        while (dirIt.hasNext()) {
+            dir.subdirs.append(dirIt.next());
+        }
+    }
+
+    QDirIterator it(dir.path, QStringList() << "*.desktop", QDir::Files, flags);
+    while (it.hasNext()) {
+        QString filePath = it.next();
+        DesktopEntry entry = parse(filePath);
+        if (!entry.isValid())
+            continue;
+        entry.id = filePath.mid(dir.path.length() + 1).replace('/', '-');
+        dir.entries.append(entry);
+    }
+
+    std::sort(dir.entries.begin(), dir.entries.end(), [](const DesktopEntry &a, const DesktopEntry &b) {
+        return a.id < b.id;
+    });
+}
+
+void DesktopEntryIndex::rebuildLookup() const{
+    mApplications.clear();
+    mById.clear();
+    mByExec.clear();
+    mByMimeType.clear();
+
+    for (const EntryDir &dir : mDirs) {
+        if (dir.kind != ApplicationsDir)
+            continue;
+        for (const DesktopEntry &entry : dir.entries) {
+            // 同一ID以优先级高的目录为准
+            if (mById.contains(entry.id))
+                continue;
+
+            int index = mApplications.size();
+            mApplications.append(entry);
+            mById.insert(entry.id, index);
+            if (!entry.execName.isEmpty())
+                mByExec.insert(entry.execName, index);
+            for (const QString &mimeType : entry.mimeTypes) {
+                mByMimeType.insert(mimeType, index);
+            }
+        }
+    }
+}
+
+QString DesktopEntryIndex::normalizeId(const QString &id){
+    if (id.endsWith(".desktop"))
+        return id;
+    return id + ".desktop";
+}
+
+QString DesktopEntryIndex::execBaseName(const QString &exec){
+    if (exec.isEmpty())
+        return QString();
+
+    gint argc = 0;
+    gchar ** argv = NULL;
+    QByteArray ba = exec.toUtf8();
+    if (!g_shell_parse_argv(ba.constData(), &argc, &argv, NULL))
+        return QString();
+
+    QString program;
+    int i = 0;
+    // 跳过 env VAR=VALUE 前缀
+    if (argc > 0 && g_strcmp0(argv[0], "env") == 0) {
+        i = 1;
+        while (i < argc && QByteArray(argv[i]).contains('='))
+            i++;
+    }
+    if (i < argc)
+        program = QFileInfo(QString::fromUtf8(argv[i])).fileName();
+
+    g_strfreev(argv);
+    return program;
+}
+
+void DesktopEntryIndex::updateWatcher(){
+    if (!mWatcher) {
+        mWatcher = new QFileSystemWatcher(this);
+        connect(mWatcher, &QFileSystemWatcher::directoryChanged, this, &DesktopEntryIndex::dirChanged);
+    }
+
+    QStringList paths;
+    {
+        QMutexLocker locker(&mMutex);
+        for (const EntryDir &dir : mDirs) {
+            if (QFileInfo(dir.path).isDir())
+                paths << dir.path;
+            paths << dir.subdirs;
+        }
+    }
+
+    QStringList watched = mWatcher->directories();
+    for (const QString &path : watched) {
+        if (!paths.contains(path))
+            mWatcher->removePath(path);
+    }
+    for (const QString &path : paths) {
+        if (!watched.contains(path))
+            mWatcher->addPath(path);
+    }
+}
+
+void DesktopEntryIndex::dirChanged(const QString &path){
+    {
+        QMutexLocker locker(&mMutex);
+        for (EntryDir &dir : mDirs) {
+            if (dir.path == path || dir.subdirs.contains(path)) {
+                dir.stale = true;
+                break;
+            }
+        }
+    }
+    emit changed();
+}
@@ -0,0 +1,129 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef DESKTOPENTRYINDEX_H
+#define DESKTOPENTRYINDEX_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QMutex>
+
+class QFileSystemWatcher;
+
+struct DesktopEntry
+{
+    QString id;             // desktop文件ID，如 firefox.desktop
+    QString path;
+    QString name;           // 按当前语言环境取的Name
+    QString comment;
+    QString icon;
+    QString exec;
+    QString execName;       // Exec第一个参数的文件名，用于按进程名查找
+    QStringList mimeTypes;
+    QStringList onlyShowIn;
+    QStringList notShowIn;
+    bool noDisplay;
+    bool hidden;
+
+    DesktopEntry() : noDisplay(false), hidden(false) {}
+
+    bool isValid() const { return !path.isEmpty(); }
+};
+
+/**
+ * \brief DesktopEntryIndex
+ * 进程内共享的desktop文件索引：应用目录与autostart目录只扫描一次，
+ * 按ID、Exec文件名和MIME类型建立查找表，之后通过QFileSystemWatcher
+ * 只重新扫描发生变化的目录。查询接口可在任意线程调用。
+ */
+class DesktopEntryIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum AutostartScope {
+        SystemAutostart,    // $XDG_CONFIG_DIRS/autostart
+        UserAutostart       // $XDG_CONFIG_HOME/autostart
+    };
+
+    static DesktopEntryIndex * instance();
+
+public:
+    // id可带或不带.desktop后缀，按XDG目录优先级取第一个
+    DesktopEntry application(const QString &id) const;
+    QList<DesktopEntry> applicationsForExec(const QString &execName) const;
+    QList<DesktopEntry> applicationsForMimeType(const QString &mimeType) const;
+
+    DesktopEntry autostartEntry(const QString &id, AutostartScope scope) const;
+    // 按目录顺序返回，同一目录内按文件名排序
+    QList<DesktopEntry> autostartEntries(AutostartScope scope) const;
+
+    // 自身刚写入或删除的文件不等待inotify，立即更新索引
+    DesktopEntry reload(const QString &path);
+
+    static DesktopEntry parse(const QString &path);
+
+private:
+    enum DirKind {
+        ApplicationsDir,
+        SystemAutostartDir,
+        UserAutostartDir
+    };
+
+    struct EntryDir {
+        QString path;
+        DirKind kind;
+        bool stale;
+        QList<DesktopEntry> entries;
+        QStringList subdirs;    // 应用目录下的厂商子目录，同样需要监视
+    };
+
+    explicit DesktopEntryIndex(QObject *parent = 0);
+    ~DesktopEntryIndex();
+
+    void ensureFresh() const;
+    void scanDir(EntryDir &dir) const;
+    void rebuildLookup() const;
+    static QString normalizeId(const QString &id);
+    static QString execBaseName(const QString &exec);
+
+private Q_SLOTS:
+    void updateWatcher();
+    void dirChanged(const QString &path);
+
+private:
+    mutable QMutex mMutex;
+    mutable QList<EntryDir> mDirs;      // 按XDG优先级排列
+
+    // 应用目录的查找表，值为mApplications中的下标
+    mutable QList<DesktopEntry> mApplications;
+    mutable QHash<QString, int> mById;
+    mutable QMultiHash<QString, int> mByExec;
+    mutable QMultiHash<QString, int> mByMimeType;
+
+    QFileSystemWatcher * mWatcher;
+
+Q_SIGNALS:
+    void changed();
+};
+
+#endif // DESKTOPENTRYINDEX_H
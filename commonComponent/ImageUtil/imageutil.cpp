@@ -21,6 +21,7 @@
 #include "imageutil.h"
 
 #include <QPainter>
+#include <QPixmapCache>
 
 const QPixmap ImageUtil::loadSvg(const QString &path, const QString color, int size)
 {
@@ -31,7 +32,24 @@ const QPixmap ImageUtil::loadSvg(const QString &path, const QString color, int s
     } else if (3 == ratio) {
         size += origSize;
     }
-    QPixmap pixmap(size, size);
+    return renderSvg(path, color, size);
+}
+
+/*
+ * 渲染并着色后的图标按(路径, 颜色, 尺寸, 缩放比)缓存在QPixmapCache中，
+ * 悬浮、切换等重复调用只需一次查找
+ */
+const QPixmap ImageUtil::renderSvg(const QString &path, const QString color, int pixelSize)
+{
+    const auto ratio = qApp->devicePixelRatio();
+    const QString key = QString("ukcc-svg:%1:%2:%3:%4").arg(path).arg(color).arg(pixelSize).arg(ratio);
+
+    QPixmap pixmap;
+    if (QPixmapCache::find(key, &pixmap)) {
+        return pixmap;
+    }
+
+    pixmap = QPixmap(pixelSize, pixelSize);
     QSvgRenderer renderer(path);
     pixmap.fill(Qt::transparent);
 
@@ -41,41 +59,50 @@ const QPixmap ImageUtil::loadSvg(const QString &path, const QString color, int s
     painter.end();
 
     pixmap.setDevicePixelRatio(ratio);
-    return drawSymbolicColoredPixmap(pixmap, color);
+    pixmap = drawSymbolicColoredPixmap(pixmap, color);
+
+    QPixmapCache::insert(key, pixmap);
+    return pixmap;
 }
 
 QPixmap ImageUtil::drawSymbolicColoredPixmap(const QPixmap &source, QString cgColor)
 {
-    QImage img = source.toImage();
-    for (int x = 0; x < img.width(); x++) {
-        for (int y = 0; y < img.height(); y++) {
-            auto color = img.pixelColor(x, y);
-            if (color.alpha() > 0) {
-                if ( "white" == cgColor) {
-                    color.setRed(255);
-                    color.setGreen(255);
-                    color.setBlue(255);
-                    img.setPixelColor(x, y, color);
-                } else if( "black" == cgColor) {
-                    color.setRed(0);
-                    color.setGreen(0);
-                    color.setBlue(0);
-                    img.setPixelColor(x, y, color);
-                } else if ("gray"== cgColor) {
-                    color.setRed(152);
-                    color.setGreen(163);
-                    color.setBlue(164);
-                    img.setPixelColor(x, y, color);
-                } else if ("blue" == cgColor){
-                    color.setRed(61);
-                    color.setGreen(107);
-                    color.setBlue(229);
-                    img.setPixelColor(x, y, color);
-                } else {
-                    return source;
-                }
-            }
+    QRgb rgb;
+    if (!symbolicColor(cgColor, rgb)) {
+        return source;
+    }
+
+    //按透明度预先算好着色后的预乘像素，逐行扫描时只需查表
+    QRgb table[256];
+    for (int alpha = 0; alpha < 256; alpha++) {
+        table[alpha] = qPremultiply(qRgba(qRed(rgb), qGreen(rgb), qBlue(rgb), alpha));
+    }
+
+    QImage img = source.toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < img.height(); y++) {
+        QRgb *line = reinterpret_cast<QRgb *>(img.scanLine(y));
+        for (int x = 0; x < img.width(); x++) {
+            line[x] = table[qAlpha(line[x])];
         }
     }
-    return QPixmap::fromImage(img);
+
+    QPixmap pixmap = QPixmap::fromImage(img);
+    pixmap.setDevicePixelRatio(source.devicePixelRatio());
+    return pixmap;
+}
+
+bool ImageUtil::symbolicColor(const QString &cgColor, QRgb &rgb)
+{
+    if ("white" == cgColor) {
+        rgb = qRgb(255, 255, 255);
+    } else if ("black" == cgColor) {
+        rgb = qRgb(0, 0, 0);
+    } else if ("gray" == cgColor) {
+        rgb = qRgb(152, 163, 164);
+    } else if ("blue" == cgColor) {
+        rgb = qRgb(61, 107, 229);
+    } else {
+        return false;
+    }
+    return true;
 }
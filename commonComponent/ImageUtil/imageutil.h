@@ -29,7 +29,11 @@ class ImageUtil
 {
 public:
     static const QPixmap loadSvg(const QString &path, const QString color, int size = 16);
+    static const QPixmap renderSvg(const QString &path, const QString color, int pixelSize);
     static QPixmap drawSymbolicColoredPixmap(const QPixmap &source, QString cgColor);
+
+private:
+    static bool symbolicColor(const QString &cgColor, QRgb &rgb);
 };
 
 #endif // IMAGEUTIL_H
@@ -0,0 +1,221 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "thumbnailloader.h"
+
+#include <QImageReader>
+#include <QImageWriter>
+#include <QFileInfo>
+#include <QDir>
+#include <QUrl>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QtConcurrent>
+
+// 批量插入的间隔，首批结果到达后最多等待该时长
+#define FLUSH_INTERVAL 40
+
+// freedesktop缩略图规范中的尺寸档位
+#define THUMB_NORMAL_SIZE 128
+#define THUMB_LARGE_SIZE  256
+
+namespace {
+
+struct ScaleFunctor
+{
+    typedef QImage result_type;
+
+    explicit ScaleFunctor(const QSize &size) : mSize(size) {}
+
+    QImage operator()(const QString &filename) const {
+        return ThumbnailLoader::scaledImage(filename, mSize);
+    }
+
+    QSize mSize;
+};
+
+}
+
+ThumbnailLoader::ThumbnailLoader(const QSize &size, QObject *parent) :
+    QObject(parent),
+    mSize(size),
+    mNext(0)
+{
+    mFlushTimer.setSingleShot(true);
+    mFlushTimer.setInterval(FLUSH_INTERVAL);
+    connect(&mFlushTimer, &QTimer::timeout, this, &ThumbnailLoader::flush);
+
+    connect(&mWatcher, &QFutureWatcher<QImage>::resultsReadyAt, this, [=](int begin, int end){
+        for (int i = begin; i < end; i++) {
+            mImages[i] = mWatcher.resultAt(i);
+            mReady[i] = true;
+        }
+        // 首张立即显示，其余合并成批
+        if (mNext == 0 && mReady.at(0)) {
+            flush();
+        } else if (!mFlushTimer.isActive()) {
+            mFlushTimer.start();
+        }
+    });
+    connect(&mWatcher, &QFutureWatcher<QImage>::finished, this, [=]{
+        mFlushTimer.stop();
+        if (!mWatcher.isCanceled()) {
+            flush();
+            emit finished();
+        }
+    });
+}
+
+ThumbnailLoader::~ThumbnailLoader()
+{
+    // 解码任务运行在插件代码中，卸载前必须等待其结束
+    cancel();
+}
+
+void ThumbnailLoader::load(const QStringList &files){
+    cancel();
+
+    mFiles = files;
+    mImages = QVector<QImage>(files.size());
+    mReady = QVector<bool>(files.size(), false);
+    mNext = 0;
+
+    if (files.isEmpty()) {
+        emit finished();
+        return;
+    }
+
+    mWatcher.setFuture(QtConcurrent::mapped(mFiles, ScaleFunctor(mSize)));
+}
+
+void ThumbnailLoader::cancel(){
+    mFlushTimer.stop();
+    if (mWatcher.isRunning()) {
+        mWatcher.cancel();
+        mWatcher.waitForFinished();
+    }
+}
+
+QImage ThumbnailLoader::scaledImage(const QString &filename, const QSize &size){
+    QImage thumb = cachedThumbnail(filename, size);
+    if (!thumb.isNull()) {
+        return thumb.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    QImageReader reader(filename);
+    // 支持按尺寸解码的格式(如JPEG)可直接在解码阶段降采样
+    reader.setScaledSize(size);
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning("ThumbnailLoader: %s: %s", qPrintable(filename), qPrintable(reader.errorString()));
+    }
+    return image;
+}
+
+QImage ThumbnailLoader::cachedThumbnail(const QString &filename, const QSize &size){
+    QFileInfo info(filename);
+    if (!info.isFile()) {
+        return QImage();
+    }
+
+    // 选取不小于显示尺寸的最小档位，避免放大模糊
+    bool normal = qMax(size.width(), size.height()) <= THUMB_NORMAL_SIZE;
+    int edge = normal ? THUMB_NORMAL_SIZE : THUMB_LARGE_SIZE;
+
+    QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+            + "/thumbnails/" + (normal ? "normal" : "large");
+
+    // 缓存目录中的图片本身不再生成缩略图
+    if (info.absolutePath().startsWith(cacheDir)) {
+        return QImage();
+    }
+
+    QString uri = QString::fromUtf8(QUrl::fromLocalFile(info.absoluteFilePath()).toEncoded());
+    QString md5 = QString::fromLatin1(QCryptographicHash::hash(uri.toUtf8(), QCryptographicHash::Md5).toHex());
+    QString path = cacheDir + "/" + md5 + ".png";
+    QString mtime = QString::number(info.lastModified().toSecsSinceEpoch());
+
+    QImage thumb;
+    if (thumb.load(path, "png")
+            && thumb.text("Thumb::URI") == uri
+            && thumb.text("Thumb::MTime") == mtime) {
+        return thumb;
+    }
+
+    // 缺失或已过期，重新生成
+    QImageReader reader(filename);
+    QSize srcSize = reader.size();
+    if (srcSize.isValid() && (srcSize.width() > edge || srcSize.height() > edge)) {
+        reader.setScaledSize(srcSize.scaled(edge, edge, Qt::KeepAspectRatio));
+    }
+    thumb = reader.read();
+    if (thumb.isNull()) {
+        return QImage();
+    }
+
+    if (QDir().mkpath(cacheDir)) {
+        QFile::setPermissions(cacheDir, QFileDevice::ReadOwner | QFileDevice::WriteOwner | QFileDevice::ExeOwner);
+        saveThumbnail(thumb, path, uri, info);
+    }
+
+    return thumb;
+}
+
+void ThumbnailLoader::saveThumbnail(const QImage &thumb, const QString &path,
+                                    const QString &uri, const QFileInfo &info){
+    // 先写临时文件再原子替换，避免其他程序读到不完整的缩略图
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QImageWriter writer(&file, "png");
+    writer.setText("Thumb::URI", uri);
+    writer.setText("Thumb::MTime", QString::number(info.lastModified().toSecsSinceEpoch()));
+    writer.setText("Thumb::Size", QString::number(info.size()));
+    writer.setText("Software", "ukui-control-center");
+
+    if (!writer.write(thumb)) {
+        qWarning("ThumbnailLoader: failed to write %s: %s", qPrintable(path), qPrintable(writer.errorString()));
+        file.cancelWriting();
+        return;
+    }
+
+    file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+    file.commit();
+}
+
+void ThumbnailLoader::flush(){
+    QStringList files;
+    QList<QPixmap> pixmaps;
+
+    // 仅发出从当前位置起连续就绪的部分，保证显示顺序
+    while (mNext < mFiles.size() && mReady.at(mNext)) {
+        files.append(mFiles.at(mNext));
+        pixmaps.append(QPixmap::fromImage(mImages.at(mNext)));
+        mImages[mNext] = QImage();
+        mNext++;
+    }
+
+    if (!files.isEmpty()) {
+        emit thumbnailsReady(files, pixmaps);
+    }
+}
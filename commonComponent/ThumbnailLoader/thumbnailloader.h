@@ -0,0 +1,79 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef THUMBNAILLOADER_H
+#define THUMBNAILLOADER_H
+
+#include <QObject>
+#include <QSize>
+#include <QImage>
+#include <QPixmap>
+#include <QStringList>
+#include <QVector>
+#include <QTimer>
+#include <QFutureWatcher>
+
+class QFileInfo;
+
+/**
+ * \brief ThumbnailLoader
+ * 壁纸缩略图加载：在全局线程池中并行解码，解码时即按目标尺寸缩放，
+ * 结果以QImage返回，在GUI线程转换为QPixmap后按原顺序分批发出。
+ * 解码结果按freedesktop缩略图规范缓存在~/.cache/thumbnails下，
+ * 以文件URI的MD5命名，并以原图修改时间校验是否过期。
+ */
+class ThumbnailLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ThumbnailLoader(const QSize &size, QObject *parent = 0);
+    ~ThumbnailLoader();
+
+public:
+    void load(const QStringList &files);
+    void cancel();
+
+    static QImage scaledImage(const QString &filename, const QSize &size);
+
+private:
+    static QImage cachedThumbnail(const QString &filename, const QSize &size);
+    static void saveThumbnail(const QImage &thumb, const QString &path,
+                              const QString &uri, const QFileInfo &info);
+
+    void flush();
+
+private:
+    QSize mSize;
+
+    QStringList mFiles;
+    QVector<QImage> mImages;
+    QVector<bool> mReady;
+    int mNext;
+
+    QFutureWatcher<QImage> mWatcher;
+    QTimer mFlushTimer;
+
+Q_SIGNALS:
+    // 一批连续就绪的缩略图，顺序与load()传入的文件顺序一致
+    void thumbnailsReady(const QStringList &files, const QList<QPixmap> &pixmaps);
+    void finished();
+};
+
+#endif // THUMBNAILLOADER_H
@@ -0,0 +1,23 @@
+#-------------------------------------------------
+#
+# 壁纸目录私有库，背景与锁屏插件链接同一份实例
+#
+#-------------------------------------------------
+include(../../env.pri)
+
+QT       -= gui
+QT       += xml concurrent
+
+TEMPLATE = lib
+CONFIG += c++11
+
+TARGET = $$qtLibraryTarget(wallpapercatalog)
+DESTDIR = $$PROJECT_COMPONENTLIBS
+target.path = $${COMPONENTLIB_INSTALL_DIRS}
+INSTALLS += target
+
+SOURCES += \
+        wallpapercatalog.cpp \
+
+HEADERS += \
+        wallpapercatalog.h \
@@ -0,0 +1,417 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "wallpapercatalog.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QFileSystemWatcher>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <QtConcurrent>
+
+#include <QDebug>
+
+#define WALLPAPERDIR "/usr/share/ukui-background-properties/"
+
+// 合并连续修改的写回延时
+#define SAVE_DELAY 500
+
+WallpaperCatalog * WallpaperCatalog::instance(){
+    static WallpaperCatalog * catalog = nullptr;
+    if (!catalog) {
+        catalog = new WallpaperCatalog(qApp);
+    }
+    return catalog;
+}
+
+WallpaperCatalog::WallpaperCatalog(QObject *parent) :
+    QObject(parent),
+    mLoaded(false),
+    mDirty(false),
+    mSaving(false)
+{
+    mWatcher = new QFileSystemWatcher(this);
+    connect(mWatcher, &QFileSystemWatcher::fileChanged, this, &WallpaperCatalog::fileChanged);
+    connect(mWatcher, &QFileSystemWatcher::directoryChanged, this, &WallpaperCatalog::fileChanged);
+
+    mSaveTimer.setSingleShot(true);
+    mSaveTimer.setInterval(SAVE_DELAY);
+    connect(&mSaveTimer, &QTimer::timeout, this, &WallpaperCatalog::save);
+
+    connect(&mLoadWatcher, &QFutureWatcher<WallpaperCatalogData>::finished, this, [=]{
+        bool firstLoad = !mLoaded;
+
+        mData = mLoadWatcher.result();
+        mLoaded = true;
+        mFileTime = QFileInfo(localFile()).lastModified();
+
+        // 本地文件不存在时由系统壁纸生成
+        if (mData.fromSystem) {
+            mData.fromSystem = false;
+            markDirty();
+        }
+        watchFile();
+
+        if (firstLoad) {
+            emit loaded();
+        } else {
+            emit changed();
+        }
+    });
+
+    connect(&mSaveWatcher, &QFutureWatcher<bool>::finished, this, [=]{
+        mSaving = false;
+        mFileTime = QFileInfo(localFile()).lastModified();
+        watchFile();
+
+        // 写回期间又有新的修改
+        if (mDirty) {
+            mSaveTimer.start();
+        }
+    });
+}
+
+WallpaperCatalog::~WallpaperCatalog()
+{
+    mSaveWatcher.waitForFinished();
+    if (mDirty) {
+        writeCatalog(localFile(), mData);
+    }
+}
+
+QString WallpaperCatalog::localFile(){
+    return QString("%1/%2/%3").arg(QDir::homePath()).arg(".config/ukui").arg("wallpaper.xml");
+}
+
+void WallpaperCatalog::load(){
+    if (mLoaded || mLoadWatcher.isRunning())
+        return;
+
+    mLoadWatcher.setFuture(QtConcurrent::run(&WallpaperCatalog::readCatalog, localFile()));
+}
+
+bool WallpaperCatalog::isLoaded() const{
+    return mLoaded;
+}
+
+QList<WallpaperInfo> WallpaperCatalog::wallpapers() const{
+    return mData.wallpapers.values();
+}
+
+bool WallpaperCatalog::contains(const QString &filename) const{
+    return mData.wallpapers.contains(filename);
+}
+
+WallpaperInfo WallpaperCatalog::wallpaper(const QString &filename) const{
+    return mData.wallpapers.value(filename);
+}
+
+void WallpaperCatalog::addWallpaper(const WallpaperInfo &info){
+    if (mData.wallpapers.contains(info.filename)) {
+        setDeleted(info.filename, false);
+        return;
+    }
+
+    mData.wallpapers.insert(info.filename, info);
+    markDirty();
+    emit wallpaperChanged(info.filename);
+}
+
+void WallpaperCatalog::setDeleted(const QString &filename, bool deleted){
+    if (!mData.wallpapers.contains(filename))
+        return;
+
+    WallpaperInfo &info = mData.wallpapers[filename];
+    if (info.deleted == deleted)
+        return;
+
+    info.deleted = deleted;
+    markDirty();
+    emit wallpaperChanged(filename);
+}
+
+void WallpaperCatalog::setOptions(const QString &filename, const QString &options){
+    if (!mData.wallpapers.contains(filename))
+        return;
+
+    WallpaperInfo &info = mData.wallpapers[filename];
+    if (info.options == options)
+        return;
+
+    info.options = options;
+    markDirty();
+}
+
+void WallpaperCatalog::markDirty(){
+    mDirty = true;
+    if (!mSaving) {
+        mSaveTimer.start();
+    }
+}
+
+void WallpaperCatalog::save(){
+    if (!mDirty || mSaving)
+        return;
+
+    mDirty = false;
+    mSaving = true;
+    mSaveWatcher.setFuture(QtConcurrent::run(&WallpaperCatalog::writeCatalog, localFile(), mData));
+}
+
+void WallpaperCatalog::watchFile(){
+    QString file = localFile();
+    QString dir = QFileInfo(file).absolutePath();
+
+    // 原子替换后原inode失效，需重新加入监视
+    if (QFile::exists(file) && !mWatcher->files().contains(file)) {
+        mWatcher->addPath(file);
+    }
+    if (QFile::exists(dir) && !mWatcher->directories().contains(dir)) {
+        mWatcher->addPath(dir);
+    }
+}
+
+void WallpaperCatalog::fileChanged(){
+    watchFile();
+
+    // 自身写入或本地修改尚未写回时不重新加载，本地修改优先
+    if (!mLoaded || mSaving || mDirty || mLoadWatcher.isRunning())
+        return;
+
+    QFileInfo info(localFile());
+    if (!info.exists() || info.lastModified() == mFileTime)
+        return;
+
+    mLoadWatcher.setFuture(QtConcurrent::run(&WallpaperCatalog::readCatalog, localFile()));
+}
+
+WallpaperCatalogData WallpaperCatalog::readCatalog(const QString &localconf){
+    WallpaperCatalogData data;
+
+    if (QFile::exists(localconf)) {
+        readFile(localconf, data);
+    } else {
+        QDir xmlDir(WALLPAPERDIR);
+        foreach (QString filename, xmlDir.entryList(QStringList() << "*.xml", QDir::Files)) {
+            readFile(xmlDir.absoluteFilePath(filename), data);
+        }
+        data.fromSystem = true;
+    }
+
+    if (data.version.isEmpty())
+        data.version = "1.0";
+    if (data.doctype.isEmpty())
+        data.doctype = "wallpapers";
+    if (data.system.isEmpty())
+        data.system = "gnome-wp-list.dtd";
+
+    return data;
+}
+
+void WallpaperCatalog::readFile(const QString &filename, WallpaperCatalogData &data){
+    QFile file(filename);
+    if (!file.open(QFile::ReadOnly | QFile::Text)){
+        qDebug() << "Error Open XML File When Reader Xml: " << file.errorString();
+        return;
+    }
+
+    QXmlStreamReader reader;
+    reader.setDevice(&file);
+
+    while (!reader.atEnd()) {
+        QXmlStreamReader::TokenType nType = reader.readNext();
+        switch (nType) {
+        case QXmlStreamReader::StartDocument: {
+            if (data.version.isEmpty())
+                data.version = reader.documentVersion().toString();
+            break;
+        }
+        case QXmlStreamReader::DTD: {
+            if (data.doctype.isEmpty()) {
+                data.doctype = reader.dtdName().toString();
+                data.system = reader.dtdSystemId().toString();
+            }
+            break;
+        }
+        case QXmlStreamReader::StartElement: {
+            if (reader.name() == "wallpapers"){ //根元素
+                parseWallpapers(reader, data);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    if (reader.hasError()){
+        qDebug() << QString::fromLocal8Bit("msg: %1; line: %2; column: %3; char shift: %4").arg(reader.errorString()).arg(reader.lineNumber()).arg(reader.columnNumber()).arg(reader.characterOffset());
+    }
+    file.close();
+}
+
+void WallpaperCatalog::parseWallpapers(QXmlStreamReader &reader, WallpaperCatalogData &data){
+    WallpaperInfo info;
+    bool inWallpaper = false;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartElement()){
+            QStringRef element = reader.name();
+            if (!inWallpaper){
+                if (element == "wallpaper"){
+                    inWallpaper = true;
+                    info = WallpaperInfo();
+                    for (const QXmlStreamAttribute &attr : reader.attributes()){
+                        if (attr.qualifiedName() == "deleted")
+                            info.deleted = attr.value() == "true";
+                        else
+                            info.extraAttributes.append(attr);
+                    }
+                } else {
+                    data.extraElements.append(readElementXml(reader));
+                }
+            } else if (element == "name" && !reader.attributes().hasAttribute("xml:lang")){
+                info.name = reader.readElementText();
+            } else if (element == "name" && reader.attributes().value("xml:lang") == "zh_CN"){
+                info.i18nName = reader.readElementText();
+            } else if (element == "name.zh_CN"){ //兼容旧版本写入的格式
+                info.i18nName = reader.readElementText();
+            } else if (element == "artist"){
+                info.artist = reader.readElementText();
+            } else if (element == "filename"){
+                info.filename = reader.readElementText();
+            } else if (element == "options"){
+                info.options = reader.readElementText();
+            } else if (element == "pcolor"){
+                info.pColor = reader.readElementText();
+            } else if (element == "scolor"){
+                info.sColor = reader.readElementText();
+            } else if (element == "shade_type"){
+                info.shadeType = reader.readElementText();
+            } else {
+                info.extraElements.append(readElementXml(reader));
+            }
+        }
+        else if (reader.isEndElement()){
+            QStringRef element = reader.name();
+            if (element == "wallpaper"){
+                inWallpaper = false;
+                //slide show not append and file must exist!
+                if (!info.filename.endsWith("xml") && QFile::exists(info.filename))
+                    data.wallpapers.insert(info.filename, info);
+            }
+            else if (element == "wallpapers"){
+                break;
+            }
+        }
+    }
+}
+
+QString WallpaperCatalog::readElementXml(QXmlStreamReader &reader){
+    // 从当前开始标签读到对应的结束标签，序列化为xml片段
+    QString xml;
+    QXmlStreamWriter writer(&xml);
+    int depth = 0;
+    while (!reader.atEnd() && !reader.hasError()) {
+        writer.writeCurrentToken(reader);
+        if (reader.isStartElement())
+            depth++;
+        else if (reader.isEndElement())
+            depth--;
+        if (depth == 0)
+            break;
+        reader.readNext();
+    }
+    return xml;
+}
+
+void WallpaperCatalog::writeElementXml(QXmlStreamWriter &writer, const QString &xml){
+    QXmlStreamReader reader(xml);
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartDocument() || reader.isEndDocument() || reader.isWhitespace())
+            continue;
+        if (reader.hasError())
+            break;
+        writer.writeCurrentToken(reader);
+    }
+}
+
+bool WallpaperCatalog::writeCatalog(const QString &localconf, const WallpaperCatalogData &data){
+    QDir().mkpath(QFileInfo(localconf).absolutePath());
+
+    // 写入临时文件后原子替换，避免读到不完整的文件
+    QSaveFile file(localconf);
+    if (!file.open(QFile::WriteOnly | QFile::Text)){
+        qDebug() << "Error Open XML File When Update Local Xml: " << file.errorString();
+        return false;
+    }
+
+    QXmlStreamWriter writer;
+    writer.setDevice(&file);
+    writer.setAutoFormatting(true); //自动格式化
+    writer.writeStartDocument(data.version, false);
+
+    //DTD
+    writer.writeDTD(QString::fromLocal8Bit("<!DOCTYPE %1 SYSTEM \"%2\">").arg(data.doctype).arg(data.system));
+
+    //BODY
+    writer.writeStartElement("wallpapers");
+    for (const WallpaperInfo &info : data.wallpapers){
+        writer.writeStartElement("wallpaper");
+        writer.writeAttribute("deleted", info.deleted ? "true" : "false");
+        writer.writeAttributes(info.extraAttributes);
+
+        writer.writeTextElement("artist", info.artist.isEmpty() ? QString("(none)") : info.artist);
+        writer.writeTextElement("name", info.name);
+        if (!info.i18nName.isEmpty()) {
+            writer.writeStartElement("name");
+            writer.writeAttribute("xml:lang", "zh_CN");
+            writer.writeCharacters(info.i18nName);
+            writer.writeEndElement();
+        }
+        writer.writeTextElement("filename", info.filename);
+        if (!info.options.isEmpty())
+            writer.writeTextElement("options", info.options);
+        if (!info.pColor.isEmpty())
+            writer.writeTextElement("pcolor", info.pColor);
+        if (!info.sColor.isEmpty())
+            writer.writeTextElement("scolor", info.sColor);
+        if (!info.shadeType.isEmpty())
+            writer.writeTextElement("shade_type", info.shadeType);
+        for (const QString &xml : info.extraElements)
+            writeElementXml(writer, xml);
+
+        writer.writeEndElement();
+    }
+    for (const QString &xml : data.extraElements)
+        writeElementXml(writer, xml);
+    writer.writeEndElement();
+    writer.writeEndDocument();
+
+    if (writer.hasError() || !file.commit()) {
+        qDebug() << "Error Write Local Xml: " << file.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,136 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef WALLPAPERCATALOG_H
+#define WALLPAPERCATALOG_H
+
+#include <QObject>
+#include <QString>
+#include <QMap>
+#include <QList>
+#include <QTimer>
+#include <QDateTime>
+#include <QFutureWatcher>
+#include <QStringList>
+#include <QXmlStreamAttributes>
+
+class QFileSystemWatcher;
+class QXmlStreamReader;
+class QXmlStreamWriter;
+
+struct WallpaperInfo
+{
+    QString filename;
+    QString name;
+    QString i18nName;
+    QString artist;
+    QString options;
+    QString pColor;
+    QString sColor;
+    QString shadeType;
+    bool deleted;
+
+    // 未识别的属性和子元素原样保留，写回时不丢失其他程序写入的内容
+    QXmlStreamAttributes extraAttributes;
+    QStringList extraElements;
+
+    WallpaperInfo() : deleted(false) {}
+};
+
+struct WallpaperCatalogData
+{
+    QString version;
+    QString doctype;
+    QString system;
+    // 以文件路径为键，保持与原wallpaper.xml一致的排序
+    QMap<QString, WallpaperInfo> wallpapers;
+    // wallpapers下非wallpaper的子元素
+    QStringList extraElements;
+
+    // true表示本地文件不存在，数据来自系统壁纸目录
+    bool fromSystem;
+
+    WallpaperCatalogData() : fromSystem(false) {}
+};
+
+/**
+ * \brief WallpaperCatalog
+ * 壁纸目录：~/.config/ukui/wallpaper.xml 的内存模型，背景与锁屏共用。
+ * 首次使用时在后台解析一次，之后通过QFileSystemWatcher感知外部修改；
+ * 修改仅标记为脏，合并后在后台以原子替换方式写回。
+ * 重新加载后发出changed()，单个壁纸增删发出wallpaperChanged()。
+ */
+class WallpaperCatalog : public QObject
+{
+    Q_OBJECT
+
+public:
+    static WallpaperCatalog * instance();
+
+public:
+    void load();
+    bool isLoaded() const;
+
+    QList<WallpaperInfo> wallpapers() const;
+    bool contains(const QString &filename) const;
+    WallpaperInfo wallpaper(const QString &filename) const;
+
+    void addWallpaper(const WallpaperInfo &info);
+    void setDeleted(const QString &filename, bool deleted);
+    void setOptions(const QString &filename, const QString &options);
+
+    static QString localFile();
+
+private:
+    explicit WallpaperCatalog(QObject *parent = 0);
+    ~WallpaperCatalog();
+
+    static WallpaperCatalogData readCatalog(const QString &localconf);
+    static void readFile(const QString &filename, WallpaperCatalogData &data);
+    static void parseWallpapers(QXmlStreamReader &reader, WallpaperCatalogData &data);
+    static bool writeCatalog(const QString &localconf, const WallpaperCatalogData &data);
+    static QString readElementXml(QXmlStreamReader &reader);
+    static void writeElementXml(QXmlStreamWriter &writer, const QString &xml);
+
+    void markDirty();
+    void save();
+    void watchFile();
+    void fileChanged();
+
+private:
+    WallpaperCatalogData mData;
+    bool mLoaded;
+    bool mDirty;
+    bool mSaving;
+
+    // 最近一次加载或写入时文件的修改时间，用于忽略自身写入触发的变化
+    QDateTime mFileTime;
+
+    QTimer mSaveTimer;
+    QFileSystemWatcher * mWatcher;
+    QFutureWatcher<WallpaperCatalogData> mLoadWatcher;
+    QFutureWatcher<bool> mSaveWatcher;
+
+Q_SIGNALS:
+    void loaded();
+    void changed();
+    void wallpaperChanged(const QString &filename);
+};
+
+#endif // WALLPAPERCATALOG_H
@@ -0,0 +1,7 @@
+#LIBINTERFACE_NAME = $$qtLibraryTarget(desktopentryindex)
+# desktop文件索引编译为私有共享库(cclibs)，各插件链接同一份实例，头文件不再参与插件的moc
+
+INCLUDEPATH += $$PROJECT_COMPONENTSOURCE
+
+LIBS += -L$$PROJECT_COMPONENTLIBS -ldesktopentryindex
+QMAKE_RPATHDIR += $$COMPONENTLIB_INSTALL_DIRS
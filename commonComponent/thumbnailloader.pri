@@ -0,0 +1,8 @@
+#LIBINTERFACE_NAME = $$qtLibraryTarget(thumbnailloader)
+QT += concurrent
+
+SOURCES += \
+        $$PWD/ThumbnailLoader/thumbnailloader.cpp \
+
+HEADERS += \
+        $$PWD/ThumbnailLoader/thumbnailloader.h \
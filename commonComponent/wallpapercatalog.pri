@@ -0,0 +1,7 @@
+#LIBINTERFACE_NAME = $$qtLibraryTarget(wallpapercatalog)
+# 壁纸目录编译为私有共享库(cclibs)，各插件链接同一份实例，头文件不再参与插件的moc
+
+INCLUDEPATH += $$PROJECT_COMPONENTSOURCE
+
+LIBS += -L$$PROJECT_COMPONENTLIBS -lwallpapercatalog
+QMAKE_RPATHDIR += $$COMPONENTLIB_INSTALL_DIRS
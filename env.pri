@@ -2,3 +2,4 @@ PROJECT_ROOTDIR = $$PWD
 PROJECT_COMPONENTLIBS = $$PWD/cclibs
 PROJECT_COMPONENTSOURCE = $$PWD/commonComponent
 PLUGIN_INSTALL_DIRS = $$[QT_INSTALL_LIBS]/ukui-control-center
+COMPONENTLIB_INSTALL_DIRS = $$[QT_INSTALL_LIBS]/ukui-control-center/cclibs
@@ -0,0 +1,197 @@
+/*
+* Copyright (C) 2020 Tianjin KYLIN Information Technology Co., Ltd.
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 3, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, see <http://www.gnu.org/licenses/&gt;.
+*
+*/
+
+#include "account_file_cache.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <stdio.h>
+
+account_file_cache::account_file_cache(const QString &fileName, file_type type, QObject *parent) :
+    QObject(parent),
+    mFileName(fileName),
+    mType(type),
+    mValid(false),
+    mSize(-1)
+{
+    mWatcher = new QFileSystemWatcher(this);
+    connect(mWatcher, &QFileSystemWatcher::fileChanged, this, [=](const QString &){
+        invalidate();
+    });
+    // shadow工具以重命名方式替换文件，需同时监视所在目录
+    connect(mWatcher, &QFileSystemWatcher::directoryChanged, this, [=](const QString &){
+        QFileInfo info(mFileName);
+        if (info.lastModified() != mModified || info.size() != mSize) {
+            invalidate();
+        }
+    });
+    watch();
+}
+
+const QList<custom_struct> &account_file_cache::entries()
+{
+    if (!mValid) {
+        load();
+    }
+    return mEntries;
+}
+
+QList<custom_struct> account_file_cache::range(int offset, int count, const QString &filter)
+{
+    QList<custom_struct> result;
+    if (offset < 0 || count == 0) {
+        return result;
+    }
+
+    const QList<custom_struct> &all = entries();
+    int skipped = 0;
+    for (const custom_struct &entry : all) {
+        if (!matches(entry, filter)) {
+            continue;
+        }
+        if (skipped < offset) {
+            skipped++;
+            continue;
+        }
+        result << entry;
+        // count小于0表示不限数量
+        if (count > 0 && result.size() >= count) {
+            break;
+        }
+    }
+    return result;
+}
+
+int account_file_cache::count(const QString &filter)
+{
+    const QList<custom_struct> &all = entries();
+    if (filter.isEmpty()) {
+        return all.size();
+    }
+
+    int num = 0;
+    for (const custom_struct &entry : all) {
+        if (matches(entry, filter)) {
+            num++;
+        }
+    }
+    return num;
+}
+
+void account_file_cache::load()
+{
+    mEntries.clear();
+    mValid = true;
+
+    QFile file(mFileName);
+    QFileInfo info(file);
+    mModified = info.lastModified();
+    mSize = info.size();
+    watch();
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        printf("open %s fail \n", qPrintable(mFileName));
+        return;
+    }
+
+    // 逐行流式解析，不限制条目数量
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine();
+        custom_struct entry;
+        if (parse_line(line, entry)) {
+            mEntries << entry;
+        }
+    }
+}
+
+void account_file_cache::invalidate()
+{
+    mValid = false;
+    mEntries.clear();
+    watch();
+}
+
+void account_file_cache::watch()
+{
+    if (QFile::exists(mFileName) && !mWatcher->files().contains(mFileName)) {
+        mWatcher->addPath(mFileName);
+    }
+    QString dir = QFileInfo(mFileName).absolutePath();
+    if (!mWatcher->directories().contains(dir)) {
+        mWatcher->addPath(dir);
+    }
+}
+
+bool account_file_cache::parse_line(const QByteArray &line, custom_struct &entry) const
+{
+    int end = line.size();
+    while (end > 0 && (line.at(end - 1) == '\n' || line.at(end - 1) == '\r')) {
+        end--;
+    }
+    if (end == 0 || line.at(0) == '#') {
+        return false;
+    }
+
+    // group: name:passwd:gid:members
+    // passwd: name:passwd:uid:gid:gecos:home:shell
+    // 只需前4个字段，记录各字段的起止位置，避免整行split
+    const int maxFields = 4;
+    int begins[maxFields];
+    int ends[maxFields];
+    int num = 0;
+    int start = 0;
+    for (int i = 0; i <= end && num < maxFields; i++) {
+        if (i == end || line.at(i) == ':') {
+            begins[num] = start;
+            ends[num] = i;
+            num++;
+            start = i + 1;
+        }
+    }
+
+    auto field = [&](int idx) -> QString {
+        if (idx >= num) {
+            return QString();
+        }
+        return QString::fromUtf8(line.constData() + begins[idx], ends[idx] - begins[idx]);
+    };
+
+    if (mType == GROUP_FILE) {
+        if (num < 3) {
+            return false;
+        }
+        entry.groupname  = field(0);
+        entry.passphrase = field(1);
+        entry.groupid    = field(2);
+        entry.usergroup  = field(3);
+    } else {
+        if (num < 4) {
+            return false;
+        }
+        entry.groupname  = field(0);
+        entry.passphrase = field(1);
+        entry.groupid    = field(3);
+    }
+    return true;
+}
+
+bool account_file_cache::matches(const custom_struct &entry, const QString &filter)
+{
+    return filter.isEmpty() || entry.groupname.contains(filter, Qt::CaseInsensitive);
+}
@@ -0,0 +1,68 @@
+/*
+* Copyright (C) 2020 Tianjin KYLIN Information Technology Co., Ltd.
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 3, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, see <http://www.gnu.org/licenses/&gt;.
+*
+*/
+
+#ifndef ACCOUNT_FILE_CACHE_H
+#define ACCOUNT_FILE_CACHE_H
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include <QDateTime>
+
+#include "custom_struct.h"
+
+class QFileSystemWatcher;
+
+// /etc/group、/etc/passwd 的解析快照，文件变化(inotify)后失效，下次访问时重新解析
+class account_file_cache : public QObject
+{
+    Q_OBJECT
+public:
+    enum file_type {
+        GROUP_FILE,
+        PASSWD_FILE
+    };
+
+    explicit account_file_cache(const QString &fileName, file_type type, QObject *parent = nullptr);
+
+    const QList<custom_struct> &entries();
+    QList<custom_struct> range(int offset, int count, const QString &filter);
+    int count(const QString &filter);
+    void invalidate();
+
+private:
+    void load();
+    void watch();
+    bool parse_line(const QByteArray &line, custom_struct &entry) const;
+    static bool matches(const custom_struct &entry, const QString &filter);
+
+private:
+    QString mFileName;
+    file_type mType;
+
+    bool mValid;
+    QList<custom_struct> mEntries;
+
+    // 目录变化时据此判断文件本身是否改变
+    QDateTime mModified;
+    qint64 mSize;
+
+    QFileSystemWatcher *mWatcher;
+};
+
+#endif // ACCOUNT_FILE_CACHE_H
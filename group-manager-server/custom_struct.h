@@ -47,4 +47,32 @@ struct custom_struct
 };
 
 Q_DECLARE_METATYPE(custom_struct)
+
+// applyGroupChanges 的单个操作，action 取值同单项接口名:
+// add/set(value为组id)、del、addUserToGroup/delUserFromGroup(value为用户名)
+struct group_change
+{
+    QString action;
+    QString groupname;
+    QString value;
+
+    friend QDBusArgument &operator<<(QDBusArgument &argument, const group_change&change)
+    {
+        argument.beginStructure();
+        argument << change.action << change.groupname << change.value;
+        argument.endStructure();
+        return argument;
+    }
+
+    friend const QDBusArgument &operator>>(const QDBusArgument &argument, group_change&change)
+    {
+        argument.beginStructure();
+        argument >> change.action >> change.groupname >> change.value;
+        argument.endStructure();
+        return argument;
+    }
+
+};
+
+Q_DECLARE_METATYPE(group_change)
 #endif
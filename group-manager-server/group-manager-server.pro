@@ -19,9 +19,13 @@ DBUS_ADAPTORS += org.ukui.groupmanager.xml
 DBUS_INTERFACES += org.ukui.groupmanager.xml
 
 HEADERS +=  \
+            account_file_cache.h \
             custom_struct.h \
+            group_file_editor.h \
             group_manager_server.h
 SOURCES += \
+            account_file_cache.cpp \
+            group_file_editor.cpp \
             group_manager_server.cpp \
             main.cpp
 
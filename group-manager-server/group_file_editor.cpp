@@ -0,0 +1,491 @@
+/*
+* Copyright (C) 2020 Tianjin KYLIN Information Technology Co., Ltd.
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 3, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, see <http://www.gnu.org/licenses/&gt;.
+*
+*/
+
+#include "group_file_editor.h"
+
+#include <QFile>
+#include <QProcess>
+#include <QRegExp>
+#include <QStandardPaths>
+#include <pwd.h>
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <shadow.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// group、gshadow 第4个字段均为成员列表，passwd 第4个字段为主组id
+#define MEMBER_FIELD  3
+#define GID_FIELD     2
+#define PRIMARY_FIELD 3
+
+group_file_editor::group_file_editor() :
+    mPwdLocked(false)
+{
+    mGroup.path   = "/etc/group";
+    mGshadow.path = "/etc/gshadow";
+    mPasswd.path  = "/etc/passwd";
+}
+
+group_file_editor::~group_file_editor()
+{
+    unlock();
+}
+
+bool group_file_editor::lock(QString &error)
+{
+    // lckpwdf 最多等待15秒，与 shadow-utils 工具互斥
+    if (lckpwdf() != 0) {
+        error = QString("cannot lock password files: %1").arg(strerror(errno));
+        return false;
+    }
+    mPwdLocked = true;
+
+    if (!lock_file(mGroup) || !lock_file(mPasswd)
+            || (QFile::exists(mGshadow.path) && !lock_file(mGshadow))) {
+        error = "account files are locked by another process";
+        unlock();
+        return false;
+    }
+    return true;
+}
+
+void group_file_editor::unlock()
+{
+    unlock_file(mGshadow);
+    unlock_file(mPasswd);
+    unlock_file(mGroup);
+    if (mPwdLocked) {
+        ulckpwdf();
+        mPwdLocked = false;
+    }
+}
+
+bool group_file_editor::load(QString &error)
+{
+    if (!read_file(mGroup, error) || !read_file(mPasswd, error)) {
+        return false;
+    }
+    if (QFile::exists(mGshadow.path) && !read_file(mGshadow, error)) {
+        return false;
+    }
+    return true;
+}
+
+bool group_file_editor::commit(QString &error)
+{
+    // gshadow 先于 group 写入，中途失败时 group 仍与旧的 gshadow 一致
+    bool groupChanged  = mGroup.dirty || mGshadow.dirty;
+    bool passwdChanged = mPasswd.dirty;
+    db_file *files[] = { &mGshadow, &mGroup, &mPasswd };
+    bool ok = true;
+    for (db_file *db : files) {
+        if (db->dirty && !write_file(*db, error)) {
+            ok = false;
+            break;
+        }
+    }
+    // 部分文件可能已写入，失败时同样需要刷新缓存
+    flush_name_caches(groupChanged, passwdChanged);
+    return ok;
+}
+
+// nscd/sssd 缓存了组信息，不刷新时 getgrnam、id 等在缓存过期前仍返回旧成员
+void group_file_editor::flush_name_caches(bool group, bool passwd)
+{
+    if (!group && !passwd) {
+        return;
+    }
+
+    QString nscd = QStandardPaths::findExecutable("nscd", { "/usr/sbin", "/sbin" });
+    if (!nscd.isEmpty()) {
+        if (group) {
+            QProcess::execute(nscd, { "-i", "group" });
+        }
+        if (passwd) {
+            QProcess::execute(nscd, { "-i", "passwd" });
+        }
+    }
+
+    QString sssCache = QStandardPaths::findExecutable("sss_cache", { "/usr/sbin", "/sbin" });
+    if (!sssCache.isEmpty()) {
+        if (group) {
+            QProcess::execute(sssCache, { "-G" });
+        }
+        if (passwd) {
+            QProcess::execute(sssCache, { "-U" });
+        }
+    }
+}
+
+QString group_file_editor::add_group(const QString &groupName, const QString &groupId)
+{
+    if (!valid_name(groupName)) {
+        return QString("invalid group name '%1'").arg(groupName);
+    }
+    if (!valid_id(groupId)) {
+        return QString("invalid group id '%1'").arg(groupId);
+    }
+    QByteArray name = groupName.toUtf8();
+    QByteArray gid = groupId.toUtf8();
+    if (find(mGroup, name) >= 0) {
+        return QString("group '%1' already exists").arg(groupName);
+    }
+    if (id_in_use(gid)) {
+        return QString("group id '%1' already exists").arg(groupId);
+    }
+
+    mGroup.lines << (QList<QByteArray>() << name << (mGshadow.exists ? "x" : "!") << gid << QByteArray());
+    mGroup.dirty = true;
+    if (mGshadow.exists && find(mGshadow, name) < 0) {
+        mGshadow.lines << (QList<QByteArray>() << name << "!" << QByteArray() << QByteArray());
+        mGshadow.dirty = true;
+    }
+    return QString();
+}
+
+QString group_file_editor::set_group_id(const QString &groupName, const QString &groupId)
+{
+    int idx = find(mGroup, groupName.toUtf8());
+    if (idx < 0) {
+        return QString("group '%1' does not exist").arg(groupName);
+    }
+    if (!valid_id(groupId)) {
+        return QString("invalid group id '%1'").arg(groupId);
+    }
+
+    QByteArray gid = groupId.toUtf8();
+    QByteArray oldGid = mGroup.lines.at(idx).value(GID_FIELD);
+    if (gid == oldGid) {
+        return QString();
+    }
+    if (id_in_use(gid)) {
+        return QString("group id '%1' already exists").arg(groupId);
+    }
+
+    mGroup.lines[idx][GID_FIELD] = gid;
+    mGroup.dirty = true;
+
+    // 与 groupmod -g 一致，同时更新以该组为主组的用户
+    for (QList<QByteArray> &fields : mPasswd.lines) {
+        if (fields.size() > PRIMARY_FIELD && fields.at(PRIMARY_FIELD) == oldGid) {
+            fields[PRIMARY_FIELD] = gid;
+            mPasswd.dirty = true;
+        }
+    }
+    return QString();
+}
+
+QString group_file_editor::del_group(const QString &groupName)
+{
+    QByteArray name = groupName.toUtf8();
+    int idx = find(mGroup, name);
+    if (idx < 0) {
+        return QString("group '%1' does not exist").arg(groupName);
+    }
+
+    QByteArray gid = mGroup.lines.at(idx).value(GID_FIELD);
+    for (const QList<QByteArray> &fields : mPasswd.lines) {
+        if (fields.size() > PRIMARY_FIELD && fields.at(PRIMARY_FIELD) == gid) {
+            return QString("cannot remove the primary group of user '%1'")
+                    .arg(QString::fromUtf8(fields.at(0)));
+        }
+    }
+
+    mGroup.lines.removeAt(idx);
+    mGroup.dirty = true;
+    int sidx = find(mGshadow, name);
+    if (sidx >= 0) {
+        mGshadow.lines.removeAt(sidx);
+        mGshadow.dirty = true;
+    }
+    return QString();
+}
+
+// 成员增删按目标状态处理，已是(或已不是)成员时直接视为成功
+QString group_file_editor::add_member(const QString &groupName, const QString &userName)
+{
+    QByteArray name = groupName.toUtf8();
+    QByteArray user = userName.toUtf8();
+    int idx = find(mGroup, name);
+    if (idx < 0) {
+        return QString("group '%1' does not exist").arg(groupName);
+    }
+    if (!user_exists(user)) {
+        return QString("user '%1' does not exist").arg(userName);
+    }
+
+    if (add_to_list(mGroup.lines[idx], MEMBER_FIELD, user)) {
+        mGroup.dirty = true;
+    }
+    int sidx = find(mGshadow, name);
+    if (sidx >= 0 && add_to_list(mGshadow.lines[sidx], MEMBER_FIELD, user)) {
+        mGshadow.dirty = true;
+    }
+    return QString();
+}
+
+QString group_file_editor::del_member(const QString &groupName, const QString &userName)
+{
+    QByteArray name = groupName.toUtf8();
+    QByteArray user = userName.toUtf8();
+    int idx = find(mGroup, name);
+    if (idx < 0) {
+        return QString("group '%1' does not exist").arg(groupName);
+    }
+
+    if (remove_from_list(mGroup.lines[idx], MEMBER_FIELD, user)) {
+        mGroup.dirty = true;
+    }
+    int sidx = find(mGshadow, name);
+    if (sidx >= 0 && remove_from_list(mGshadow.lines[sidx], MEMBER_FIELD, user)) {
+        mGshadow.dirty = true;
+    }
+    return QString();
+}
+
+bool group_file_editor::read_file(db_file &db, QString &error)
+{
+    QFile file(db.path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = QString("open %1 fail: %2").arg(db.path, file.errorString());
+        return false;
+    }
+
+    db.lines.clear();
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine();
+        if (line.endsWith('\n')) {
+            line.chop(1);
+        }
+        // split/join 可原样还原不认识的行
+        db.lines << line.split(':');
+    }
+    db.exists = true;
+    db.dirty = false;
+    return true;
+}
+
+bool group_file_editor::write_file(db_file &db, QString &error)
+{
+    QByteArray path = QFile::encodeName(db.path);
+    QByteArray tmpPath = path + "+";
+    QByteArray backupPath = path + "-";
+
+    struct stat st;
+    if (stat(path.constData(), &st) != 0) {
+        error = QString("stat %1 fail: %2").arg(db.path, strerror(errno));
+        return false;
+    }
+
+    QByteArray content;
+    for (const QList<QByteArray> &fields : db.lines) {
+        content += join(fields, ':');
+        content += '\n';
+    }
+
+    int fd = open(tmpPath.constData(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        error = QString("create %1+ fail: %2").arg(db.path, strerror(errno));
+        return false;
+    }
+
+    // 保留原文件的属主和权限(gshadow 为 root:shadow 0640)
+    bool ok = fchown(fd, st.st_uid, st.st_gid) == 0
+            && fchmod(fd, st.st_mode & 07777) == 0;
+    const char *data = content.constData();
+    qint64 left = content.size();
+    while (ok && left > 0) {
+        ssize_t n = ::write(fd, data, left);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        ok = n > 0;
+        data += n;
+        left -= n;
+    }
+    ok = ok && fsync(fd) == 0;
+    ok = (close(fd) == 0) && ok;
+    if (!ok) {
+        error = QString("write %1+ fail: %2").arg(db.path, strerror(errno));
+        unlink(tmpPath.constData());
+        return false;
+    }
+
+    // 旧文件硬链接为 <file>- 备份，再原子替换
+    unlink(backupPath.constData());
+    if (link(path.constData(), backupPath.constData()) != 0) {
+        printf("backup %s fail: %s \n", path.constData(), strerror(errno));
+    }
+    if (rename(tmpPath.constData(), path.constData()) != 0) {
+        error = QString("replace %1 fail: %2").arg(db.path, strerror(errno));
+        unlink(tmpPath.constData());
+        return false;
+    }
+
+    db.dirty = false;
+    return true;
+}
+
+// 与 shadow-utils 的 commonio_lock_nowait 相同：写入pid的临时文件硬链接为 <file>.lock
+bool group_file_editor::lock_file(db_file &db)
+{
+    if (db.locked) {
+        return true;
+    }
+
+    QByteArray path = QFile::encodeName(db.path);
+    QByteArray lockPath = path + ".lock";
+    QByteArray tmpPath = path + "." + QByteArray::number(getpid());
+
+    int fd = open(tmpPath.constData(), O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    QByteArray pid = QByteArray::number(getpid());
+    bool written = ::write(fd, pid.constData(), pid.size()) == pid.size();
+    close(fd);
+
+    for (int retry = 0; written && retry < 2 && !db.locked; retry++) {
+        if (link(tmpPath.constData(), lockPath.constData()) == 0) {
+            db.locked = true;
+            break;
+        }
+        if (errno != EEXIST) {
+            break;
+        }
+
+        // 持锁进程已退出则清理残留的锁文件后重试
+        QFile lockFile(QFile::decodeName(lockPath));
+        if (!lockFile.open(QIODevice::ReadOnly)) {
+            break;
+        }
+        pid_t owner = lockFile.readAll().trimmed().toInt();
+        lockFile.close();
+        if (owner <= 0 || (kill(owner, 0) != 0 && errno == ESRCH)) {
+            unlink(lockPath.constData());
+        } else {
+            break;
+        }
+    }
+
+    unlink(tmpPath.constData());
+    return db.locked;
+}
+
+void group_file_editor::unlock_file(db_file &db)
+{
+    if (db.locked) {
+        QByteArray lockPath = QFile::encodeName(db.path) + ".lock";
+        unlink(lockPath.constData());
+        db.locked = false;
+    }
+}
+
+int group_file_editor::find(const db_file &db, const QByteArray &name)
+{
+    for (int i = 0; i < db.lines.size(); i++) {
+        if (db.lines.at(i).first() == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool group_file_editor::valid_name(const QString &name)
+{
+    // 与 shadow-utils 默认规则一致，另允许大写字母
+    static const QRegExp rx("[a-zA-Z_][a-zA-Z0-9_.-]*\\$?");
+    return name.size() <= 32 && rx.exactMatch(name);
+}
+
+bool group_file_editor::valid_id(const QString &id)
+{
+    bool ok = false;
+    uint gid = id.toUInt(&ok);
+    return ok && gid != uint(-1);
+}
+
+bool group_file_editor::id_in_use(const QByteArray &id) const
+{
+    for (const QList<QByteArray> &fields : mGroup.lines) {
+        if (fields.size() > GID_FIELD && fields.at(GID_FIELD) == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 通过 NSS 查询，LDAP、SSSD 等来源的用户不在 /etc/passwd 中
+bool group_file_editor::user_exists(const QByteArray &userName)
+{
+    long size = sysconf(_SC_GETPW_R_SIZE_MAX);
+    QByteArray buf(size > 0 ? size : 1024, '\0');
+    struct passwd pwd;
+    struct passwd *result = nullptr;
+
+    int ret;
+    while ((ret = getpwnam_r(userName.constData(), &pwd, buf.data(), buf.size(), &result)) == ERANGE) {
+        buf.resize(buf.size() * 2);
+    }
+    return ret == 0 && result != nullptr;
+}
+
+QByteArray group_file_editor::join(const QList<QByteArray> &list, char sep)
+{
+    QByteArray joined;
+    for (int i = 0; i < list.size(); i++) {
+        if (i > 0) {
+            joined += sep;
+        }
+        joined += list.at(i);
+    }
+    return joined;
+}
+
+bool group_file_editor::add_to_list(QList<QByteArray> &fields, int idx, const QByteArray &name)
+{
+    while (fields.size() <= idx) {
+        fields << QByteArray();
+    }
+    QList<QByteArray> members = fields.at(idx).split(',');
+    members.removeAll(QByteArray());
+    if (members.contains(name)) {
+        return false;
+    }
+    members << name;
+    fields[idx] = join(members, ',');
+    return true;
+}
+
+bool group_file_editor::remove_from_list(QList<QByteArray> &fields, int idx, const QByteArray &name)
+{
+    if (fields.size() <= idx) {
+        return false;
+    }
+    QList<QByteArray> members = fields.at(idx).split(',');
+    if (members.removeAll(name) == 0) {
+        return false;
+    }
+    members.removeAll(QByteArray());
+    fields[idx] = join(members, ',');
+    return true;
+}
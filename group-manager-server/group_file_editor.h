@@ -0,0 +1,79 @@
+/*
+* Copyright (C) 2020 Tianjin KYLIN Information Technology Co., Ltd.
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 3, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, see <http://www.gnu.org/licenses/&gt;.
+*
+*/
+
+#ifndef GROUP_FILE_EDITOR_H
+#define GROUP_FILE_EDITOR_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+// 直接编辑 /etc/group、/etc/gshadow、/etc/passwd，取代逐个调用 groupadd/gpasswd 等命令
+// 加锁方式与 shadow-utils 一致(lckpwdf + <file>.lock)，所有修改在内存中完成后原子替换文件
+class group_file_editor
+{
+public:
+    group_file_editor();
+    ~group_file_editor();
+
+    bool lock(QString &error);
+    void unlock();
+
+    bool load(QString &error);
+    bool commit(QString &error);
+
+    QString add_group(const QString &groupName, const QString &groupId);
+    QString set_group_id(const QString &groupName, const QString &groupId);
+    QString del_group(const QString &groupName);
+    QString add_member(const QString &groupName, const QString &userName);
+    QString del_member(const QString &groupName, const QString &userName);
+
+private:
+    struct db_file {
+        QString path;
+        QList<QList<QByteArray>> lines;
+        bool exists = false;
+        bool dirty = false;
+        bool locked = false;
+    };
+
+    static bool read_file(db_file &db, QString &error);
+    static bool write_file(db_file &db, QString &error);
+    static bool lock_file(db_file &db);
+    static void unlock_file(db_file &db);
+
+    static int find(const db_file &db, const QByteArray &name);
+    static bool valid_name(const QString &name);
+    static bool valid_id(const QString &id);
+    bool id_in_use(const QByteArray &id) const;
+    static bool user_exists(const QByteArray &userName);
+    static void flush_name_caches(bool group, bool passwd);
+
+    static QByteArray join(const QList<QByteArray> &list, char sep);
+    static bool add_to_list(QList<QByteArray> &fields, int idx, const QByteArray &name);
+    static bool remove_from_list(QList<QByteArray> &fields, int idx, const QByteArray &name);
+
+private:
+    db_file mGroup;
+    db_file mGshadow;
+    db_file mPasswd;
+    bool mPwdLocked;
+};
+
+#endif // GROUP_FILE_EDITOR_H
@@ -18,217 +18,161 @@
 
 #include "group_manager_server.h"
 #include "custom_struct.h"
+#include "account_file_cache.h"
+#include "group_file_editor.h"
 #include <stdio.h>
 
 group_manager_server::group_manager_server()
 {
-	
+    groupCache  = new account_file_cache("/etc/group", account_file_cache::GROUP_FILE, this);
+    passwdCache = new account_file_cache("/etc/passwd", account_file_cache::PASSWD_FILE, this);
 }
 
-// 解析组文件
-QVariantList group_manager_server::getGroup()
+static QVariantList toVariantList(const QList<custom_struct> &entries)
 {
-    const QString fileName = "/etc/group";
-    QFile groupFile(fileName);
-
     QVariantList value;
-    QVariant cnt;
-    int lineCount = 1;
-
-    if(!groupFile.exists()){
-        printf("/etc/group file not exist \n");
-    }
-    if(!groupFile.open(QIODevice::ReadOnly | QIODevice::Text)){
-        printf("open /etc/group fail \n");
-    }
-
-    QTextStream in(&groupFile);
-    QString line = in.readLine();
-    struct custom_struct demo[200];
-
-    while(!line.isNull()){
-        QStringList lineList = line.split(":");
-        line = in.readLine();
-        demo[lineCount].groupname   = lineList.at(0);
-        demo[lineCount].passphrase  = lineList.at(1);
-        demo[lineCount].groupid     = lineList.at(2);
-        demo[lineCount].usergroup   = lineList.at(3);
-        cnt = QVariant::fromValue(demo[lineCount]);
-        value << cnt;
-        lineCount ++;
+    value.reserve(entries.size());
+    for (const custom_struct &entry : entries) {
+        value << QVariant::fromValue(entry);
     }
     return value;
 }
 
+// 解析组文件
+QVariantList group_manager_server::getGroup()
+{
+    return toVariantList(groupCache->entries());
+}
+
 // 解析passwd文件
 QVariantList group_manager_server::getPasswd()
 {
-    const QString fileName = "/etc/passwd";
-    QFile passwdFile(fileName);
+    return toVariantList(passwdCache->entries());
+}
 
-    QVariantList value;
-    QVariant cnt;
-    int lineCount = 1;
+// 分页获取组，filter按组名匹配(不区分大小写)，count小于0表示取到末尾
+QVariantList group_manager_server::getGroupRange(int offset, int count, QString filter)
+{
+    return toVariantList(groupCache->range(offset, count, filter));
+}
+
+int group_manager_server::getGroupCount(QString filter)
+{
+    return groupCache->count(filter);
+}
+
+// 分页获取用户
+QVariantList group_manager_server::getPasswdRange(int offset, int count, QString filter)
+{
+    return toVariantList(passwdCache->range(offset, count, filter));
+}
+
+int group_manager_server::getPasswdCount(QString filter)
+{
+    return passwdCache->count(filter);
+}
 
-    if(!passwdFile.exists()){
-        printf("/etc/passwd file not exist \n");
+// 批量修改组，所有操作在同一把锁下于内存中依次校验、执行，最后一次性原子写回
+// 返回与 changes 一一对应的结果，空字符串表示成功，否则为失败原因
+QStringList group_manager_server::applyGroupChanges(QVariantList changes)
+{
+    QStringList results;
+    QString error;
+    group_file_editor editor;
+
+    if (!editor.lock(error) || !editor.load(error)) {
+        printf("%s \n", qPrintable(error));
+        for (int i = 0; i < changes.size(); i++) {
+            results << error;
+        }
+        return results;
     }
-    if(!passwdFile.open(QIODevice::ReadOnly | QIODevice::Text)){
-        printf("open /etc/passwd fail \n");
+
+    bool modified = false;
+    for (const QVariant &var : changes) {
+        group_change change;
+        if (var.canConvert<QDBusArgument>()) {
+            var.value<QDBusArgument>() >> change;
+        } else {
+            change = var.value<group_change>();
+        }
+
+        QString result;
+        if (change.action == "add") {
+            result = editor.add_group(change.groupname, change.value);
+        } else if (change.action == "set") {
+            result = editor.set_group_id(change.groupname, change.value);
+        } else if (change.action == "del") {
+            result = editor.del_group(change.groupname);
+        } else if (change.action == "addUserToGroup") {
+            result = editor.add_member(change.groupname, change.value);
+        } else if (change.action == "delUserFromGroup") {
+            result = editor.del_member(change.groupname, change.value);
+        } else {
+            result = QString("unknown action '%1'").arg(change.action);
+        }
+
+        if (result.isEmpty()) {
+            modified = true;
+        } else {
+            printf("%s %s: %s \n", qPrintable(change.action), qPrintable(change.groupname), qPrintable(result));
+        }
+        results << result;
     }
 
-    QTextStream in(&passwdFile);
-    QString line = in.readLine();
-    struct custom_struct demo[200];
-
-    while(!line.isNull()){
-        QStringList lineList = line.split(":");
-        line = in.readLine();
-        demo[lineCount].groupname   = lineList.at(0);
-        demo[lineCount].passphrase  = lineList.at(1);
-        demo[lineCount].groupid     = lineList.at(3);
-        cnt = QVariant::fromValue(demo[lineCount]);
-        value << cnt;
-        lineCount ++;
+    if (modified) {
+        if (!editor.commit(error)) {
+            printf("%s \n", qPrintable(error));
+            for (QString &result : results) {
+                if (result.isEmpty()) {
+                    result = error;
+                }
+            }
+        }
+        // 不等待inotify通知，保证随后的查询读到新内容
+        groupCache->invalidate();
+        passwdCache->invalidate();
     }
-    return value;
+    return results;
 }
 
-// 添加组
-bool group_manager_server::add(QString groupName, QString groupId)
+bool group_manager_server::applyOne(const QString &action, const QString &groupName, const QString &value)
 {
-    QString groupadd = "/usr/sbin/groupadd";
-    QString addgroup = "/usr/sbin/addgroup";
-    QString command;
-    QFile groupaddFile("/usr/sbin/addgroup");
-    QFile addgroupFile("/usr/sbin/groupadd");
-
-    QProcess p(0);
-    QStringList args;
-
-    if(!addgroupFile.exists()){
-        printf("/usr/sbin/addgroup file not exist \n");
-        if(!groupaddFile.exists()){
-            return false;
-        }
-        command = groupadd;
-        args.append("-g");
-        args.append(groupId);
-        args.append(groupName);
-    }else{
-        command = addgroup;
-        args.append("-gid");
-        args.append(groupId);
-        args.append(groupName);
-    }
+    group_change change;
+    change.action = action;
+    change.groupname = groupName;
+    change.value = value;
 
+    QStringList results = applyGroupChanges(QVariantList() << QVariant::fromValue(change));
+    return results.size() == 1 && results.first().isEmpty();
+}
 
-    p.execute(command,args);//command是要执行的命令,args是参数
-    p.waitForFinished(-1);
-//    qDebug()<<QString::fromLocal8Bit(p.readAllStandardError());
-    return true;
+// 添加组
+bool group_manager_server::add(QString groupName, QString groupId)
+{
+    return applyOne("add", groupName, groupId);
 }
 
 // 修改组
 bool group_manager_server::set(QString groupName, QString groupId)
 {
-    QString groupmod = "/usr/sbin/groupmod";
-    QFile groupmodFile(groupmod);
-    QProcess p(0);
-    QStringList args;
-
-    if(!groupmodFile.exists()){
-        printf("/usr/sbin/groupmod file not exist \n");
-        return false;
-    }
-    args.append("-g");
-    args.append(groupId);
-    //args.append("-n");
-    args.append(groupName);
-
-    p.execute(groupmod,args);//command是要执行的命令,args是参数
-    p.waitForFinished(-1);
-//    qDebug()<<QString::fromLocal8Bit(p.readAllStandardError());
-    return true;
+    return applyOne("set", groupName, groupId);
 }
 
 // 删除组
 bool group_manager_server::del(QString groupName)
 {
-    QString groupdel = "/usr/sbin/groupdel";
-    QFile groupdelFile(groupdel);
-    QProcess p(0);
-    QStringList args;
-
-    if(!groupdelFile.exists()){
-        printf("/usr/sbin/groupdel file not exist \n");
-        return false;
-    }
-    args.append(groupName);
-
-    p.execute(groupdel,args);//command是要执行的命令,args是参数
-    p.waitForFinished(-1);
-//    qDebug()<<QString::fromLocal8Bit(p.readAllStandardError());
-    return true;
+    return applyOne("del", groupName, QString());
 }
 
 // 添加用户到组
 bool group_manager_server::addUserToGroup(QString groupName, QString userName)
 {
-    QString usermod = "/usr/sbin/usermod";
-    QString gpasswd = "/usr/bin/gpasswd";
-    QString command;
-
-    QFile usermodFile(usermod);
-    QFile gpasswdFile(gpasswd);
-
-    QProcess p(0);
-    QStringList args;
-
-    if(!usermodFile.exists()){
-        printf("/usr/sbin/usermod file not exist \n");
-        if(!gpasswdFile.exists()){
-            printf("/usr/sbin/gpasswd file not exist \n");
-            return false;
-        }
-        command = gpasswd;
-        args.append("-a");
-        args.append(userName);
-        args.append(groupName);
-    } else {
-        command = usermod;
-        args.append("-G");
-        args.append(groupName);
-        args.append(userName);
-    }
-    p.execute(command,args);//command是要执行的命令,args是参数
-    p.waitForFinished(-1);
-//    qDebug()<<QString::fromLocal8Bit(p.readAllStandardError());
-    return true;
+    return applyOne("addUserToGroup", groupName, userName);
 }
 
 // 删除用户从组
 bool group_manager_server::delUserFromGroup(QString groupName, QString userName)
 {
-    QString gpasswd = "/usr/bin/gpasswd";
-    QString command;
-
-    QFile gpasswdFile(gpasswd);
-
-    QProcess p(0);
-    QStringList args;
-
-    if(!gpasswdFile.exists()){
-        printf("/usr/sbin/gpasswd file not exist \n");
-        return false;
-    }
-    command = gpasswd;
-    args.append("-d");
-    args.append(userName);
-    args.append(groupName);
-
-    p.execute(command,args);//command是要执行的命令,args是参数
-    p.waitForFinished(-1);
-//    qDebug() << QString::fromLocal8Bit(p.readAllStandardError());
-    return true;
+    return applyOne("delUserFromGroup", groupName, userName);
 }
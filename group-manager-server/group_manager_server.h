@@ -20,11 +20,12 @@
 #include <QList>
 #include <QTextStream>
 #include <QDebug>
-#include <QProcess>
 #include <QFile>
 
 #include "custom_struct.h"
 
+class account_file_cache;
+
 class group_manager_server : public QObject
 {
 	Q_OBJECT
@@ -36,6 +37,11 @@ public:
 public slots:
     QVariantList getGroup();
     QVariantList getPasswd();
+    QVariantList getGroupRange(int offset, int count, QString filter);
+    int getGroupCount(QString filter);
+    QVariantList getPasswdRange(int offset, int count, QString filter);
+    int getPasswdCount(QString filter);
+    QStringList applyGroupChanges(QVariantList changes);
     bool add(QString groupName, QString groupId);
     bool set(QString groupName, QString groupId);
     bool del(QString groupName);
@@ -44,6 +50,10 @@ public slots:
 
 private:
     QList<custom_struct> value;
+    account_file_cache *groupCache;
+    account_file_cache *passwdCache;
+
+    bool applyOne(const QString &action, const QString &groupName, const QString &value);
 
 signals:
     void message();
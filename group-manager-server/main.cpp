@@ -32,6 +32,8 @@ int main(int argc, char *argv[])
 
     qRegisterMetaType<custom_struct>("custom_struct");
     qDBusRegisterMetaType<custom_struct>();
+    qRegisterMetaType<group_change>("group_change");
+    qDBusRegisterMetaType<group_change>();
 	QDBusConnection connection = QDBusConnection::systemBus();
 
     if (!connection.registerService("org.ukui.groupmanager")) {
@@ -32,7 +32,7 @@
 class networkaccount : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "networkaccount.json")
     Q_INTERFACES(CommonInterface)
 
 public:
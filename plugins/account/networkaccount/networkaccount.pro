@@ -94,3 +94,6 @@ RESOURCES += \
     qss.qrc
 
 INSTALLS += target
+
+DISTFILES += \
+    networkaccount.json
@@ -27,6 +27,8 @@
 #include "delgroupdialog.h"
 #include "CloseButton/closebutton.h"
 
+#include <QDBusMetaType>
+
 extern void qt_blurImage(QImage &blurImage, qreal radius, bool quality, int transposed);
 
 ChangeGroupDialog::ChangeGroupDialog(QWidget *parent) :
@@ -57,6 +59,33 @@ void ChangeGroupDialog::connectToServer()
     }
     // 将以后所有DBus调用的超时设置为 milliseconds
     serviceInterface->setTimeout(2147483647); // -1 为默认的25s超时
+
+    qRegisterMetaType<group_change>("group_change");
+    qDBusRegisterMetaType<group_change>();
+}
+
+// 一次DBus调用提交所有组修改，返回每项的失败原因(成功为空)
+QStringList ChangeGroupDialog::applyGroupChanges(const QList<group_change> &changes)
+{
+    QVariantList args;
+    for (const group_change &change : changes) {
+        args << QVariant::fromValue(change);
+    }
+
+    QDBusReply<QStringList> reply = serviceInterface->call("applyGroupChanges", args);
+    if (!reply.isValid()) {
+        qDebug() << "applyGroupChanges call failed" << reply.error();
+        return QStringList();
+    }
+
+    QStringList results = reply.value();
+    for (int i = 0; i < results.size() && i < changes.size(); i++) {
+        if (!results.at(i).isEmpty()) {
+            qDebug() << changes.at(i).action << changes.at(i).groupname << changes.at(i).value
+                     << "failed:" << results.at(i);
+        }
+    }
+    return results;
 }
 
 void ChangeGroupDialog::loadGroupInfo()
@@ -291,40 +320,18 @@ void ChangeGroupDialog::initNewGroupBtn()
                     }
                 }
 
-                QDBusReply<bool> reply = serviceInterface->call("add",lineName->text(),lineId->text());
-                if (reply.isValid()){
-                    // use the returned value
-                    qDebug() << "get call value" << reply.value();
-                } else {
-                    // call failed. Show an error condition.
-                    qDebug() << "call failed" << reply.error();
-                }
-
+                // 新建组与成员添加合并为一次提交
+                QList<group_change> changes;
+                changes << group_change{"add", lineName->text(), lineId->text()};
                 for (int i = 0; i < cglist->count(); i++){
                     QListWidgetItem *item = cglist->item(i);
                     QCheckBox *box = static_cast<QCheckBox *> (cglist->itemWidget(item));
                     if(box->isChecked()){
-                        QDBusReply<bool> reply = serviceInterface->call("addUserToGroup",
-                                                        lineName->text(),box->text());
-                        if (reply.isValid()){
-                            // use the returned value
-                            qDebug() << "addUserToGroupget call value" << reply.value() << lineName->text() << box->text();
-                        } else {
-                            // call failed. Show an error condition.
-                            qDebug() << "addUserToGroup call failed" << reply.error();
-                        }
-                    } else {
-                        QDBusReply<bool> reply = serviceInterface->call("delUserFromGroup",
-                                                        lineId->text(),box->text());
-                        if (reply.isValid()){
-                            // use the returned value
-                            qDebug() << "delUserFromGroup get call value" << reply.value() << lineName->text() << box->text();;
-                        } else {
-                            // call failed. Show an error condition.
-                            qDebug() << "delUserFromGroup call failed" << reply.error() << lineName->text() << box->text();;
-                        }
+                        changes << group_change{"addUserToGroup", lineName->text(), box->text()};
                     }
                 }
+                applyGroupChanges(changes);
+
                 refreshList();
                 ui->listWidget->scrollToBottom();
                 dialog->close();
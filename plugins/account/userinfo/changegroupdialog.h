@@ -64,6 +64,32 @@ struct custom_struct
 
 Q_DECLARE_METATYPE(custom_struct)
 
+struct group_change
+{
+    QString action;
+    QString groupname;
+    QString value;
+
+    friend QDBusArgument &operator<<(QDBusArgument &argument, const group_change&change)
+    {
+        argument.beginStructure();
+        argument << change.action << change.groupname << change.value;
+        argument.endStructure();
+        return argument;
+    }
+
+    friend const QDBusArgument &operator>>(const QDBusArgument &argument, group_change&change)
+    {
+        argument.beginStructure();
+        argument >> change.action >> change.groupname >> change.value;
+        argument.endStructure();
+        return argument;
+    }
+
+};
+
+Q_DECLARE_METATYPE(group_change)
+
 namespace Ui {
 class ChangeGroupDialog;
 }
@@ -84,6 +110,7 @@ public:
     void loadAllGroup();
     bool polkit();
     void refreshList();
+    QStringList applyGroupChanges(const QList<group_change> &changes);
 
 public:
     QDBusInterface *serviceInterface;
@@ -212,57 +212,38 @@ void EditGroupDialog::signalsBind()
         _nameHasModified = true;
     });
     connect(ui->certainBtn, &QPushButton::clicked, this, [=](){
-        ChangeGroupDialog *cgDialog = new ChangeGroupDialog;
-        for (int i = 0; i < ui->listWidget->count(); i++){
-            if(_idHasModified){
-                for (int j = 0; j < cgDialog->groupList->size(); j++){
-                    if(ui->lineEdit_id->text() == cgDialog->groupList->at(j)->groupid){
-                        QMessageBox invalid(QMessageBox::Question, tr("Tips"), tr("Invalid Id!"));
-                        invalid.setIcon(QMessageBox::Warning);
-                        invalid.setStandardButtons(QMessageBox::Ok);
-                        invalid.setButtonText(QMessageBox::Ok, QString(tr("OK")));
-                        invalid.exec();
-                        return;
-                    }
+        if(_idHasModified){
+            for (int j = 0; j < cgDialog->groupList->size(); j++){
+                if(ui->lineEdit_id->text() == cgDialog->groupList->at(j)->groupid){
+                    QMessageBox invalid(QMessageBox::Question, tr("Tips"), tr("Invalid Id!"));
+                    invalid.setIcon(QMessageBox::Warning);
+                    invalid.setStandardButtons(QMessageBox::Ok);
+                    invalid.setButtonText(QMessageBox::Ok, QString(tr("OK")));
+                    invalid.exec();
+                    return;
                 }
             }
+        }
+
+        // 组id与全部成员变化合并为一次提交
+        QList<group_change> changes;
+        if(_idHasModified){
+            changes << group_change{"set", ui->lineEdit_name->text(), ui->lineEdit_id->text()};
+        }
+        QStringList usergroupList = userGroup.split(",");
+        for (int i = 0; i < ui->listWidget->count(); i++){
             QListWidgetItem *item = ui->listWidget->item(i);
             QCheckBox *box = static_cast<QCheckBox *> (ui->listWidget->itemWidget(item));
-
-            QDBusReply<bool> reply = cgDialog->serviceInterface->call("set",
-                                            ui->lineEdit_name->text(),ui->lineEdit_id->text());
-            if (reply.isValid()){
-                // use the returned value
-                qDebug() << "set get call value" << reply.value();
-            } else {
-                // call failed. Show an error condition.
-                qDebug() << "set call failed" << reply.error();
-            }
-
-            if(box->isChecked()){
-                QDBusReply<bool> reply = cgDialog->serviceInterface->call("addUserToGroup",
-                                                ui->lineEdit_name->text(),box->text());
-                if (reply.isValid()){
-                    // use the returned value
-                    qDebug() << "addUserToGroup get call value" << reply.value();
-                } else {
-                    // call failed. Show an error condition.
-                    qDebug() << "addUserToGroup call failed" << reply.error();
-                }
-            } else {
-                QDBusReply<bool> reply = cgDialog->serviceInterface->call("delUserFromGroup",
-                                                ui->lineEdit_name->text(),box->text());
-                if (reply.isValid()){
-                    // use the returned value
-                    qDebug() << "delUserFromGroup get call value" << reply.value();
-                } else {
-                    // call failed. Show an error condition.
-                    qDebug() << "delUserFromGroup call failed" << reply.error();
-                }
+            if (box->isChecked() == usergroupList.contains(box->text()) || !box->isEnabled()){
+                continue;
             }
+            changes << group_change{box->isChecked() ? "addUserToGroup" : "delUserFromGroup",
+                                    ui->lineEdit_name->text(), box->text()};
+        }
+        if (!changes.isEmpty()){
+            cgDialog->applyGroupChanges(changes);
         }
         emit needRefresh();
-        delete cgDialog;
         close();
     });
 }
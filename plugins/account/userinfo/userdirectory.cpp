@@ -0,0 +1,202 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "userdirectory.h"
+
+#include <QDBusConnection>
+#include <QDBusInterface>
+#include <QDBusMessage>
+#include <QDBusPendingCall>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusObjectPath>
+#include <QDBusReply>
+#include <QSettings>
+#include <QVariantMap>
+#include <QDebug>
+
+#include <pwd.h>
+#include <unistd.h>
+
+#define DEFAULTFACE "/usr/share/ukui/faces/default.png"
+#define ACCOUNTS_SERVICE "org.freedesktop.Accounts"
+#define LIGHTDM_CONF "/etc/lightdm/lightdm.conf"
+#define NOPWD_GROUP "nopasswdlogin"
+
+UserDirectory::UserDirectory(QObject *parent) :
+    QObject(parent),
+    mGeneration(0),
+    mPending(0),
+    mRefreshing(false),
+    mCurrentNoPwdLogin(false)
+{
+    qRegisterMetaType<UserInfomation>("UserInfomation");
+}
+
+UserDirectory::~UserDirectory()
+{
+}
+
+void UserDirectory::refresh(){
+    mGeneration++;
+    mPending = 0;
+    mRefreshing = true;
+    mObjectPaths.clear();
+
+    struct passwd * pwd = getpwuid(getuid());
+    mCurrentUser = pwd ? QString::fromLocal8Bit(pwd->pw_name) : QString();
+
+    // 每次刷新只读取一次，所有用户共用
+    mAutoLoginUser = readAutoLoginUser();
+    mCurrentNoPwdLogin = readNoPwdLoginStatus(mCurrentUser);
+
+    emit refreshStarted();
+
+    //root
+    if (!getuid()){
+        UserInfomation root;
+        root.username = mCurrentUser;
+        root.current = true;
+        root.logined = true;
+        root.autologin = false;
+        root.noPwdLogin = false;
+        root.uid = 0;
+        root.accounttype = ADMINISTRATOR;
+        root.passwdtype = 0;
+        root.iconfile = DEFAULTFACE;
+        emit userReady(root);
+    }
+
+    QDBusMessage msg = QDBusMessage::createMethodCall(ACCOUNTS_SERVICE,
+                                                      "/org/freedesktop/Accounts",
+                                                      "org.freedesktop.Accounts",
+                                                      "ListCachedUsers");
+    QDBusPendingCallWatcher * watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(msg), this);
+    watcher->setProperty("generation", mGeneration);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, &UserDirectory::listReplied);
+}
+
+bool UserDirectory::isRefreshing() const{
+    return mRefreshing;
+}
+
+QStringList UserDirectory::objectPaths() const{
+    return mObjectPaths;
+}
+
+void UserDirectory::listReplied(QDBusPendingCallWatcher *watcher){
+    watcher->deleteLater();
+    if (watcher->property("generation").toInt() != mGeneration)
+        return;
+
+    QDBusPendingReply<QList<QDBusObjectPath> > reply = *watcher;
+    if (reply.isError()) {
+        qDebug() << "ListCachedUsers failed:" << reply.error().message();
+    } else {
+        for (const QDBusObjectPath &op : reply.value()) {
+            mObjectPaths << op.path();
+        }
+    }
+
+    // 全部请求同时发出，回复按到达顺序处理
+    for (const QString &path : mObjectPaths) {
+        QDBusMessage msg = QDBusMessage::createMethodCall(ACCOUNTS_SERVICE,
+                                                          path,
+                                                          "org.freedesktop.DBus.Properties",
+                                                          "GetAll");
+        msg << QString("org.freedesktop.Accounts.User");
+
+        QDBusPendingCallWatcher * userWatcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(msg), this);
+        userWatcher->setProperty("generation", mGeneration);
+        userWatcher->setProperty("objpath", path);
+        connect(userWatcher, &QDBusPendingCallWatcher::finished, this, &UserDirectory::userReplied);
+        mPending++;
+    }
+
+    if (mPending == 0) {
+        mRefreshing = false;
+        emit refreshFinished();
+    }
+}
+
+void UserDirectory::userReplied(QDBusPendingCallWatcher *watcher){
+    watcher->deleteLater();
+    if (watcher->property("generation").toInt() != mGeneration)
+        return;
+
+    QDBusPendingReply<QVariantMap> reply = *watcher;
+    if (reply.isError()) {
+        qDebug() << "reply failed" << reply.error().message();
+        finishOne();
+        return;
+    }
+
+    QVariantMap propertyMap = reply.value();
+
+    UserInfomation user;
+    user.objpath = watcher->property("objpath").toString();
+    user.username = propertyMap.value("UserName").toString();
+    user.current = (user.username == mCurrentUser);
+    user.logined = user.current;
+    // 界面只展示当前用户的免密登录状态
+    user.noPwdLogin = user.current && mCurrentNoPwdLogin;
+    user.accounttype = propertyMap.value("AccountType").toInt();
+    user.iconfile = propertyMap.value("IconFile").toString();
+    user.passwdtype = propertyMap.value("PasswordMode").toInt();
+    user.uid = propertyMap.value("Uid").toLongLong();
+    user.autologin = (!mAutoLoginUser.isEmpty() && mAutoLoginUser == user.username);
+
+    emit userReady(user);
+    finishOne();
+}
+
+void UserDirectory::finishOne(){
+    if (--mPending == 0) {
+        mRefreshing = false;
+        emit refreshFinished();
+    }
+}
+
+QString UserDirectory::readAutoLoginUser(){
+    QSettings autoSettings(LIGHTDM_CONF, QSettings::IniFormat);
+    autoSettings.beginGroup("SeatDefaults");
+    QString autoUser = autoSettings.value("autologin-user", "").toString();
+    autoSettings.endGroup();
+
+    return autoUser;
+}
+
+bool UserDirectory::readNoPwdLoginStatus(const QString &username){
+    // 由系统服务查询，经NSS解析并计入主组
+    QDBusInterface sysinterface("com.control.center.qt.systemdbus",
+                                "/",
+                                "com.control.center.interface",
+                                QDBusConnection::systemBus());
+    if (!sysinterface.isValid()) {
+        qCritical() << "Create Client Interface Failed When get nopasswdlogin status: " << QDBusConnection::systemBus().lastError();
+        return false;
+    }
+
+    QDBusReply<bool> reply = sysinterface.call("isUserInGroup", username, QString(NOPWD_GROUP));
+    if (!reply.isValid()) {
+        qDebug() << "isUserInGroup failed:" << reply.error().message();
+        return false;
+    }
+    return reply.value();
+}
@@ -0,0 +1,92 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef USERDIRECTORY_H
+#define USERDIRECTORY_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+class QDBusPendingCallWatcher;
+
+enum {
+    STANDARDUSER,
+    ADMINISTRATOR,
+    ROOT
+};
+
+typedef struct _UserInfomation {
+    QString objpath;
+    QString username;
+    QString iconfile;
+    QString passwd;
+    int accounttype;
+    int passwdtype;
+    bool current;
+    bool logined;
+    bool autologin;
+    bool noPwdLogin;
+    qint64 uid;
+}UserInfomation;
+
+/**
+ * \brief UserDirectory
+ * 异步获取系统用户列表：ListCachedUsers返回后并发发出全部GetAll请求，
+ * 每收到一个回复即通过userReady发出；自动登录配置与当前用户免密登录状态每次刷新只读取一次。
+ */
+class UserDirectory : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UserDirectory(QObject *parent = 0);
+    ~UserDirectory();
+
+public:
+    void refresh();
+    bool isRefreshing() const;
+    QStringList objectPaths() const;
+
+    static QString readAutoLoginUser();
+    static bool readNoPwdLoginStatus(const QString &username);
+
+private:
+    void listReplied(QDBusPendingCallWatcher * watcher);
+    void userReplied(QDBusPendingCallWatcher * watcher);
+    void finishOne();
+
+private:
+    // 每次刷新递增，丢弃过期刷新的回复
+    int mGeneration;
+    int mPending;
+    bool mRefreshing;
+
+    QString mCurrentUser;
+    QString mAutoLoginUser;
+    bool mCurrentNoPwdLogin;
+    QStringList mObjectPaths;
+
+Q_SIGNALS:
+    void refreshStarted();
+    void userReady(UserInfomation user);
+    void refreshFinished();
+};
+
+#endif // USERDIRECTORY_H
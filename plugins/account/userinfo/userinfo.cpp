@@ -29,6 +29,7 @@
 #include <QDBusObjectPath>
 #include <QDebug>
 #include <QMessageBox>
+#include <QFile>
 
 #include "SwitchButton/switchbutton.h"
 #include "ImageUtil/imageutil.h"
@@ -49,7 +50,7 @@
 #define DEFAULTFACE "/usr/share/ukui/faces/default.png"
 #define ITEMHEIGH 52
 
-UserInfo::UserInfo() : mFirstLoad(true)
+UserInfo::UserInfo() : adminnum(0), mPendingAdminnum(0), mFirstLoad(true)
 {
     pluginName = tr("User Info");
     pluginType = ACCOUNT;
@@ -59,7 +60,6 @@ UserInfo::~UserInfo()
 {
     if (!mFirstLoad) {
         delete ui;
-        delete autoSettings;
     }
 }
 
@@ -86,15 +86,29 @@ QWidget *UserInfo::get_plugin_ui() {
         // 构建System dbus调度对象
         sysdispatcher = new SystemDbusDispatcher(this);
 
-        // 获取系统全部用户信息，用户Uid大于等于1000的
-        _acquireAllUsersInfo();
+        // 异步获取用户信息，回复到达后逐个填充界面
+        mUserDirectory = new UserDirectory(this);
+        connect(mUserDirectory, &UserDirectory::userReady, this, &UserInfo::_addUserInfo);
+        connect(mUserDirectory, &UserDirectory::refreshFinished, this, [=]{
+            allUserInfoMap.swap(mPendingUserInfoMap);
+            mPendingUserInfoMap.clear();
+            adminnum = mPendingAdminnum;
+            mUserDelegate->setAdminCount(adminnum);
+
+            bool empty = allUserInfoMap.isEmpty();
+            ui->currentUserFrame->setVisible(!empty);
+            ui->autoLoginFrame->setVisible(!empty && getuid());
+            ui->liveFrame->setVisible(empty);
+
+            initUserPropertyConnection(mUserDirectory->objectPaths());
+        });
 
         initSearchText();
         readCurrentPwdConf();
         initComponent();
-        initAllUserStatus();
-        // 设置界面用户信息
-        _refreshUserInfoUI();
+
+        // 获取系统全部用户信息，用户Uid大于等于1000的
+        _acquireAllUsersInfo();
     }
     return pluginWidget;
 }
@@ -140,82 +154,38 @@ void UserInfo::_acquireAllUsersInfo(){
         mUserName = qgetenv("USERNAME");
     }
 
-    QStringList objectpaths = sysdispatcher->list_cached_users();
-
-    //初始化用户信息QMap
-    allUserInfoMap.clear();
+    //初始化临时用户信息QMap，刷新完成前对话框仍使用上一次的完整数据
+    mPendingUserInfoMap.clear();
     //初始化管理员数目为0
-    adminnum = 0;
+    mPendingAdminnum = 0;
 
-    //root
-    if (!getuid()){
-        UserInfomation root;
-        root.username = g_get_user_name();
-        root.current = true;
-        root.logined = true;
-        root.autologin = false;
-        root.uid = 0;
-        root.accounttype = ADMINISTRATOR;
-        root.iconfile = DEFAULTFACE;
-        allUserInfoMap.insert(root.username, root);
-    }
-
-    for (QString objectpath : objectpaths){
-        UserInfomation user;
-        user = _acquireUserInfo(objectpath);
-        allUserInfoMap.insert(user.username, user);
-    }
+    //清空其他用户列表，由回复重新填充
+    _closeItemEditor();
+    mUserModel->clear();
+    _resetListWidgetHeigh();
 
-    if (allUserInfoMap.isEmpty()) {
-        ui->currentUserFrame->setVisible(false);
-        ui->autoLoginFrame->setVisible(false);
-        ui->liveFrame->setVisible(true);
-    } else {
-        ui->currentUserFrame->setVisible(true);
-        ui->autoLoginFrame->setVisible(true);
-        ui->liveFrame->setVisible(false);
-    }
-    initUserPropertyConnection(objectpaths);
+    mUserDirectory->refresh();
 }
 
-UserInfomation UserInfo::_acquireUserInfo(QString objpath){
-    UserInfomation user;
-
-    //默认值
-    user.current = false;
-    user.logined = false;
-    user.autologin = false;
-
-    QDBusInterface * iproperty = new QDBusInterface("org.freedesktop.Accounts",
-                                            objpath,
-                                            "org.freedesktop.DBus.Properties",
-                                            QDBusConnection::systemBus());
-    QDBusReply<QMap<QString, QVariant> > reply = iproperty->call("GetAll", "org.freedesktop.Accounts.User");
-    if (reply.isValid()){
-        QMap<QString, QVariant> propertyMap;
-        propertyMap = reply.value();
-        user.username = propertyMap.find("UserName").value().toString();
-        if (user.username == QString(g_get_user_name())) {
-            user.current = true;
-            user.logined = true;
-            user.noPwdLogin = getNoPwdStatus();
-        }
-        user.accounttype = propertyMap.find("AccountType").value().toInt();
-        if (user.accounttype == ADMINISTRATOR)
-            adminnum++;
-        user.iconfile = propertyMap.find("IconFile").value().toString();
-        user.passwdtype = propertyMap.find("PasswordMode").value().toInt();
-        user.uid = propertyMap.find("Uid").value().toInt();
-//        user.autologin = propertyMap.find("AutomaticLogin").value().toBool();
-        user.autologin = this->getAutomaticLogin(user.username);
-        user.objpath = objpath;
+void UserInfo::_addUserInfo(UserInfomation user){
+    //用户头像为.face且.face文件不存在
+    if (!QFile::exists(user.iconfile)){
+        user.iconfile = DEFAULTFACE;
     }
-    else
-        qDebug() << "reply failed";
 
-    delete iproperty;
+    //root不计入管理员数目
+    if (user.accounttype == ADMINISTRATOR && user.uid != 0)
+        mPendingAdminnum++;
+
+    mPendingUserInfoMap.insert(user.username, user);
 
-    return user;
+    if (user.current){
+        _refreshCurrentUserUI(user);
+    } else { //其他用户
+        mUserModel->addUser(user);
+        _resetListWidgetHeigh();
+    }
+    mUserDelegate->setAdminCount(mPendingAdminnum);
 }
 
 void UserInfo::readCurrentPwdConf(){
@@ -348,7 +318,26 @@ void UserInfo::initComponent(){
         ui->autoLoginFrame_2->setVisible(false);
     }
 
-    ui->listWidget->setStyleSheet("QListWidget::Item:hover{background:palette(base);}");
+    // 其他用户列表
+    mUserModel = new UserListModel(this);
+    mUserDelegate = new UserItemDelegate(this);
+    ui->listView->setModel(mUserModel);
+    ui->listView->setItemDelegate(mUserDelegate);
+    ui->listView->setUniformItemSizes(true);
+    ui->listView->setMouseTracking(true);
+    ui->listView->setSelectionMode(QAbstractItemView::NoSelection);
+    ui->listView->setFocusPolicy(Qt::NoFocus);
+    ui->listView->setFrameShape(QFrame::NoFrame);
+    ui->listView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    ui->listView->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    ui->listView->viewport()->installEventFilter(this);
+
+    connect(ui->listView, &QListView::entered, this, &UserInfo::_openItemEditor);
+    // 对话框可能刷新列表并销毁发出信号的编辑器，排队调用避免在其按钮回调中析构
+    connect(mUserDelegate, &UserItemDelegate::changeFaceClicked, this, &UserInfo::showChangeFaceDialog, Qt::QueuedConnection);
+    connect(mUserDelegate, &UserItemDelegate::changeTypeClicked, this, &UserInfo::showChangeTypeDialog, Qt::QueuedConnection);
+    connect(mUserDelegate, &UserItemDelegate::changePwdClicked, this, &UserInfo::showChangePwdDialog, Qt::QueuedConnection);
+    connect(mUserDelegate, &UserItemDelegate::deleteClicked, this, &UserInfo::showDeleteUserDialog, Qt::QueuedConnection);
 
     addWgt = new HoverWidget("");
     addWgt->setObjectName("addwgt");
@@ -399,11 +388,6 @@ void UserInfo::initComponent(){
     ui->autoLoginHorLayout->addWidget(autoLoginSwitchBtn);
 
 
-//    ui->listWidget->setStyleSheet("QListWidget{background: #00ffff}");
-//    ui->listWidget->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-//    ui->listWidget->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    ui->listWidget->setSpacing(0);
-
     ElipseMaskWidget * mainElipseMaskWidget = new ElipseMaskWidget(ui->currentUserFaceLabel);
     mainElipseMaskWidget->setGeometry(0, 0, ui->currentUserFaceLabel->width(), ui->currentUserFaceLabel->height());
 
@@ -462,7 +446,16 @@ void UserInfo::initComponent(){
                 qCritical() << "Create Client Interface Failed When execute gpasswd: " << QDBusConnection::systemBus().lastError();
                 return;
             }
-            tmpSysinterface->call("setNoPwdLoginStatus", checked, user.username);
+            QStringList add, remove;
+            if (checked) {
+                add << user.username;
+            } else {
+                remove << user.username;
+            }
+            QDBusReply<QString> reply = tmpSysinterface->call("setGroupMembership", QString("nopasswdlogin"), add, remove);
+            if (!reply.isValid() || !reply.value().isEmpty()) {
+                qWarning() << "set nopasswdlogin failed:" << (reply.isValid() ? reply.value() : reply.error().message());
+            }
 
             delete tmpSysinterface;
 
@@ -515,27 +508,7 @@ void UserInfo::initComponent(){
 
 void UserInfo::_resetListWidgetHeigh(){
     //设置其他用户控件的总高度
-    ui->listWidget->setFixedHeight((allUserInfoMap.count()) * ITEMHEIGH - allUserInfoMap.count() * 6);
-}
-
-void UserInfo::initAllUserStatus(){
-    _resetListWidgetHeigh();
-
-    //每次初始化用户状态清空其他用户QMap
-    otherUserItemMap.clear();
-
-    QMap<QString, UserInfomation>::iterator it = allUserInfoMap.begin();
-    for (; it != allUserInfoMap.end(); it++){
-        UserInfomation user = it.value();
-
-        //当前用户
-        if (user.username == QString(g_get_user_name())){
-
-        } else { //其他用户
-            _buildWidgetForItem(user);
-
-        }
-    }
+    ui->listView->setFixedHeight(mUserModel->rowCount() * ITEMHEIGH);
 }
 
 QStringList UserInfo::getLoginedUsers() {
@@ -586,171 +559,40 @@ QStringList UserInfo::getLoginedUsers() {
     return m_loginedUser;
 }
 
-void UserInfo::_refreshUserInfoUI(){
-    QMap<QString, UserInfomation>::iterator it = allUserInfoMap.begin();
-    for (; it != allUserInfoMap.end(); it++){
-        UserInfomation user = it.value();
-
-        //用户头像为.face且.face文件不存在
-        char * iconpath = user.iconfile.toLatin1().data();
-        if (!g_file_test(iconpath, G_FILE_TEST_EXISTS)){
-            user.iconfile = DEFAULTFACE;
-            //更新用户数据
-            allUserInfoMap.find(it.key()).value().iconfile = DEFAULTFACE;
-        }
+void UserInfo::_refreshCurrentUserUI(const UserInfomation &user){
+    //设置用户头像
+    QPixmap iconPixmap = QPixmap(user.iconfile).scaled(ui->currentUserFaceLabel->size());
+    ui->currentUserFaceLabel->setPixmap(iconPixmap);
 
-        //当前用户
-        if (user.username == QString(g_get_user_name())){
-            //设置用户头像
-            QPixmap iconPixmap = QPixmap(user.iconfile).scaled(ui->currentUserFaceLabel->size());
-//            ui->currentUserFaceLabel->setScaledContents(true);
-            ui->currentUserFaceLabel->setPixmap(iconPixmap);
-
-            //设置用户名
-            ui->userNameLabel->setText(user.username);
-            //设置用户类型
-            ui->userTypeLabel->setText(_accountTypeIntToString(user.accounttype));
-            //设置登录状态
-            autoLoginSwitchBtn->setChecked(user.autologin);
-            //设置免密登录状态
-            nopwdSwitchBtn->setChecked(user.noPwdLogin);
-
-        } else { //其他用户
-            QListWidgetItem * item = otherUserItemMap.value(user.objpath); //是否需要判断？？
-
-            QWidget * widget = ui->listWidget->itemWidget(item);
-
-            QPushButton * faceBtn = widget->findChild<QPushButton *>("faceBtn");
-            faceBtn->setIcon(QIcon(user.iconfile));
-
-        }
-    }
+    //设置用户名
+    ui->userNameLabel->setText(user.username);
+    //设置用户类型
+    ui->userTypeLabel->setText(_accountTypeIntToString(user.accounttype));
+    //设置登录状态
+    autoLoginSwitchBtn->blockSignals(true);
+    autoLoginSwitchBtn->setChecked(user.autologin);
+    autoLoginSwitchBtn->blockSignals(false);
+    //设置免密登录状态
+    nopwdSwitchBtn->blockSignals(true);
+    nopwdSwitchBtn->setChecked(user.noPwdLogin);
+    nopwdSwitchBtn->blockSignals(false);
 }
 
-void UserInfo::_buildWidgetForItem(UserInfomation user){
-    HoverWidget * baseWidget = new HoverWidget(user.username);
-    baseWidget->setMinimumSize(550,50);
-    baseWidget->setMaximumSize(960,50);
-    baseWidget->setAttribute(Qt::WA_DeleteOnClose);
-
-    //ui->currentUserFrame->setContentsMargins(16,0,16,0);
-
-    QHBoxLayout * baseVerLayout = new QHBoxLayout(baseWidget);
-    baseVerLayout->setSpacing(0);
-    baseVerLayout->setMargin(0);
-
-    QHBoxLayout * baseHorLayout = new QHBoxLayout();
-    baseHorLayout->setSpacing(16);
-    baseHorLayout->setMargin(0);
-
-    QFrame * widget = new QFrame(baseWidget);
-    widget->setFrameShape(QFrame::Shape::Box);
-    widget->setFixedHeight(50);
-
-    QHBoxLayout * mainHorLayout = new QHBoxLayout(widget);
-    mainHorLayout->setSpacing(16);
-    mainHorLayout->setContentsMargins(16, 0, 16, 0);
-
-    QPushButton * faceBtn = new QPushButton(widget);
-    faceBtn->setObjectName("faceBtn");
-    faceBtn->setFixedSize(32, 32);
-    faceBtn->setIcon(QIcon(user.iconfile));
-    faceBtn->setIconSize(faceBtn->size());
-    connect(faceBtn, &QPushButton::clicked, [=](bool checked){
-        Q_UNUSED(checked)
-        showChangeFaceDialog(user.username);
-    });
-
-    QLabel * nameLabel = new QLabel(widget);
-    QSizePolicy nameSizePolicy = nameLabel->sizePolicy();
-    nameSizePolicy.setHorizontalPolicy(QSizePolicy::Fixed);
-    nameSizePolicy.setVerticalPolicy(QSizePolicy::Fixed);
-    nameLabel->setSizePolicy(nameSizePolicy);
-    nameLabel->setText(user.username);
-
-    QString btnQss = QString("QPushButton{background: #ffffff; border-radius: 4px;}");
-
-    QPushButton * typeBtn = new QPushButton(widget);
-//    typeBtn->setFixedSize(88, 36);
-    typeBtn->setFixedHeight(36);
-    typeBtn->setMinimumWidth(88);
-    typeBtn->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
-    typeBtn->setText(tr("Change type"));
-//    typeBtn->setStyleSheet(btnQss);
-    connect(typeBtn, &QPushButton::clicked, this, [=](bool checked){
-        Q_UNUSED(checked)
-        showChangeTypeDialog(user.username);
-    });
-    typeBtn->hide();
-
-    QPushButton * pwdBtn = new QPushButton(widget);
-//    pwdBtn->setFixedSize(88, 36);
-    pwdBtn->setFixedHeight(36);
-    pwdBtn->setMinimumWidth(88);
-    pwdBtn->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
-    pwdBtn->setText(tr("Change pwd"));
-//    pwdBtn->setStyleSheet(btnQss);
-    connect(pwdBtn, &QPushButton::clicked, this, [=](bool checked){
-        Q_UNUSED(checked)
-        showChangePwdDialog(user.username);
-    });
-    pwdBtn->hide();
-
-    mainHorLayout->addWidget(faceBtn);
-    mainHorLayout->addWidget(nameLabel);
-    mainHorLayout->addStretch();
-    mainHorLayout->addWidget(typeBtn);
-    mainHorLayout->addWidget(pwdBtn);
-
-    widget->setLayout(mainHorLayout);
-
-    QPushButton * delBtn = new QPushButton(baseWidget);
-    delBtn->setFixedSize(60, 36);
-    delBtn->setText(tr("Delete"));
-//    delBtn->setStyleSheet("QPushButton{background: #FA6056; border-radius: 4px}");
-    delBtn->hide();
-    connect(delBtn, &QPushButton::clicked, this, [=](bool checked){
-        Q_UNUSED(checked)
-        showDeleteUserDialog(user.username);
-    });
-
-    connect(baseWidget, &HoverWidget::enterWidget, this, [=](QString name){
-        Q_UNUSED(name)
-
-        //不允许删除最后一个管理员
-        if (user.accounttype > 0 && adminnum == 1){
-            delBtn->setEnabled(false);
-        } else {
-            delBtn->setEnabled(true);
-        }
-        typeBtn->show();
-        pwdBtn->show();
-        delBtn->show();
-    });
-    connect(baseWidget, &HoverWidget::leaveWidget, this, [=](QString name){
-        Q_UNUSED(name)
-        typeBtn->hide();
-        pwdBtn->hide();
-        delBtn->hide();
-    });
-
-    baseHorLayout->addWidget(widget);
-    baseHorLayout->addWidget(delBtn, Qt::AlignVCenter);
-    baseHorLayout->addSpacing(4);
-
-    baseVerLayout->addLayout(baseHorLayout);
-//    baseVerLayout->addStretch();
-
-    baseWidget->setLayout(baseVerLayout);
+void UserInfo::_openItemEditor(const QModelIndex &index){
+    if (mEditorIndex == index)
+        return;
 
-    QListWidgetItem * item = new QListWidgetItem(ui->listWidget);
-//    item->setSizeHint(QSize(ui->listWidget->width() - 4, ITEMHEIGH));
-    item->setSizeHint(QSize(QSizePolicy::Expanding, ITEMHEIGH));
-    item->setData(Qt::UserRole, QVariant(user.objpath));
-    ui->listWidget->setItemWidget(item, baseWidget);
+    _closeItemEditor();
 
-    otherUserItemMap.insert(user.objpath, item);
+    ui->listView->openPersistentEditor(index);
+    mEditorIndex = index;
+}
 
+void UserInfo::_closeItemEditor(){
+    if (mEditorIndex.isValid()) {
+        ui->listView->closePersistentEditor(mEditorIndex);
+    }
+    mEditorIndex = QPersistentModelIndex();
 }
 
 void UserInfo::showCreateUserDialog(){
@@ -792,17 +634,8 @@ void UserInfo::createUserDone(QString objpath){
     //设置默认密码
     userdispatcher->change_user_pwd(_newUserPwd, "");
 
-    //刷新全部用户信息
+    //刷新全部用户信息，新建用户随回复加入列表
     _acquireAllUsersInfo();
-    //重建其他用户ListWidget高度
-    _resetListWidgetHeigh();
-
-    //获取新建用户信息
-    UserInfomation user;
-    user = _acquireUserInfo(objpath);
-
-    //构建Item
-    _buildWidgetForItem(user);
 }
 
 void UserInfo::showDeleteUserDialog(QString username){
@@ -812,7 +645,12 @@ void UserInfo::showDeleteUserDialog(QString username){
         QMessageBox::warning(pluginWidget, tr("Warning"), tr("The user is logged in, please delete the user after logging out"));
         return;
     }
-    UserInfomation user = (UserInfomation)(allUserInfoMap.find(username).value());
+    auto it = allUserInfoMap.constFind(username);
+    if (it == allUserInfoMap.constEnd()) {
+        qDebug() << "User Info Data Not Found:" << username;
+        return;
+    }
+    UserInfomation user = it.value();
 
     DelUserDialog * dialog = new DelUserDialog;
     dialog->setAttribute(Qt::WA_DeleteOnClose);
@@ -827,17 +665,25 @@ void UserInfo::showDeleteUserDialog(QString username){
 void UserInfo::deleteUser(bool removefile, QString username){
     qDebug() << allUserInfoMap.keys() << username;
 
-    UserInfomation user = (UserInfomation)(allUserInfoMap.find(username).value());
+    auto it = allUserInfoMap.constFind(username);
+    if (it == allUserInfoMap.constEnd()) {
+        qDebug() << "User Info Data Not Found:" << username;
+        return;
+    }
+    UserInfomation user = it.value();
 
     // hidden the item when click delete user button
-//    QListWidgetItem *item =  otherUserItemMap.find(user.objpath).value();
-//    ui->listWidget->setItemHidden(item, true);
 
     sysdispatcher->delete_user(user.uid, removefile);
 }
 
 void UserInfo::delete_user_slot(bool removefile, QString username){
-    UserInfomation user = (UserInfomation)(allUserInfoMap.find(username).value());
+    auto it = allUserInfoMap.constFind(username);
+    if (it == allUserInfoMap.constEnd()) {
+        qDebug() << "User Info Data Not Found:" << username;
+        return;
+    }
+    UserInfomation user = it.value();
 
     sysdispatcher->delete_user(user.uid, removefile);
 }
@@ -847,11 +693,8 @@ void UserInfo::pwdAndAutoChangedSlot(QString key) {
         autoLoginSwitchBtn->setChecked(getAutomaticLogin(mUserName));
         nopwdSwitchBtn->setChecked(getNoPwdStatus());
     } else if( "avatar" == key) {
-        //更新所有用户信息
+        //更新所有用户信息及界面显示
         _acquireAllUsersInfo();
-
-        //更新界面显示
-        _refreshUserInfoUI();
     }
 }
 
@@ -871,19 +714,10 @@ void UserInfo::propertyChangedSlot(QString property, QMap<QString, QVariant> pro
 }
 
 void UserInfo::deleteUserDone(QString objpath){
-    QListWidgetItem * item = otherUserItemMap.value(objpath);
-
-    //删除Item
-    ui->listWidget->takeItem(ui->listWidget->row(item));
-
-    //更新其他用户QMap
-    otherUserItemMap.remove(objpath);
+    Q_UNUSED(objpath)
 
-    //重新获取全部用户QMap
+    //重新获取全部用户QMap，并重建用户列表
     _acquireAllUsersInfo();
-
-    //更新界面显示
-    _refreshUserInfoUI();
 }
 
 void UserInfo::showChangeGroupDialog(){
@@ -931,7 +765,12 @@ void UserInfo::showChangeTypeDialog(QString username){
 }
 
 void UserInfo::changeUserType(int atype, QString username){
-    UserInfomation user = allUserInfoMap.value(username);
+    auto it = allUserInfoMap.constFind(username);
+    if (it == allUserInfoMap.constEnd()) {
+        qDebug() << "User Info Data Not Found:" << username;
+        return;
+    }
+    UserInfomation user = it.value();
 
     //构建dbus调度对象
     UserDispatcher * userdispatcher  = new UserDispatcher(user.objpath); //继承QObject不再删除
@@ -939,16 +778,18 @@ void UserInfo::changeUserType(int atype, QString username){
     //更改用户类型
     userdispatcher->change_user_type(atype);
 
-    //重新获取全部用户QMap
+    //重新获取全部用户QMap，并更新界面显示
     _acquireAllUsersInfo();
-
-    //更新界面显示
-    _refreshUserInfoUI();
 }
 
 
 void UserInfo::showChangeFaceDialog(QString username){
-    UserInfomation user = (UserInfomation)(allUserInfoMap.find(username).value());
+    auto it = allUserInfoMap.constFind(username);
+    if (it == allUserInfoMap.constEnd()) {
+        qDebug() << "User Info Data Not Found:" << username;
+        return;
+    }
+    UserInfomation user = it.value();
 
     ChangeFaceDialog * dialog = new ChangeFaceDialog;
     dialog->setFace(user.iconfile);
@@ -962,7 +803,12 @@ void UserInfo::showChangeFaceDialog(QString username){
 }
 
 void UserInfo::changeUserFace(QString facefile, QString username){
-    UserInfomation user = (UserInfomation)(allUserInfoMap.find(username).value());
+    auto it = allUserInfoMap.constFind(username);
+    if (it == allUserInfoMap.constEnd()) {
+        qDebug() << "User Info Data Not Found:" << username;
+        return;
+    }
+    UserInfomation user = it.value();
 
     UserDispatcher * userdispatcher  = new UserDispatcher(user.objpath);
     userdispatcher->change_user_face(facefile);
@@ -983,11 +829,8 @@ void UserInfo::changeUserFace(QString facefile, QString username){
 
     QProcess::execute(cmd);
 
-    //重新获取全部用户QMap
+    //重新获取全部用户QMap，并更新界面显示
     _acquireAllUsersInfo();
-
-    //更新界面显示
-    _refreshUserInfoUI();
 }
 
 void UserInfo::showChangePwdDialog(QString username){
@@ -1012,8 +855,13 @@ void UserInfo::showChangePwdDialog(QString username){
 
 
 void UserInfo::changeUserPwd(QString pwd, QString username){
-    //上层已做判断，这里不去判断而直接获取
-    UserInfomation user = allUserInfoMap.value(username);
+    //对话框打开期间可能发生刷新，用户不存在时直接返回
+    auto it = allUserInfoMap.constFind(username);
+    if (it == allUserInfoMap.constEnd()) {
+        qDebug() << "User Info Data Not Found:" << username;
+        return;
+    }
+    UserInfomation user = it.value();
 
     UserDispatcher * userdispatcher  = new UserDispatcher(user.objpath); //继承QObject不再删除
     QString result = userdispatcher->change_user_pwd(pwd, "");
@@ -1023,6 +871,12 @@ void UserInfo::changeUserPwd(QString pwd, QString username){
 
 
 bool UserInfo::eventFilter(QObject *watched, QEvent *event){
+    //鼠标离开列表时销毁悬停行的操作控件
+    if (watched == ui->listView->viewport() && event->type() == QEvent::Leave){
+        _closeItemEditor();
+        return false;
+    }
+
     if (watched == ui->currentUserFaceLabel){
         if (event->type() == QEvent::MouseButtonPress){
             QMouseEvent * mouseEvent = static_cast<QMouseEvent *>(event);
@@ -1041,31 +895,12 @@ bool UserInfo::eventFilter(QObject *watched, QEvent *event){
 }
 
 bool UserInfo::getAutomaticLogin(QString username) {
-
-    QString filename = "/etc/lightdm/lightdm.conf";
-    autoSettings = new QSettings(filename, QSettings::IniFormat);
-    autoSettings->beginGroup("SeatDefaults");
-
-    QString autoUser = autoSettings->value("autologin-user", "").toString();
-
-    autoSettings->endGroup();
-
-    return autoUser == username ? true : false;
+    return UserDirectory::readAutoLoginUser() == username;
 }
 
 bool UserInfo::getNoPwdStatus() {
     // 获取当前用户免密登录属性
-    QDBusInterface tmpSysinterface("com.control.center.qt.systemdbus",
-                                     "/",
-                                     "com.control.center.interface",
-                                     QDBusConnection::systemBus());
-    // 获取免密登录状态
-    QDBusReply<QString> noPwdres;
-    noPwdres  = tmpSysinterface.call("getNoPwdLoginStatus");
-    if (!noPwdres.isValid()) {
-        qDebug() << noPwdres.error();
-    }
-    return (noPwdres.value().contains(mUserName) ? true : false);
+    return UserDirectory::readNoPwdLoginStatus(mUserName);
 }
 
 void UserInfo::initUserPropertyConnection(const QStringList &objPath) {
@@ -25,12 +25,14 @@
 
 #include <QSignalMapper>
 #include <QMouseEvent>
-#include <QSettings>
 
 #include "shell/interface.h"
 
 #include "qtdbus/systemdbusdispatcher.h"
 #include "qtdbus/userdispatcher.h"
+#include "userdirectory.h"
+#include "userlistmodel.h"
+#include "useritemdelegate.h"
 
 #include "changegroupdialog.h"
 #include "changepwddialog.h"
@@ -47,26 +49,6 @@ extern "C" {
 }
 #endif
 
-enum {
-    STANDARDUSER,
-    ADMINISTRATOR,
-    ROOT
-};
-
-typedef struct _UserInfomation {
-    QString objpath;
-    QString username;
-    QString iconfile;
-    QString passwd;
-    int accounttype;
-    int passwdtype;
-    bool current;
-    bool logined;
-    bool autologin;
-    bool noPwdLogin;
-    qint64 uid;
-}UserInfomation;
-
 typedef struct _PwdQualityOption {
 
     int diff_ok;
@@ -103,7 +85,7 @@ class SwitchButton;
 class UserInfo : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "userinfo.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -119,17 +101,16 @@ public:
 public:
     void initSearchText();
     void initComponent();
-    void initAllUserStatus();
 
     QStringList getLoginedUsers();
     void _acquireAllUsersInfo();
-    UserInfomation _acquireUserInfo(QString objpath);
+    void _addUserInfo(UserInfomation user);
+    void _refreshCurrentUserUI(const UserInfomation &user);
     QString _accountTypeIntToString(int type);
-    void _buildWidgetForItem(UserInfomation user);
+    void _openItemEditor(const QModelIndex &index);
+    void _closeItemEditor();
     void _resetListWidgetHeigh();
 
-    void _refreshUserInfoUI();
-
     void showCreateUserDialog();
     void createUser(QString username, QString pwd, QString pin, int atype);
     void createUserDone(QString objpath);
@@ -178,12 +159,16 @@ private:
     SwitchButton * autoLoginSwitchBtn;
 
     SystemDbusDispatcher * sysdispatcher;
-    QSettings * autoSettings = nullptr;
+    UserDirectory * mUserDirectory;
 
     QMap<QString, UserInfomation> allUserInfoMap;
-    QMap<QString, QListWidgetItem *> otherUserItemMap;
+    // 刷新过程中逐个到达的用户先写入临时表，刷新完成后整体替换
+    QMap<QString, UserInfomation> mPendingUserInfoMap;
 
-    QMap<QString, QListWidgetItem *> otherItemMap;
+    // 其他用户列表，仅悬停行创建操作控件
+    UserListModel * mUserModel;
+    UserItemDelegate * mUserDelegate;
+    QPersistentModelIndex mEditorIndex;
 
     QSignalMapper * pwdSignalMapper;
     QSignalMapper * faceSignalMapper;
@@ -204,6 +189,7 @@ private:
     QDBusInterface *mUserproperty;
 
     int adminnum;
+    int mPendingAdminnum;
     bool enablePwdQuality;
     bool mFirstLoad;
 
@@ -45,6 +45,9 @@ SOURCES += \
     elipsemaskwidget.cpp \
     run-passwd.cpp \
     userinfo.cpp \
+    userdirectory.cpp \
+    userlistmodel.cpp \
+    useritemdelegate.cpp \
     qtdbus/systemdbusdispatcher.cpp \
     changepwddialog.cpp \
     qtdbus/userdispatcher.cpp \
@@ -65,6 +68,9 @@ HEADERS += \
     loginedusers.h \
     run-passwd.h \
     userinfo.h \
+    userdirectory.h \
+    userlistmodel.h \
+    useritemdelegate.h \
     qtdbus/systemdbusdispatcher.h \
     changepwddialog.h \
     qtdbus/userdispatcher.h \
@@ -88,3 +94,6 @@ FORMS += \
     createuserdialog.ui
 
 INSTALLS += target
+
+DISTFILES += \
+    userinfo.json
@@ -0,0 +1,153 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "useritemdelegate.h"
+#include "userlistmodel.h"
+#include "userdirectory.h"
+
+#include <QCoreApplication>
+#include <QPainter>
+#include <QFrame>
+#include <QLabel>
+#include <QPushButton>
+#include <QHBoxLayout>
+
+#define ITEMHEIGH 52
+#define FACESIZE 32
+#define RIGHTSPACING 4
+
+UserItemDelegate::UserItemDelegate(QObject *parent) :
+    QStyledItemDelegate(parent),
+    mAdminCount(0)
+{
+}
+
+UserItemDelegate::~UserItemDelegate()
+{
+}
+
+void UserItemDelegate::setAdminCount(int count){
+    mAdminCount = count;
+}
+
+QSize UserItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const{
+    Q_UNUSED(index)
+    return QSize(option.rect.width(), ITEMHEIGH);
+}
+
+void UserItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const{
+    painter->save();
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+
+    // 与编辑器中的QFrame(Box)外观保持一致
+    QRect frameRect = option.rect.adjusted(0, 1, -RIGHTSPACING, -1);
+    painter->setPen(option.palette.color(QPalette::Mid));
+    painter->drawRect(frameRect.adjusted(0, 0, -1, -1));
+
+    QPixmap face = index.data(Qt::DecorationRole).value<QPixmap>();
+    QRect faceRect(frameRect.left() + 16, frameRect.center().y() - FACESIZE / 2 + 1, FACESIZE, FACESIZE);
+    if (!face.isNull())
+        painter->drawPixmap(faceRect, face);
+
+    QRect textRect(faceRect.right() + 1 + 16, frameRect.top(),
+                   frameRect.right() - faceRect.right() - 32, frameRect.height());
+    QString name = option.fontMetrics.elidedText(index.data(Qt::DisplayRole).toString(), Qt::ElideRight, textRect.width());
+    painter->setPen(option.palette.color(QPalette::WindowText));
+    painter->drawText(textRect, Qt::AlignLeft | Qt::AlignVCenter, name);
+
+    painter->restore();
+}
+
+QWidget * UserItemDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const{
+    Q_UNUSED(option)
+
+    QString username = index.data(Qt::DisplayRole).toString();
+    int accounttype = index.data(UserListModel::AccountTypeRole).toInt();
+
+    QWidget * baseWidget = new QWidget(parent);
+    baseWidget->setAutoFillBackground(true);
+
+    QHBoxLayout * baseHorLayout = new QHBoxLayout(baseWidget);
+    baseHorLayout->setSpacing(16);
+    baseHorLayout->setContentsMargins(0, 1, RIGHTSPACING, 1);
+
+    QFrame * widget = new QFrame(baseWidget);
+    widget->setFrameShape(QFrame::Shape::Box);
+    widget->setFixedHeight(50);
+
+    QHBoxLayout * mainHorLayout = new QHBoxLayout(widget);
+    mainHorLayout->setSpacing(16);
+    mainHorLayout->setContentsMargins(16, 0, 16, 0);
+
+    QPushButton * faceBtn = new QPushButton(widget);
+    faceBtn->setObjectName("faceBtn");
+    faceBtn->setFixedSize(FACESIZE, FACESIZE);
+    faceBtn->setIcon(QIcon(index.data(Qt::DecorationRole).value<QPixmap>()));
+    faceBtn->setIconSize(faceBtn->size());
+    connect(faceBtn, &QPushButton::clicked, this, [=]{
+        emit changeFaceClicked(username);
+    });
+
+    QLabel * nameLabel = new QLabel(widget);
+    nameLabel->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    nameLabel->setText(username);
+
+    QPushButton * typeBtn = new QPushButton(widget);
+    typeBtn->setFixedHeight(36);
+    typeBtn->setMinimumWidth(88);
+    typeBtn->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
+    typeBtn->setText(QCoreApplication::translate("UserInfo", "Change type"));
+    connect(typeBtn, &QPushButton::clicked, this, [=]{
+        emit changeTypeClicked(username);
+    });
+
+    QPushButton * pwdBtn = new QPushButton(widget);
+    pwdBtn->setFixedHeight(36);
+    pwdBtn->setMinimumWidth(88);
+    pwdBtn->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
+    pwdBtn->setText(QCoreApplication::translate("UserInfo", "Change pwd"));
+    connect(pwdBtn, &QPushButton::clicked, this, [=]{
+        emit changePwdClicked(username);
+    });
+
+    mainHorLayout->addWidget(faceBtn);
+    mainHorLayout->addWidget(nameLabel);
+    mainHorLayout->addStretch();
+    mainHorLayout->addWidget(typeBtn);
+    mainHorLayout->addWidget(pwdBtn);
+
+    QPushButton * delBtn = new QPushButton(baseWidget);
+    delBtn->setFixedSize(60, 36);
+    delBtn->setText(QCoreApplication::translate("UserInfo", "Delete"));
+    //不允许删除最后一个管理员
+    delBtn->setEnabled(!(accounttype > 0 && mAdminCount == 1));
+    connect(delBtn, &QPushButton::clicked, this, [=]{
+        emit deleteClicked(username);
+    });
+
+    baseHorLayout->addWidget(widget);
+    baseHorLayout->addWidget(delBtn, 0, Qt::AlignVCenter);
+
+    return baseWidget;
+}
+
+void UserItemDelegate::updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option, const QModelIndex &index) const{
+    Q_UNUSED(index)
+    editor->setGeometry(option.rect);
+}
@@ -0,0 +1,57 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef USERITEMDELEGATE_H
+#define USERITEMDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+/**
+ * \brief UserItemDelegate
+ * 绘制其他用户列表行；操作按钮只为悬停行创建(作为持久编辑器)，
+ * 因此控件数量与用户数量无关
+ */
+class UserItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit UserItemDelegate(QObject *parent = 0);
+    ~UserItemDelegate();
+
+public:
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const Q_DECL_OVERRIDE;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const Q_DECL_OVERRIDE;
+
+    QWidget * createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const Q_DECL_OVERRIDE;
+    void updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option, const QModelIndex &index) const Q_DECL_OVERRIDE;
+
+    void setAdminCount(int count);
+
+private:
+    int mAdminCount;
+
+Q_SIGNALS:
+    void changeFaceClicked(QString username) const;
+    void changeTypeClicked(QString username) const;
+    void changePwdClicked(QString username) const;
+    void deleteClicked(QString username) const;
+};
+
+#endif // USERITEMDELEGATE_H
@@ -0,0 +1,94 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "userlistmodel.h"
+
+#include <algorithm>
+
+UserListModel::UserListModel(QObject *parent) :
+    QAbstractListModel(parent),
+    mFaceSize(32, 32)
+{
+}
+
+UserListModel::~UserListModel()
+{
+}
+
+int UserListModel::rowCount(const QModelIndex &parent) const{
+    if (parent.isValid())
+        return 0;
+    return mUsers.count();
+}
+
+QVariant UserListModel::data(const QModelIndex &index, int role) const{
+    if (!index.isValid() || index.row() >= mUsers.count())
+        return QVariant();
+
+    const UserInfomation &user = mUsers.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return user.username;
+    case Qt::DecorationRole: {
+        // 只在行被绘制时才加载头像
+        if (!mFaceCache.contains(user.iconfile)) {
+            QPixmap face(user.iconfile);
+            if (!face.isNull())
+                face = face.scaled(mFaceSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+            mFaceCache.insert(user.iconfile, face);
+        }
+        return mFaceCache.value(user.iconfile);
+    }
+    case ObjectPathRole:
+        return user.objpath;
+    case AccountTypeRole:
+        return user.accounttype;
+    default:
+        break;
+    }
+    return QVariant();
+}
+
+void UserListModel::clear(){
+    beginResetModel();
+    mUsers.clear();
+    mFaceCache.clear();
+    endResetModel();
+}
+
+void UserListModel::addUser(const UserInfomation &user){
+    auto it = std::lower_bound(mUsers.begin(), mUsers.end(), user,
+                               [](const UserInfomation &a, const UserInfomation &b){
+        return a.username < b.username;
+    });
+    int row = it - mUsers.begin();
+
+    beginInsertRows(QModelIndex(), row, row);
+    mUsers.insert(row, user);
+    endInsertRows();
+}
+
+UserInfomation UserListModel::user(int row) const{
+    return mUsers.value(row);
+}
+
+void UserListModel::setFaceSize(const QSize &size){
+    mFaceSize = size;
+    mFaceCache.clear();
+}
@@ -0,0 +1,63 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef USERLISTMODEL_H
+#define USERLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QPixmap>
+#include <QHash>
+
+#include "userdirectory.h"
+
+/**
+ * \brief UserListModel
+ * 其他用户列表数据，按用户名排序；头像按需加载并缓存缩放后的结果
+ */
+class UserListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum UserRoles {
+        ObjectPathRole = Qt::UserRole,
+        AccountTypeRole,
+    };
+
+    explicit UserListModel(QObject *parent = 0);
+    ~UserListModel();
+
+public:
+    int rowCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
+
+    void clear();
+    void addUser(const UserInfomation &user);
+    UserInfomation user(int row) const;
+
+    void setFaceSize(const QSize &size);
+
+private:
+    QList<UserInfomation> mUsers;
+    QSize mFaceSize;
+
+    mutable QHash<QString, QPixmap> mFaceCache;
+};
+
+#endif // USERLISTMODEL_H
@@ -35,7 +35,7 @@ class Audio;
 class Audio : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "audio.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -58,3 +58,6 @@ FORMS += \
     audio.ui
 
 INSTALLS += target
+
+DISTFILES += \
+    audio.json
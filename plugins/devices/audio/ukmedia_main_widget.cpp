@@ -37,6 +37,7 @@
 #define GVC_SOUND_NAME     (xmlChar *) "name"
 #define GVC_SOUND_FILENAME (xmlChar *) "filename"
 #define SOUND_SET_DIR "/usr/share/ukui-media/sounds"
+#define VOLUME_NOTIFY_INTERVAL 16 //音量通知合并间隔(ms)，约一帧
 
 #define KEYBINDINGS_CUSTOM_SCHEMA "org.ukui.media.sound"
 #define KEYBINDINGS_CUSTOM_DIR "/org/ukui/sound/keybindings/"
@@ -218,6 +219,11 @@ UkmediaMainWidget::UkmediaMainWidget(QWidget *parent)
     connect(m_pOutputWidget->m_pOpVolumeSlider,SIGNAL(valueChanged(int)),this,SLOT(outputWidgetSliderChangedSlot(int)));
     //输入滑动条音量控制
     connect(m_pInputWidget->m_pIpVolumeSlider,SIGNAL(valueChanged(int)),this,SLOT(inputWidgetSliderChangedSlot(int)));
+    //拖动滑动条或插拔耳机时 pulseaudio 会连续发出音量通知，合并后每帧只刷新一次
+    m_pVolumeNotifyTimer = new QTimer(this);
+    m_pVolumeNotifyTimer->setSingleShot(true);
+    m_pVolumeNotifyTimer->setInterval(VOLUME_NOTIFY_INTERVAL);
+    connect(m_pVolumeNotifyTimer,SIGNAL(timeout()),this,SLOT(streamControlVolumeFlushSlot()));
 
     //点击报警音量时播放报警声音
     connect(m_pSoundWidget->m_pAlertSlider,SIGNAL(valueChanged(int)),this,SLOT(alertVolumeSliderChangedSlot(int)));
@@ -468,6 +474,9 @@ void UkmediaMainWidget::ukuiThemeChangedSlot(const QString &themeStr)
     int nOutputValue = getOutputVolume();
     bool inputStatus = getInputMuteStatus();
     bool outputStatus = getOutputMuteStatus();
+    //主题颜色改变，图标需要重新加载
+    m_inputIconLevel = -1;
+    m_outputIconLevel = -1;
     inputVolumeDarkThemeImage(nInputValue,inputStatus);
     outputVolumeDarkThemeImage(nOutputValue,outputStatus);
     m_pOutputWidget->m_pOutputIconBtn->repaint();
@@ -1209,12 +1218,31 @@ bool UkmediaMainWidget::getOutputMuteStatus()
     return mate_mixer_stream_control_get_mute(pControl);
 }
 
+/*
+    音量图标档位：0 静音，1 低，2 中，3 高
+*/
+static int volumeIconLevel(int value,bool status)
+{
+    if (status || value <= 0)
+        return 0;
+    else if (value <= 33)
+        return 1;
+    else if (value <= 66)
+        return 2;
+    return 3;
+}
+
 /*
     深色主题时输出音量图标
 */
-void UkmediaMainWidget::outputVolumeDarkThemeImage(int value,bool status)
+bool UkmediaMainWidget::outputVolumeDarkThemeImage(int value,bool status)
 {
-    QImage image;
+    //音量仍在同一档位时图标不变，不再重复加载 svg
+    int level = volumeIconLevel(value,status);
+    if (level == m_outputIconLevel)
+        return false;
+    m_outputIconLevel = level;
+
     QColor color = QColor(0,0,0,216);
     if (mThemeName == UKUI_THEME_WHITE) {
         color = QColor(0,0,0,216);
@@ -1223,35 +1251,34 @@ void UkmediaMainWidget::outputVolumeDarkThemeImage(int value,bool status)
         color = QColor(255,255,255,216);
     }
     m_pOutputWidget->m_pOutputIconBtn->mColor = color;
-    if (status) {
-        image  = QImage("/usr/share/ukui-media/img/audio-volume-muted.svg");
-        m_pOutputWidget->m_pOutputIconBtn->mImage = image;
+    switch (level) {
+    case 0:
+        m_pOutputWidget->m_pOutputIconBtn->mImage = QImage("/usr/share/ukui-media/img/audio-volume-muted.svg");
+        break;
+    case 1:
+        m_pOutputWidget->m_pOutputIconBtn->mImage = QImage("/usr/share/ukui-media/img/audio-volume-low.svg");
+        break;
+    case 2:
+        m_pOutputWidget->m_pOutputIconBtn->mImage = QImage("/usr/share/ukui-media/img/audio-volume-medium.svg");
+        break;
+    default:
+        m_pOutputWidget->m_pOutputIconBtn->mImage = QImage("/usr/share/ukui-media/img/audio-volume-high.svg");
+        break;
     }
-    else if (value <= 0) {
-        image  = QImage("/usr/share/ukui-media/img/audio-volume-muted.svg");
-        m_pOutputWidget->m_pOutputIconBtn->mImage = image;
-    }
-    else if (value > 0 && value <= 33) {
-        image = QImage("/usr/share/ukui-media/img/audio-volume-low.svg");
-        m_pOutputWidget->m_pOutputIconBtn->mImage = image;
-    }
-    else if (value >33 && value <= 66) {
-        image = QImage("/usr/share/ukui-media/img/audio-volume-medium.svg");
-        m_pOutputWidget->m_pOutputIconBtn->mImage = image;
-    }
-    else {
-        image = QImage("/usr/share/ukui-media/img/audio-volume-high.svg");
-        m_pOutputWidget->m_pOutputIconBtn->mImage = image;
-    }
-
+    return true;
 }
 
 /*
     输入音量图标
 */
-void UkmediaMainWidget::inputVolumeDarkThemeImage(int value,bool status)
+bool UkmediaMainWidget::inputVolumeDarkThemeImage(int value,bool status)
 {
-    QImage image;
+    //音量仍在同一档位时图标不变，不再重复加载 svg
+    int level = volumeIconLevel(value,status);
+    if (level == m_inputIconLevel)
+        return false;
+    m_inputIconLevel = level;
+
     QColor color = QColor(0,0,0,190);
     if (mThemeName == UKUI_THEME_WHITE) {
         color = QColor(0,0,0,190);
@@ -1260,26 +1287,21 @@ void UkmediaMainWidget::inputVolumeDarkThemeImage(int value,bool status)
         color = QColor(255,255,255,190);
     }
     m_pInputWidget->m_pInputIconBtn->mColor = color;
-    if (status) {
-        image  = QImage("/usr/share/ukui-media/img/microphone-mute.svg");
-        m_pInputWidget->m_pInputIconBtn->mImage = image;
-    }
-    else if (value <= 0) {
-        image  = QImage("/usr/share/ukui-media/img/microphone-mute.svg");
-        m_pInputWidget->m_pInputIconBtn->mImage = image;
-    }
-    else if (value > 0 && value <= 33) {
-        image = QImage("/usr/share/ukui-media/img/microphone-low.svg");
-        m_pInputWidget->m_pInputIconBtn->mImage = image;
-    }
-    else if (value >33 && value <= 66) {
-        image = QImage("/usr/share/ukui-media/img/microphone-medium.svg");
-        m_pInputWidget->m_pInputIconBtn->mImage = image;
-    }
-    else {
-        image = QImage("/usr/share/ukui-media/img/microphone-high.svg");
-        m_pInputWidget->m_pInputIconBtn->mImage = image;
+    switch (level) {
+    case 0:
+        m_pInputWidget->m_pInputIconBtn->mImage = QImage("/usr/share/ukui-media/img/microphone-mute.svg");
+        break;
+    case 1:
+        m_pInputWidget->m_pInputIconBtn->mImage = QImage("/usr/share/ukui-media/img/microphone-low.svg");
+        break;
+    case 2:
+        m_pInputWidget->m_pInputIconBtn->mImage = QImage("/usr/share/ukui-media/img/microphone-medium.svg");
+        break;
+    default:
+        m_pInputWidget->m_pInputIconBtn->mImage = QImage("/usr/share/ukui-media/img/microphone-high.svg");
+        break;
     }
+    return true;
 }
 
 /*
@@ -1312,8 +1334,8 @@ void UkmediaMainWidget::updateIconInput (UkmediaMainWidget *m_pWidget)
     const QSize icon_size = QSize(24,24);
     m_pWidget->m_pInputWidget->m_pInputIconBtn->setIconSize(icon_size);
     //修改图标为深色主题图标
-    m_pWidget->inputVolumeDarkThemeImage(value,status);
-    m_pWidget->m_pInputWidget->m_pInputIconBtn->repaint();
+    if (m_pWidget->inputVolumeDarkThemeImage(value,status))
+        m_pWidget->m_pInputWidget->m_pInputIconBtn->repaint();
     while (m_pInputs != nullptr) {
         MateMixerStreamControl *input = MATE_MIXER_STREAM_CONTROL (m_pInputs->data);
         MateMixerStreamControlRole role = mate_mixer_stream_control_get_role (input);
@@ -1409,8 +1431,8 @@ void UkmediaMainWidget::updateIconOutput(UkmediaMainWidget *m_pWidget)
 
     const QSize icon_size = QSize(24,24);
     m_pWidget->m_pOutputWidget->m_pOutputIconBtn->setIconSize(icon_size);
-    m_pWidget->outputVolumeDarkThemeImage(value,status);
-    m_pWidget->m_pOutputWidget->m_pOutputIconBtn->repaint();
+    if (m_pWidget->outputVolumeDarkThemeImage(value,status))
+        m_pWidget->m_pOutputWidget->m_pOutputIconBtn->repaint();
 
     gdouble balance_value = mate_mixer_stream_control_get_balance(m_pControl);
     m_pWidget->m_pOutputWidget->m_pOpBalanceSlider->setValue(balance_value*100);
@@ -1479,12 +1501,12 @@ void UkmediaMainWidget::onControlMuteNotify (MateMixerStreamControl *m_pControl,
     MateMixerDirection direction = mate_mixer_stream_get_direction(stream);
 
     if (direction == MATE_MIXER_DIRECTION_OUTPUT) {
-        m_pWidget->outputVolumeDarkThemeImage(volume,mute);
-        m_pWidget->m_pOutputWidget->m_pOutputIconBtn->repaint();
+        if (m_pWidget->outputVolumeDarkThemeImage(volume,mute))
+            m_pWidget->m_pOutputWidget->m_pOutputIconBtn->repaint();
     }
     else if (direction == MATE_MIXER_DIRECTION_INPUT) {
-        m_pWidget->inputVolumeDarkThemeImage(volume,mute);
-        m_pWidget->m_pInputWidget->m_pInputIconBtn->repaint();
+        if (m_pWidget->inputVolumeDarkThemeImage(volume,mute))
+            m_pWidget->m_pInputWidget->m_pInputIconBtn->repaint();
     }
 
 }
@@ -1496,6 +1518,31 @@ void UkmediaMainWidget::onStreamControlVolumeNotify (MateMixerStreamControl *m_p
 {
     Q_UNUSED(pspec);
     g_debug("on stream control volume notify");
+    //只记录发生变化的 control，界面在定时器到期后统一按最新状态刷新
+    if (m_pControl == nullptr || m_pWidget->m_pendingVolumeControls.contains(m_pControl))
+        return;
+    g_object_ref(m_pControl);
+    m_pWidget->m_pendingVolumeControls.append(m_pControl);
+    if (!m_pWidget->m_pVolumeNotifyTimer->isActive())
+        m_pWidget->m_pVolumeNotifyTimer->start();
+}
+
+/*
+    合并后的音量通知，按 control 当前状态刷新一次界面
+*/
+void UkmediaMainWidget::streamControlVolumeFlushSlot()
+{
+    QList<MateMixerStreamControl *> controls = m_pendingVolumeControls;
+    m_pendingVolumeControls.clear();
+    for (MateMixerStreamControl *control : controls) {
+        applyStreamControlVolume(control);
+        g_object_unref(control);
+    }
+}
+
+void UkmediaMainWidget::applyStreamControlVolume(MateMixerStreamControl *m_pControl)
+{
+    UkmediaMainWidget *m_pWidget = this;
     qDebug() << "volume notify" << mate_mixer_stream_control_get_name(m_pControl);
     MateMixerStreamControlFlags flags;
     guint volume = 0;
@@ -1524,26 +1571,29 @@ void UkmediaMainWidget::onStreamControlVolumeNotify (MateMixerStreamControl *m_p
             if (portSwitch != nullptr) {
                 const GList *options;
                 options = mate_mixer_switch_list_options(MATE_MIXER_SWITCH(portSwitch));
-                if (options != nullptr) {
-                    //拔插耳机时设置输出端口名
-                    m_pWidget->m_pOutputPortList->clear();
-                    m_pWidget->m_pOutputWidget->m_pOutputPortCombobox->clear();
-                }
                 MateMixerSwitchOption *option = mate_mixer_switch_get_active_option(MATE_MIXER_SWITCH(portSwitch));
                 const gchar *outputPortLabel = mate_mixer_switch_option_get_label(option);
+                QStringList portNames;
+                QStringList portLabels;
                 while (options != nullptr) {
                     MateMixerSwitchOption *opt = MATE_MIXER_SWITCH_OPTION(options->data);
                     QString label = mate_mixer_switch_option_get_label(opt);
                     QString name = mate_mixer_switch_option_get_name(opt);
-                    if (!m_pWidget->m_pOutputPortList->contains(name)) {
-                        m_pWidget->m_pOutputPortList->append(name);
-                        m_pWidget->m_pOutputWidget->m_pOutputPortCombobox->addItem(label);
+                    if (!portNames.contains(name)) {
+                        portNames.append(name);
+                        portLabels.append(label);
                     }
                     options = options->next;
                 }
-//                m_pWidget->m_pOutputWidget->m_pOutputPortCombobox->blockSignals(true);
-                m_pWidget->m_pOutputWidget->m_pOutputPortCombobox->setCurrentText(outputPortLabel);
-//                m_pWidget->m_pOutputWidget->m_pOutputPortCombobox->blockSignals(false);
+                //拔插耳机时端口列表才会变化，列表相同时不重建下拉框
+                QComboBox *portCombobox = m_pWidget->m_pOutputWidget->m_pOutputPortCombobox;
+                if (!portNames.isEmpty() && portNames != *m_pWidget->m_pOutputPortList) {
+                    *m_pWidget->m_pOutputPortList = portNames;
+                    portCombobox->clear();
+                    portCombobox->addItems(portLabels);
+                }
+                if (portCombobox->currentText() != outputPortLabel)
+                    portCombobox->setCurrentText(outputPortLabel);
             }
         }
     }
@@ -1574,12 +1624,14 @@ void UkmediaMainWidget::onStreamControlVolumeNotify (MateMixerStreamControl *m_p
     int value = volume*100/65536.0 + 0.5;
     if (direction == MATE_MIXER_DIRECTION_OUTPUT) {
 //        m_pWidget->m_pOutputWidget->m_pOpVolumeSlider->blockSignals(true);
-        m_pWidget->m_pOutputWidget->m_pOpVolumeSlider->setValue(value);
+        if (m_pWidget->m_pOutputWidget->m_pOpVolumeSlider->value() != value)
+            m_pWidget->m_pOutputWidget->m_pOpVolumeSlider->setValue(value);
 //        m_pWidget->m_pOutputWidget->m_pOpVolumeSlider->blockSignals(true);
     }
     else if (direction == MATE_MIXER_DIRECTION_INPUT) {
 //        m_pWidget->m_pInputWidget->m_pIpVolumeSlider->blockSignals(true);
-        m_pWidget->m_pInputWidget->m_pIpVolumeSlider->setValue(value);
+        if (m_pWidget->m_pInputWidget->m_pIpVolumeSlider->value() != value)
+            m_pWidget->m_pInputWidget->m_pIpVolumeSlider->setValue(value);
 //        m_pWidget->m_pInputWidget->m_pIpVolumeSlider->blockSignals(true);
     }
 }
@@ -2705,10 +2757,10 @@ void UkmediaMainWidget::outputWidgetSliderChangedSlot(int value)
         }
     }
     firstEnterSystem = false;
-    outputVolumeDarkThemeImage(value,status);
     percent.append("%");
     m_pOutputWidget->m_pOpVolumePercentLabel->setText(percent);
-    m_pOutputWidget->m_pOutputIconBtn->repaint();
+    if (outputVolumeDarkThemeImage(value,status))
+        m_pOutputWidget->m_pOutputIconBtn->repaint();
 
 }
 
@@ -2730,8 +2782,8 @@ void UkmediaMainWidget::inputWidgetSliderChangedSlot(int value)
     }
     //输入图标修改成深色主题
 
-    inputVolumeDarkThemeImage(value,status);
-    m_pInputWidget->m_pInputIconBtn->repaint();
+    if (inputVolumeDarkThemeImage(value,status))
+        m_pInputWidget->m_pInputIconBtn->repaint();
     percent = QString::number(value);
     value = value * 65536 / 100;
     mate_mixer_stream_control_set_mute(m_pControl,status);
@@ -3770,4 +3822,6 @@ void UkmediaMainWidget::updateRole(const pa_ext_stream_restore_info &info)
 UkmediaMainWidget::~UkmediaMainWidget()
 {
 //    delete player;
+    for (MateMixerStreamControl *control : m_pendingVolumeControls)
+        g_object_unref(control);
 }
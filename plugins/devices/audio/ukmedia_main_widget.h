@@ -51,6 +51,7 @@ extern "C" {
 #include <QDomDocument>
 #include <QGSettings>
 #include <QAudioInput>
+#include <QTimer>
 
 #define UKUI_THEME_SETTING "org.ukui.style"
 #define UKUI_THEME_NAME "style-name"
@@ -111,8 +112,8 @@ public:
     void updateProfileOption();
     void alertIconButtonSetIcon(bool state,int value);
     void createAlertSound(UkmediaMainWidget *w);
-    void inputVolumeDarkThemeImage(int value,bool status);
-    void outputVolumeDarkThemeImage(int value,bool status);
+    bool inputVolumeDarkThemeImage(int value,bool status);
+    bool outputVolumeDarkThemeImage(int value,bool status);
     int getInputVolume();
     int getOutputVolume();
     bool getInputMuteStatus();
@@ -152,6 +153,7 @@ public:
     static void updateIconInput (UkmediaMainWidget *w);
     static void updateIconOutput (UkmediaMainWidget *w);
     static void onStreamControlVolumeNotify (MateMixerStreamControl *control,GParamSpec *pspec,UkmediaMainWidget *w);
+    void applyStreamControlVolume(MateMixerStreamControl *control);
     static void onControlMuteNotify (MateMixerStreamControl *control,GParamSpec *pspec,UkmediaMainWidget *w);
     //平衡
     static void ukuiBalanceBarSetProperty (UkmediaMainWidget *w,MateMixerStreamControl *control);
@@ -249,6 +251,7 @@ private Q_SLOTS:
     void outputMuteButtonSlot();
     void alertVolumeSliderChangedSlot(int value);
     void alertSoundVolumeChangedSlot();
+    void streamControlVolumeFlushSlot();
 private:
     UkmediaInputWidget *m_pInputWidget;
     UkmediaOutputWidget *m_pOutputWidget;
@@ -298,6 +301,13 @@ private:
     bool m_hasMusic;
     bool firstEnterSystem = true;
 
+    //合并音量通知，每帧最多刷新一次界面
+    QTimer *m_pVolumeNotifyTimer;
+    QList<MateMixerStreamControl *> m_pendingVolumeControls;
+    //当前图标对应的音量档位，-1 表示需要重新加载
+    int m_outputIconLevel = -1;
+    int m_inputIconLevel = -1;
+
     QByteArray role;
     QByteArray device;
     pa_channel_map channelMap;
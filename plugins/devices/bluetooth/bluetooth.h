@@ -10,7 +10,7 @@
 class Bluetooth : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "bluetooth.json")
     Q_INTERFACES(CommonInterface)
 public:
     Bluetooth();
@@ -53,3 +53,6 @@ INSTALLS += target
 
 FORMS +=
 
+
+DISTFILES += \
+    bluetooth.json
@@ -79,3 +79,6 @@ FORMS += \
     layoutmanager.ui
 
 INSTALLS += target
+
+DISTFILES += \
+    keyboard.json
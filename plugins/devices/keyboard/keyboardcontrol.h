@@ -40,7 +40,7 @@ class QGSettings;
 class KeyboardControl : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "keyboard.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -44,3 +44,6 @@ FORMS += \
         mousecontrol.ui
 
 INSTALLS += target
+
+DISTFILES += \
+    mouse.json
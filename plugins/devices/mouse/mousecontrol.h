@@ -53,7 +53,7 @@ protected:
 class MouseControl : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "mouse.json")
     Q_INTERFACES(CommonInterface)
 
 public:
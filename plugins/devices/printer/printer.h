@@ -37,7 +37,7 @@ class Printer;
 class Printer : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "printer.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -34,3 +34,6 @@ FORMS += \
         printer.ui
 
 INSTALLS += target
+
+DISTFILES += \
+    printer.json
@@ -60,7 +60,7 @@ Q_DECLARE_METATYPE(KeyEntry *)
 class Shortcut : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "shortcut.json")
     Q_INTERFACES(CommonInterface)
 
 public:
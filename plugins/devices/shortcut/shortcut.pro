@@ -53,3 +53,6 @@ FORMS += \
     shortcut.ui
 
 INSTALLS += target
+
+DISTFILES += \
+    shortcut.json
@@ -41,7 +41,7 @@ class Touchpad;
 class Touchpad : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "touchpad.json")
     Q_INTERFACES(CommonInterface)
 
 public:
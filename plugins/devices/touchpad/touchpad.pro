@@ -46,3 +46,6 @@ FORMS += \
         touchpad.ui
 
 INSTALLS += target
+
+DISTFILES += \
+    touchpad.json
@@ -40,7 +40,7 @@ class About;
 class About : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "about.json")
     Q_INTERFACES(CommonInterface)
 
 public:
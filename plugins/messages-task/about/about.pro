@@ -26,4 +26,7 @@ FORMS += \
 RESOURCES += \
     res/img.qrc
 
-INSTALLS += target
\ No newline at end of file
+INSTALLS += target
+
+DISTFILES += \
+    about.json
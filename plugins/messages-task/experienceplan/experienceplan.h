@@ -35,7 +35,7 @@ QT_END_NAMESPACE
 class ExperiencePlan : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "experienceplan.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -38,3 +38,6 @@ FORMS += \
     experienceplan.ui
 
 INSTALLS += target
+
+DISTFILES += \
+    experienceplan.json
@@ -21,6 +21,7 @@
 #include "ui_notice.h"
 #include "appdetail.h"
 #include "realizenotice.h"
+#include "noticeregistry.h"
 #include "commonComponent/HoverWidget/hoverwidget.h"
 
 #define NOTICE_SCHEMA         "org.ukui.control-center.notice"
@@ -28,9 +29,7 @@
 #define ENABLE_NOTICE_KEY     "enable-notice"
 #define SHOWON_LOCKSCREEN_KEY "show-on-lockscreen"
 
-#define DESKTOPPATH           "/usr/share/applications/"
-
-Notice::Notice() : mFirstLoad(true)
+Notice::Notice() : mRegistry(nullptr), mFirstLoad(true)
 {
     pluginName = tr("Notice");
     pluginType = NOTICEANDTASKS;
@@ -40,8 +39,6 @@ Notice::~Notice()
 {
     if (!mFirstLoad) {
         delete ui;
-        qDeleteAll(vecGsettins);
-        vecGsettins.clear();
     }
 }
 
@@ -140,12 +137,12 @@ void Notice::initNoticeStatus() {
 }
 
 void Notice::initOriNoticeStatus() {
-    initGSettings();
+    mRegistry = new NoticeRegistry(this);
+    mRegistry->load();
 
     for (int i = 0; i < appsName.length(); i++) {
-        QByteArray ba = QString(DESKTOPPATH + appsName.at(i) + ".desktop").toUtf8();
-        GDesktopAppInfo * audioinfo = g_desktop_app_info_new_from_filename(ba.constData());
-        QString appname = g_app_info_get_name(G_APP_INFO(audioinfo));
+        NoticeAppInfo appInfo = NoticeRegistry::appInfo(appsName.at(i));
+        QString appname = appInfo.name;
 
         // 构建Widget
         QFrame * baseWidget = new QFrame();
@@ -176,11 +173,11 @@ void Notice::initOriNoticeStatus() {
         iconSizePolicy.setVerticalPolicy(QSizePolicy::Fixed);
         iconBtn->setIconSize(QSize(32,32));
         iconBtn->setSizePolicy(iconSizePolicy);
-        QString iconame = appsName.at(i);
         if ("ukui-power-statistics" == appsName.at(i)) {
-            iconame = "cs-power";
+            iconBtn->setIcon(QIcon::fromTheme("cs-power"));
+        } else {
+            iconBtn->setIcon(appInfo.icon);
         }
-        iconBtn->setIcon(QIcon::fromTheme(iconame));
 
         QLabel * nameLabel = new QLabel(pluginWidget);
         QSizePolicy nameSizePolicy = nameLabel->sizePolicy();
@@ -211,27 +208,10 @@ void Notice::initOriNoticeStatus() {
 
         ui->applistWidget->setItemWidget(item, baseWidget);
 
-        QList<char *> listChar =  listExistsCustomNoticePath();
-
-        const QByteArray id(NOTICE_ORIGIN_SCHEMA);
-        QGSettings * settings = nullptr;
-        QString path;
-
-        for (int j = 0; j < listChar.length(); j++) {
-            path = QString("%1%2").arg(NOTICE_ORIGIN_PATH).arg(QString(listChar.at(j)));
-            settings = new QGSettings(id, path.toLatin1().data(), this);
-            vecGsettins.append(settings);
-            QStringList keys = settings->keys();
-
-            if (keys.contains(static_cast<QString>(NAME_KEY))) {
-                QString appName = settings->get(NAME_KEY).toString();
-                if ( appsKey.at(i) == appName) {
-                    bool isCheck = settings->get(MESSAGES_KEY).toBool();
-                    appSwitch->setChecked(isCheck);
-                    break;
-                }
-            }
-            settings = nullptr;
+        // 不存在时在空闲路径下创建，默认允许通知
+        QGSettings * settings = mRegistry->ensureSettings(appsKey.at(i));
+        if (settings) {
+            appSwitch->setChecked(settings->get(MESSAGES_KEY).toBool());
         }
 
         connect(devWidget, &HoverWidget::enterWidget, this, [=](QString name) {
@@ -250,12 +230,14 @@ void Notice::initOriNoticeStatus() {
             app->exec();
         });
 
-        connect(settings, &QGSettings::changed, [=](QString key) {
-            if (static_cast<QString>(MESSAGES_KEY) == key) {
-                bool judge = settings->get(MESSAGES_KEY).toBool();
-                appSwitch->setChecked(judge);
-            }
-        });
+        if (settings) {
+            connect(settings, &QGSettings::changed, [=](QString key) {
+                if (static_cast<QString>(MESSAGES_KEY) == key) {
+                    bool judge = settings->get(MESSAGES_KEY).toBool();
+                    appSwitch->setChecked(judge);
+                }
+            });
+        }
 
         connect(enableSwitchBtn, &SwitchButton::checkedChanged, [=](bool checked) {
             setHiddenNoticeApp(checked);
@@ -263,50 +245,15 @@ void Notice::initOriNoticeStatus() {
         });
 
         connect(appSwitch, &SwitchButton::checkedChanged, [=](bool checked) {
-            settings->set(MESSAGES_KEY, checked);
+            if (settings) {
+                settings->set(MESSAGES_KEY, checked);
+            }
         });
     }
     setHiddenNoticeApp(enableSwitchBtn->isChecked());
 }
 
 
-void Notice::initGSettings() {
-    for (int i = 0; i < appsName.length(); i++) {
-        QList<char *> listChar =  listExistsCustomNoticePath();
-
-        const QByteArray id(NOTICE_ORIGIN_SCHEMA);
-        QGSettings * settings = nullptr;
-        QGSettings * newSettings = nullptr;
-        QString path;
-        bool isExist = false;
-
-        for (int j = 0; j < listChar.length(); j++) {
-            path = QString("%1%2").arg(NOTICE_ORIGIN_PATH).arg(QString(listChar.at(j)));
-            settings = new QGSettings(id, path.toLatin1().data());
-            QStringList keys = settings->keys();
-
-            if (keys.contains(static_cast<QString>(NAME_KEY))) {
-                QString appName = settings->get(NAME_KEY).toString();
-                if (appsKey.at(i) == appName) {
-                    isExist = true;
-                }
-            }
-            delete settings;
-        }
-        if (!isExist) {
-            path = findFreePath();
-            newSettings = new QGSettings(id, path.toLatin1().data());
-            QStringList keys = newSettings->keys();
-            if (keys.contains(static_cast<QString>(NAME_KEY)) &&
-                    keys.contains(static_cast<QString>(MESSAGES_KEY))) {
-                newSettings->set(NAME_KEY, appsKey.at(i));
-                newSettings->set(MESSAGES_KEY, true);
-            }
-            delete newSettings;
-        }
-    }
-}
-
 void Notice::changeAppstatus(bool checked, QString name, SwitchButton *appBtn) {
 
     // 记录应用之前状态
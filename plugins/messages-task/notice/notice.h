@@ -45,10 +45,12 @@ QT_BEGIN_NAMESPACE
 namespace Ui { class Notice; }
 QT_END_NAMESPACE
 
+class NoticeRegistry;
+
 class Notice : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "notice.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -66,7 +68,6 @@ public:
     void setupGSettings();
     void initNoticeStatus();
     void initOriNoticeStatus();
-    void initGSettings();
 
 private:
     void changeAppstatus(bool checked, QString name,SwitchButton *appBtn);
@@ -88,7 +89,7 @@ private:
     QGSettings * oriSettings;
     QStringList appsName;
     QStringList appsKey;
-    QVector<QGSettings*> vecGsettins;
+    NoticeRegistry * mRegistry;
 
     bool mFirstLoad;
 };
@@ -5,6 +5,7 @@ include(../../../env.pri)
 include($$PROJECT_COMPONENTSOURCE/hoverwidget.pri)
 include($$PROJECT_COMPONENTSOURCE/switchbutton.pri)
 include($$PROJECT_COMPONENTSOURCE/closebutton.pri)
+include($$PROJECT_COMPONENTSOURCE/desktopentryindex.pri)
 
 TEMPLATE = lib
 CONFIG += plugin
@@ -40,11 +41,13 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES += \
     appdetail.cpp \
     notice.cpp \
+    noticeregistry.cpp \
     realizenotice.cpp
 
 HEADERS += \
     appdetail.h \
     notice.h \
+    noticeregistry.h \
     realizenotice.h
 
 FORMS += \
@@ -52,3 +55,6 @@ FORMS += \
     notice.ui
 
 INSTALLS += target
+
+DISTFILES += \
+    notice.json
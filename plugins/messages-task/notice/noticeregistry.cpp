@@ -0,0 +1,106 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "noticeregistry.h"
+#include "realizenotice.h"
+#include "DesktopEntryIndex/desktopentryindex.h"
+
+#include <QDebug>
+
+NoticeRegistry::NoticeRegistry(QObject *parent) :
+    QObject(parent)
+{
+}
+
+void NoticeRegistry::load()
+{
+    qDeleteAll(mSettings);
+    mSettings.clear();
+
+    mPaths = listExistsCustomNoticePath();
+    for (const QString &dir : mPaths) {
+        QGSettings *settings = createSettings(QString("%1%2").arg(NOTICE_ORIGIN_PATH).arg(dir));
+        if (!settings->keys().contains(static_cast<QString>(NAME_KEY))) {
+            delete settings;
+            continue;
+        }
+
+        QString appName = settings->get(NAME_KEY).toString();
+        if (mSettings.contains(appName)) {
+            // 同名的重复路径只保留第一个
+            delete settings;
+            continue;
+        }
+        mSettings.insert(appName, settings);
+    }
+}
+
+QGSettings *NoticeRegistry::settings(const QString &appKey) const
+{
+    return mSettings.value(appKey, nullptr);
+}
+
+QGSettings *NoticeRegistry::ensureSettings(const QString &appKey)
+{
+    QGSettings *settings = mSettings.value(appKey, nullptr);
+    if (settings) {
+        return settings;
+    }
+
+    QString path = findFreePath(mPaths);
+    if (path.isEmpty()) {
+        qWarning() << "no free notice origin path for" << appKey;
+        return nullptr;
+    }
+
+    settings = createSettings(path);
+    QStringList keys = settings->keys();
+    if (keys.contains(static_cast<QString>(NAME_KEY)) &&
+            keys.contains(static_cast<QString>(MESSAGES_KEY))) {
+        settings->set(NAME_KEY, appKey);
+        settings->set(MESSAGES_KEY, true);
+    }
+
+    mPaths.append(path.mid(QString(NOTICE_ORIGIN_PATH).length()));
+    mSettings.insert(appKey, settings);
+    return settings;
+}
+
+NoticeAppInfo NoticeRegistry::appInfo(const QString &desktopId)
+{
+    NoticeAppInfo info;
+    info.name = desktopId;
+
+    DesktopEntry entry = DesktopEntryIndex::instance()->application(desktopId);
+    if (entry.isValid()) {
+        info.name = entry.name;
+        info.icon = QIcon::fromTheme(entry.icon);
+    }
+    if (info.icon.isNull()) {
+        info.icon = QIcon::fromTheme(desktopId);
+    }
+    return info;
+}
+
+QGSettings *NoticeRegistry::createSettings(const QString &path)
+{
+    const QByteArray id(NOTICE_ORIGIN_SCHEMA);
+    QByteArray settingsPath = path.toLatin1();
+    return new QGSettings(id, settingsPath, this);
+}
@@ -17,33 +17,41 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
  *
  */
-#ifndef BUILDPICUNITSWORKER_H
-#define BUILDPICUNITSWORKER_H
+#ifndef NOTICEREGISTRY_H
+#define NOTICEREGISTRY_H
 
 #include <QObject>
-#include <QPixmap>
-
-#include "bgfileparse.h"
-#include "xmlhandle.h"
+#include <QHash>
+#include <QIcon>
+#include <QStringList>
+#include <QGSettings>
+
+struct NoticeAppInfo {
+    QString name;
+    QIcon icon;
+};
 
-class BuildPicUnitsWorker : public QObject
+// 通知来源设置索引：dconf路径只列出一次，按应用名索引，每个路径只创建一个QGSettings
+class NoticeRegistry : public QObject
 {
     Q_OBJECT
-
 public:
-    explicit BuildPicUnitsWorker();
-    ~BuildPicUnitsWorker();
+    explicit NoticeRegistry(QObject *parent = nullptr);
 
-    void run();
+    void load();
 
-private:
-    XmlHandle * xmlHandleObj;
+    QGSettings *settings(const QString &appKey) const;
+    QGSettings *ensureSettings(const QString &appKey);
 
+    // 应用的desktop名称和图标，取自共享的desktop文件索引
+    static NoticeAppInfo appInfo(const QString &desktopId);
 
-Q_SIGNALS:
-    void pixmapGeneral(QPixmap pixmap, BgInfo bginfo);
-    void workerComplete();
+private:
+    QGSettings *createSettings(const QString &path);
 
+private:
+    QStringList mPaths;
+    QHash<QString, QGSettings *> mSettings;    // <应用名, 设置>
 };
 
-#endif // BUILDPICUNITSWORKER_H
+#endif // NOTICEREGISTRY_H
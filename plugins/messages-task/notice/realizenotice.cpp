@@ -21,7 +21,7 @@
 
 #include <QDebug>
 
-QList<char *> listExistsCustomNoticePath(){
+QStringList listExistsCustomNoticePath(){
     char ** childs;
     int len;
 
@@ -29,42 +29,23 @@ QList<char *> listExistsCustomNoticePath(){
     childs = dconf_client_list (client, NOTICE_ORIGIN_PATH, &len);
     g_object_unref (client);
 
-    QList<char *> vals;
+    QStringList vals;
 
     for (int i = 0; childs[i] != NULL; i++){
         if (dconf_is_rel_dir (childs[i], NULL)){
-            char * val = g_strdup (childs[i]);
-
-            vals.append(val);
+            vals.append(QString(childs[i]));
         }
     }
     g_strfreev (childs);
     return vals;
 }
 
-QString findFreePath(){
-    int i = 0;
-    char * dir;
-    bool found;
-    QList<char *> existsdirs;
-
-    existsdirs = listExistsCustomNoticePath();
-    for (; i < MAX_CUSTOM_SHORTCUTS; i++){
-        found = true;
-        dir = QString("custom%1/").arg(i).toLatin1().data();
-        for (int j = 0; j < existsdirs.count(); j++) {
-            if (!g_strcmp0(dir, existsdirs.at(j))){
-                found = false;
-                break;
-            }
+QString findFreePath(const QStringList &existsdirs){
+    for (int i = 0; i < MAX_CUSTOM_SHORTCUTS; i++){
+        QString dir = QString("custom%1/").arg(i);
+        if (!existsdirs.contains(dir)) {
+            return QString("%1%2").arg(NOTICE_ORIGIN_PATH).arg(dir);
         }
-        if (found)
-            break;
     }
-
-    if (i == MAX_CUSTOM_SHORTCUTS){
-        return "";
-    }
-
-    return QString("%1%2").arg(NOTICE_ORIGIN_PATH).arg(QString(dir));
+    return "";
 }
@@ -23,6 +23,7 @@
 
 #include <QGSettings>
 #include <QList>
+#include <QStringList>
 
 /* qt会将glib里的signals成员识别为宏，所以取消该宏
  * 后面如果用到signals时，使用Q_SIGNALS代替即可
@@ -52,9 +53,10 @@
 
 #define MAX_CUSTOM_SHORTCUTS 1000
 
-QList<char *> listExistsCustomNoticePath();
+QStringList listExistsCustomNoticePath();
 
-QString findFreePath();
+// existsdirs为已列出的路径，避免重复读取dconf
+QString findFreePath(const QStringList &existsdirs);
 
 
 #endif // REALIZENOTICE_H
@@ -20,17 +20,15 @@
 #include "netconnect.h"
 #include "ui_netconnect.h"
 
-#include "kylin_network_interface.h"
 #include "commonComponent/HoverBtn/hoverbtn.h"
 
 #include <QGSettings>
 #include <QProcess>
 #include <QTimer>
-#include <QDBusInterface>
-#include <QDBusReply>
-#include <QDir>
 #include <QDebug>
 #include <QtAlgorithms>
+#include <QSet>
+#include <algorithm>
 
 #define ITEMHEIGH           50
 #define CONTROL_CENTER_WIFI "org.ukui.control-center.wifi.switch"
@@ -39,7 +37,7 @@ bool sortByVal(const QPair<QString, int> &l, const QPair<QString, int> &r) {
     return (l.second < r.second);
 }
 
-NetConnect::NetConnect() : m_wifiList(new Wifi), mFirstLoad(true)
+NetConnect::NetConnect() : mModel(nullptr), mRefreshTimer(nullptr), mStrengthTimer(nullptr), mFirstLoad(true)
 {
     pluginName = tr("Connect");
     pluginType = NETWORK;
@@ -89,26 +87,6 @@ void NetConnect::plugin_delay_control() {
 
 }
 
-void NetConnect::refreshed_signal_changed() {
-    // 仅接收属性更改发出的第一个信号并更改is_refreshed状态
-    if(is_refreshed){
-        emit refresh();
-        this->is_refreshed = false;
-    }
-    else return;
-}
-
-//把判断列表是否已刷新的bool值is_refreshed重置为true
-void NetConnect::reset_bool_is_refreshed(){
-    this->is_refreshed = true;
-}
-
-void NetConnect::properties_changed_refresh(){
-    getNetList();
-    /*等待一段时间后把is_refreshed重置，等待是为了避免在dbus接收属性更改时收到
-    多条信号并连续执行槽函数refreshed_signal_changed()并更改is_refreshed导致冲突*/
-    QTimer::singleShot(1000, this, SLOT(reset_bool_is_refreshed()));
-}
 const QString NetConnect::name() const {
 
     return QStringLiteral("netconnect");
@@ -123,20 +101,40 @@ void NetConnect::initSearchText() {
 
 void NetConnect::initComponent(){
 
-    //把判断列表是否已刷新的bool值初始化为true
-    this->is_refreshed = true;
+    mModel = new NetworkModel(this);
 
-    //接收到系统创建网络连接的信号时刷新可用网络列表
-    QDBusConnection::systemBus().connect(QString(), QString("/org/freedesktop/NetworkManager/Settings"), "org.freedesktop.NetworkManager.Settings", "NewConnection", this, SLOT(getNetList(void)));
-    //接收到系统删除网络连接的信号时刷新可用网络列表
-    QDBusConnection::systemBus().connect(QString(), QString("/org/freedesktop/NetworkManager/Settings"), "org.freedesktop.NetworkManager.Settings", "ConnectionRemoved", this, SLOT(getNetList(void)));
-    //接收到系统更改网络连接属性的信号时刷新可用网络列表
-//    QDBusConnection::systemBus().connect(QString(), QString("/org/freedesktop/NetworkManager"), "org.freedesktop.NetworkManager", "PropertiesChanged", this, SLOT(getNetList(void)));
-    //接收到系统更改网络连接属性时把判断是否已刷新的bool值置为false
-    QDBusConnection::systemBus().connect(QString(), QString("/org/freedesktop/NetworkManager"), "org.freedesktop.NetworkManager", "PropertiesChanged", this, SLOT(refreshed_signal_changed(void)));
+    // 网络变化由NetworkManager信号驱动，短时间内的多次变化合并为一次刷新
+    mRefreshTimer = new QTimer(this);
+    mRefreshTimer->setSingleShot(true);
+    mRefreshTimer->setInterval(200);
+    connect(mRefreshTimer, &QTimer::timeout, this, &NetConnect::getNetList);
 
-    //接收到刷新信号refresh()时执行刷新(仅适用与网络属性或当前连接的网络更改)
-    connect(this, SIGNAL(refresh()), this, SLOT(properties_changed_refresh()));
+    // 信号强度变化频繁，最多每2秒更新一次
+    mStrengthTimer = new QTimer(this);
+    mStrengthTimer->setSingleShot(true);
+    mStrengthTimer->setInterval(2000);
+    connect(mStrengthTimer, &QTimer::timeout, this, &NetConnect::getNetList);
+
+    // 已在计时则不重新计时，持续扫描时列表也能及时更新
+    auto scheduleRefresh = [=]() {
+        if (!mRefreshTimer->isActive()) {
+            mRefreshTimer->start();
+        }
+    };
+    connect(mModel, &NetworkModel::wifiNetworkAdded, this, scheduleRefresh);
+    connect(mModel, &NetworkModel::wifiNetworkRemoved, this, scheduleRefresh);
+    connect(mModel, &NetworkModel::wiredConnectionsChanged, this, scheduleRefresh);
+    connect(mModel, &NetworkModel::activeConnectionsChanged, this, scheduleRefresh);
+    connect(mModel, &NetworkModel::wifiNetworkChanged, this, [=]() {
+        if (!mStrengthTimer->isActive()) {
+            mStrengthTimer->start();
+        }
+    });
+    connect(mModel, &NetworkModel::wirelessChanged, this, &NetConnect::wirelessChangedSlot);
+    connect(mModel, &NetworkModel::scanRequested, this, [=]{
+        ui->RefreshBtn->setEnabled(true);
+        ui->RefreshBtn->setText(tr("Refresh"));
+    });
 
     const QByteArray id(CONTROL_CENTER_WIFI);
     if(QGSettings::isSchemaInstalled(id)) {
@@ -161,28 +159,20 @@ void NetConnect::initComponent(){
         Q_UNUSED(checked)
         ui->RefreshBtn->setText(tr("Refreshing..."));
         ui->RefreshBtn->setEnabled(false);
-        wifiBtn->setEnabled(false);
-        QTimer::singleShot(1*1000,this,SLOT(getNetList()));
+        mModel->requestScan();
     });
 
-    if (getwifiisEnable()) {
-        wifiBtn->setChecked(getInitStatus());
-    }
     connect(wifiBtn, &SwitchButton::checkedChanged, this,[=](bool checked){
-        ui->RefreshBtn->setText(tr("Refreshing..."));
-        ui->RefreshBtn->setEnabled(false);
-        wifiBtn->setEnabled(false);
-
         wifiBtn->blockSignals(true);
         wifiSwitchSlot(checked);
         wifiBtn->blockSignals(false);
+        getNetList();
     });
 
-    ui->RefreshBtn->setEnabled(false);
     wifiBtn->setEnabled(false);
-
-    emit ui->RefreshBtn->clicked(true);
     ui->verticalLayout_2->setContentsMargins(0,0,32,0);
+
+    mModel->start();
 }
 
 void NetConnect::rebuildNetStatusComponent(QString iconPath, QString netName){
@@ -250,63 +240,85 @@ void NetConnect::rebuildNetStatusComponent(QString iconPath, QString netName){
     ui->statusLayout->addWidget(baseWidget);
 }
 
+// 按名称对比现有行，仅增删、移动或更新发生变化的行，避免整表重建闪烁
 void NetConnect::getNetList() {
+    pluginWidget->setUpdatesEnabled(false);
 
-    bool wifiSt = getwifiisEnable();
-    if (!wifiSt) {
-        wifiBtn->setChecked(wifiSt);
-    }
-    wifiBtn->setEnabled(wifiSt);
-
-    this->TlanList =  execGetLanList();
-    pThread = new QThread;
-    pNetWorker = new NetconnectWork;
-
-    connect(pNetWorker, &NetconnectWork::wifiGerneral,this,[&](QStringList list){
-        this->TwifiList = list;
-        getWifiListDone(this->TwifiList, this->TlanList);
-        QMap<QString, int>::iterator iter = this->wifiList.begin();
-        QVector<QPair<QString, int>> vec;
-        QString iconamePah;
+    rebuildStatus();
 
-        while(iter != this->wifiList.end()) {
+    QVector<QPair<QString, int>> vec;
+    if (wifiBtn->isChecked()) {
+        QMap<QString, int> wifiList = mModel->wifiNetworks();
+        for (auto iter = wifiList.constBegin(); iter != wifiList.constEnd(); iter++) {
+            vec.push_back(qMakePair(iter.key(), setSignal(iter.value())));
+        }
+        // 同一信号等级内保持名称顺序，列表不随扫描跳动
+        std::stable_sort(vec.begin(), vec.end(), sortByVal);
+    }
+    QStringList lanList = mModel->wiredConnections();
 
-            vec.push_back(qMakePair(iter.key(), iter.value()));
-            iter++;
+    QSet<QString> wifiNames;
+    for (const QPair<QString, int> &wifi : vec) {
+        wifiNames.insert(wifi.first);
+    }
+    removeStaleItems(mWifiItems, wifiNames);
+    removeStaleItems(mLanItems, lanList.toSet());
+
+    int row = 0;
+    for (const QPair<QString, int> &wifi : vec) {
+        QString iconamePah = ":/img/plugins/netconnect/wifi" + QString::number(wifi.second)+".svg";
+        HoverBtn *item = mWifiItems.value(wifi.first);
+        if (!item) {
+            item = rebuildAvailComponent(iconamePah, wifi.first);
+            mWifiItems.insert(wifi.first, item);
+        } else if (item->property("signalLevel").toInt() != wifi.second) {
+            item->mPitIcon->setPixmap(iconamePah);
         }
-        qSort(vec.begin(), vec.end(), sortByVal);
-        for (int i = 0; i < vec.size(); i++) {
-            if (!wifiBtn->isChecked()){
-                break;
-            }
-            iconamePah= ":/img/plugins/netconnect/wifi" + QString::number(vec[i].second)+".svg";
-            rebuildAvailComponent(iconamePah , vec[i].first);
+        item->setProperty("signalLevel", wifi.second);
+        placeAvailItem(item, row++);
+    }
+
+    for (const QString &lan : lanList) {
+        HoverBtn *item = mLanItems.value(lan);
+        if (!item) {
+            item = rebuildAvailComponent(":/img/plugins/netconnect/eth.svg", lan);
+            mLanItems.insert(lan, item);
         }
+        placeAvailItem(item, row++);
+    }
 
-        for(int i = 0; i < this->lanList.length(); i++) {        ;
-            iconamePah= ":/img/plugins/netconnect/eth.svg";
-            rebuildAvailComponent(iconamePah , lanList.at(i));
+    pluginWidget->setUpdatesEnabled(true);
+}
+
+void NetConnect::removeStaleItems(QMap<QString, HoverBtn *> &items, const QSet<QString> &names) {
+    for (auto it = items.begin(); it != items.end();) {
+        if (names.contains(it.key())) {
+            ++it;
+            continue;
         }
+        ui->availableLayout->removeWidget(it.value());
+        it.value()->deleteLater();
+        it = items.erase(it);
+    }
+}
 
-    });
-    connect(pNetWorker, &NetconnectWork::workerComplete,this, [=]{
-       pThread->quit();
-       pThread->wait();
-    });
-    pNetWorker->moveToThread(pThread);
-    connect(pThread, &QThread::started, pNetWorker, &NetconnectWork::run);
-    connect(pThread, &QThread::finished, this, [=]{
-        bool wifiSt = getwifiisEnable();
-        wifiBtn->setEnabled(wifiSt);
-        ui->RefreshBtn->setEnabled(true);
-        ui->RefreshBtn->setText(tr("Refresh"));
-    });
-    connect(pThread, &QThread::finished, pNetWorker, &NetconnectWork::deleteLater);
-    pThread->start();
+void NetConnect::placeAvailItem(HoverBtn *item, int row) {
+    if (ui->availableLayout->indexOf(item) != row) {
+        ui->availableLayout->removeWidget(item);
+        ui->availableLayout->insertWidget(row, item);
+    }
+}
 
+void NetConnect::wirelessChangedSlot() {
+    bool wifiSt = mModel->hasWirelessDevice();
+    wifiBtn->blockSignals(true);
+    wifiBtn->setChecked(wifiSt && mModel->wirelessEnabled());
+    wifiBtn->blockSignals(false);
+    wifiBtn->setEnabled(wifiSt);
+    mRefreshTimer->start();
 }
 
-void NetConnect::rebuildAvailComponent(QString iconPath, QString netName) {
+HoverBtn *NetConnect::rebuildAvailComponent(QString iconPath, QString netName) {
 
     HoverBtn * wifiItem = new HoverBtn(netName, pluginWidget);
     wifiItem->mPitLabel->setText(netName);
@@ -317,7 +329,7 @@ void NetConnect::rebuildAvailComponent(QString iconPath, QString netName) {
         runKylinmApp();
     });
 
-    ui->availableLayout->addWidget(wifiItem);
+    return wifiItem;
 }
 
 void NetConnect::runExternalApp() {
@@ -332,155 +344,32 @@ void NetConnect::runKylinmApp() {
     process.startDetached(cmd);
 }
 
-bool NetConnect::getwifiisEnable()
-{
-    QDBusInterface m_interface( "org.freedesktop.NetworkManager",
-                                "/org/freedesktop/NetworkManager",
-                                "org.freedesktop.NetworkManager",
-                                QDBusConnection::systemBus() );
-
-    QDBusReply<QList<QDBusObjectPath>> obj_reply = m_interface.call("GetAllDevices");
-    if (!obj_reply.isValid()) {
-        qDebug()<<"execute dbus method 'GetAllDevices' is invalid in func getObjectPath()";
-    }
-
-    QList<QDBusObjectPath> obj_paths = obj_reply.value();
+void NetConnect::rebuildStatus() {
+    QString actWifiName = mModel->activeWifi();
+    QString actLanName = mModel->activeLan();
+    QMap<QString, int> wifiList = mModel->wifiNetworks();
 
-    foreach (QDBusObjectPath obj_path, obj_paths){
-        QDBusInterface interface( "org.freedesktop.NetworkManager",
-                                  obj_path.path(),
-                                  "org.freedesktop.DBus.Introspectable",
-                                  QDBusConnection::systemBus() );
+    bool wifiConnected = !actWifiName.isEmpty() && wifiList.contains(actWifiName);
+    int wifiLevel = wifiConnected ? setSignal(wifiList.value(actWifiName)) : 0;
 
-        QDBusReply<QString> reply = interface.call("Introspect");
-        if (!reply.isValid()) {
-            qDebug()<<"execute dbus method 'Introspect' is invalid in func getObjectPath()";
-        }
-
-        if(reply.value().indexOf("org.freedesktop.NetworkManager.Device.Wired") != -1){
-        } else if (reply.value().indexOf("org.freedesktop.NetworkManager.Device.Wireless") != -1){
-            return true;
-        }
+    QString statusKey = QString("%1/%2/%3").arg(wifiConnected ? actWifiName : QString())
+            .arg(wifiLevel).arg(actLanName);
+    if (statusKey == mStatusKey) {
+        return;
     }
-    return false ;
-}
-
-
-QStringList NetConnect::execGetLanList(){
-    QProcess *lanPro = new QProcess();
-    QString shellOutput = "";
-    lanPro->start("nmcli -f type,device,name connection show");
-    lanPro->waitForFinished();
-    QString output = lanPro->readAll();
-    shellOutput += output;
-    QStringList slist = shellOutput.split("\n");
-
-    return slist;
-}
-
-void NetConnect::getWifiListDone(QStringList getwifislist, QStringList getlanList) {
-
+    mStatusKey = statusKey;
     clearContent();
 
-    QString lockPath = QDir::homePath() + "/.config/control-center-net";
-    activecon *act = kylin_network_get_activecon_info(lockPath.toUtf8().data());
-
-    //if is wifi list
-    if(!getwifislist.isEmpty()){
-        connectedWifi.clear();
-        wifiList.clear();
-
-        QString actWifiName = "--";
-
-
-        int index = 0;
-        while(act[index].con_name != NULL){
-            if(QString(act[index].type) == "wifi" ||QString(act[index].type) == "802-11-wireless"){
-                actWifiName = QString(act[index].con_name);
-                break;
-            }
-            index ++;
-        }
-
-        // 填充可用网络列表
-        QString headLine = getwifislist.at(0);
-        headLine = headLine.trimmed();
-        int indexName = headLine.indexOf("SSID");
-
-        QStringList wnames;
-        for(int i = 1; i < getwifislist.size(); i ++) {
-            QString line = getwifislist.at(i);
-            QString wsignal = line.mid(0, indexName).trimmed();
-            QString wname = line.mid(indexName).trimmed();
-
-            bool isContinue = false;
-            foreach (QString addName, wnames) {
-                // 重复的网络名称，跳过不处理
-                if(addName == wname){ isContinue = true; }
-            }
-            if(isContinue){ continue; }
-
-            if(wname != "" && wname != "--"){
-                int strength = this->setSignal(wsignal);
-                wifiList.insert(wname, strength);
-
-                if(wname == actWifiName) {
-                    connectedWifi.insert(wname, strength);
-                }
-                wnames.append(wname);
-            }
-        }
-    }
-
-    if(!getlanList.isEmpty()){
-        lanList.clear();
-        connectedLan.clear();
-
-        int indexLan = 0;
-        while(act[indexLan].con_name != NULL){
-            if (QString(act[indexLan].type) == "ethernet" || QString(act[indexLan].type) == "802-3-ethernet"){
-                actLanName = QString(act[indexLan].con_name);
-                break;
-            }
-            indexLan ++;
-        }
-
-        // 填充可用网络列表
-        QString headLine = getlanList.at(0);
-        int indexDevice, indexName;
-        headLine = headLine.trimmed();
-
-        bool isChineseExist = headLine.contains(QRegExp("[\\x4e00-\\x9fa5]+"));
-        if (isChineseExist) {
-            indexDevice = headLine.indexOf("设备") + 2;
-            indexName = headLine.indexOf("名称") + 4;
-        } else {
-            indexDevice = headLine.indexOf("DEVICE");
-            indexName = headLine.indexOf("NAME");
-    }
-
-        for(int i =1 ;i < getlanList.length(); i++)
-        {
-            QString line = getlanList.at(i);
-            QString ltype = line.mid(0, indexDevice).trimmed();
-            QString nname = line.mid(indexName).trimmed();
-            if(ltype  != "wifi" && ltype != "" && ltype != "--"){
-                this->lanList << nname;
-            }
-        }
-    }
-
-    if (!this->connectedWifi.isEmpty()){
-        QMap<QString, int>::iterator iter = this->connectedWifi.begin();
-        QString iconamePah = ":/img/plugins/netconnect/wifi" + QString::number(iter.value())+".svg";
-        rebuildNetStatusComponent(iconamePah , iter.key());
+    if (wifiConnected){
+        QString iconamePah = ":/img/plugins/netconnect/wifi" + QString::number(wifiLevel)+".svg";
+        rebuildNetStatusComponent(iconamePah , actWifiName);
     }
-    if (!this->actLanName.isEmpty()){
+    if (!actLanName.isEmpty()){
         QString lanIconamePah= ":/img/plugins/netconnect/eth.svg";
-        rebuildNetStatusComponent(lanIconamePah, this->actLanName);
+        rebuildNetStatusComponent(lanIconamePah, actLanName);
     }
 
-    if (this->connectedWifi.isEmpty() && this->actLanName.isEmpty())  {
+    if (!wifiConnected && actLanName.isEmpty())  {
         rebuildNetStatusComponent(":/img/plugins/netconnect/nonet.svg" , "No Net");
     }
 }
@@ -497,36 +386,8 @@ bool NetConnect::getSwitchStatus(QString key){
     return res;
 }
 
-bool NetConnect::getInitStatus()
-{
-
-    QDBusInterface interface( "org.freedesktop.NetworkManager",
-                              "/org/freedesktop/NetworkManager",
-                              "org.freedesktop.DBus.Properties",
-                              QDBusConnection::systemBus() );
-    //获取当前wifi是否连接
-    QDBusReply<QVariant> m_result = interface.call("Get", "org.freedesktop.NetworkManager", "WirelessEnabled");
-
-    if (m_result.isValid()) {
-        bool status = m_result.value().toBool();
-        return status;
-    } else {
-        qDebug()<<"org.freedesktop.NetworkManager get invalid"<<endl;
-        return false;
-    }
-}
-
 void NetConnect::clearContent()
 {
-    if (ui->availableLayout->layout() != NULL) {
-        QLayoutItem* item;
-        while ((item = ui->availableLayout->layout()->takeAt( 0 )) != NULL )
-        {
-            delete item->widget();
-            delete item;
-        }
-    }
-
     if (ui->statusLayout->layout() != NULL) {
         QLayoutItem* item;
         while ((item = ui->statusLayout->layout()->takeAt( 0 )) != NULL )
@@ -535,19 +396,10 @@ void NetConnect::clearContent()
             delete item;
         }
     }
-
-    this->connectedLan.clear();
-    this->connectedWifi.clear();
-    this->actLanName.clear();
-    this->wifiList.clear();
-    this->lanList.clear();
-    this->TlanList.clear();
-    this->TwifiList.clear();
 }
 
 //get wifi's strength
-int NetConnect::setSignal(QString lv) {
-    int signal = lv.toInt();
+int NetConnect::setSignal(int signal) {
     int signalLv;
 
     if(signal > 75){
@@ -578,8 +430,6 @@ void NetConnect::wifiSwitchSlot(bool signal){
         return ;
     }
     m_gsettings->set("switch",signal);
-
-    QTimer::singleShot(2*1000,this,SLOT(getNetList()));
 }
 
 
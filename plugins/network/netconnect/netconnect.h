@@ -38,8 +38,7 @@
 #include <HoverWidget/hoverwidget.h>
 #include <QMap>
 
-#include "wifi.h"
-#include "netconnectwork.h"
+#include "networkmodel.h"
 #include "shell/interface.h"
 #include "SwitchButton/switchbutton.h"
 
@@ -65,11 +64,13 @@ namespace Ui {
 class NetConnect;
 }
 
+class HoverBtn;
+
 
 class NetConnect : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "netconnect.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -86,13 +87,11 @@ public:
     void initSearchText();
     void initComponent();    
     void rebuildNetStatusComponent(QString iconPath, QString netName);
-    void rebuildAvailComponent(QString iconpath, QString netName);
+    HoverBtn *rebuildAvailComponent(QString iconpath, QString netName);
 
     void runExternalApp();
     void runKylinmApp();
 
-    bool getwifiisEnable();
-
 private:
     Ui::NetConnect *ui;
 
@@ -102,39 +101,29 @@ private:
 
     SwitchButton *wifiBtn;
 
-    QMap<QString, int> connectedWifi;
-    QMap<QString,int> wifiList;     //wifi list<name,Signal strength>
-    QStringList lanList;            // list of wired network
-    QString connectedLan;
     QGSettings *m_gsettings = nullptr;
 
-    Wifi *m_wifiList;
-    QThread *pThread;
-    NetconnectWork *pNetWorker;
-
-    QStringList TwifiList;
-    QStringList TlanList;
+    NetworkModel *mModel;
+    QTimer *mRefreshTimer;          // 合并短时间内的多次网络变化
+    QTimer *mStrengthTimer;         // 限制信号强度变化的刷新频率
 
-    QString actLanName;
+    QMap<QString, HoverBtn *> mWifiItems;   // <ssid, 可用网络行>
+    QMap<QString, HoverBtn *> mLanItems;    // <连接名, 可用网络行>
+    QString mStatusKey;                     // 当前连接状态，未变化时不重建
 
-    bool is_refreshed;
     bool mFirstLoad;
 
 private:
 
     QMap<QString, QListWidgetItem *> AvailableNetworkMap;
 
-    int setSignal(QString lv);      //get wifi's strength
-    QStringList execGetLanList();
-    void getWifiListDone(QStringList wifislist, QStringList lanList);
+    int setSignal(int signal);      //get wifi's strength
+    void rebuildStatus();
+    void removeStaleItems(QMap<QString, HoverBtn *> &items, const QSet<QString> &names);
+    void placeAvailItem(HoverBtn *item, int row);
     bool getSwitchStatus(QString key);
 
-    /*
-     * the wifi's origin status
-     */
-    bool getInitStatus();
-
-    // clear the lan and wifi list
+    // clear the connection status rows
     void clearContent();
 
     void deleteNetworkDone(QString);
@@ -145,13 +134,7 @@ private:
 private slots:
     void wifiSwitchSlot(bool signal);
     void getNetList();
-
-    void refreshed_signal_changed();
-    void properties_changed_refresh();
-    void reset_bool_is_refreshed();
-
-signals:
-    void refresh();
+    void wirelessChangedSlot();
 };
 
 #endif // NETCONNECT_H
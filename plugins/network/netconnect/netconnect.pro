@@ -30,18 +30,17 @@ PKGCONFIG += gsettings-qt \
 #DEFINES += QT_DEPRECATED_WARNINGS
 
 SOURCES += \
-    kylin_network_interface.c \
     netconnect.cpp \
-    netconnectwork.cpp \
-    wifi.cpp
+    networkmodel.cpp
 
 HEADERS += \
-    kylin_network_interface.h \
     netconnect.h \
-    netconnectwork.h \
-    wifi.h
+    networkmodel.h
 
 FORMS += \
     netconnect.ui
 
 INSTALLS += target
+
+DISTFILES += \
+    netconnect.json
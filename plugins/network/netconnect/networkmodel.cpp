@@ -0,0 +1,492 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "networkmodel.h"
+
+#include <QDBusConnection>
+#include <QDBusObjectPath>
+#include <QDBusArgument>
+#include <QDBusPendingCallWatcher>
+#include <QDebug>
+
+#define NM_SERVICE              "org.freedesktop.NetworkManager"
+#define NM_PATH                 "/org/freedesktop/NetworkManager"
+#define NM_SETTINGS_PATH        "/org/freedesktop/NetworkManager/Settings"
+#define NM_INTERFACE            "org.freedesktop.NetworkManager"
+#define NM_DEVICE_INTERFACE     "org.freedesktop.NetworkManager.Device"
+#define NM_WIRELESS_INTERFACE   "org.freedesktop.NetworkManager.Device.Wireless"
+#define NM_AP_INTERFACE         "org.freedesktop.NetworkManager.AccessPoint"
+#define NM_SETTINGS_INTERFACE   "org.freedesktop.NetworkManager.Settings"
+#define NM_CONNECTION_INTERFACE "org.freedesktop.NetworkManager.Settings.Connection"
+#define NM_ACTIVE_INTERFACE     "org.freedesktop.NetworkManager.Connection.Active"
+#define DBUS_PROPERTIES         "org.freedesktop.DBus.Properties"
+
+#define NM_DEVICE_TYPE_WIFI     2
+#define WIRELESS_TYPE           "802-11-wireless"
+#define ETHERNET_TYPE           "802-3-ethernet"
+
+NetworkModel::NetworkModel(QObject *parent) :
+    QObject(parent),
+    mStarted(false),
+    mWirelessEnabled(false)
+{
+}
+
+void NetworkModel::start()
+{
+    if (mStarted) {
+        return;
+    }
+    mStarted = true;
+
+    QDBusConnection bus = QDBusConnection::systemBus();
+    bus.connect(NM_SERVICE, NM_PATH, NM_INTERFACE, "DeviceAdded",
+                this, SLOT(deviceAdded(QDBusObjectPath)));
+    bus.connect(NM_SERVICE, NM_PATH, NM_INTERFACE, "DeviceRemoved",
+                this, SLOT(deviceRemoved(QDBusObjectPath)));
+    // 旧版本NetworkManager在自身接口上发出PropertiesChanged
+    bus.connect(NM_SERVICE, QString(), NM_INTERFACE, "PropertiesChanged",
+                this, SLOT(legacyPropertiesChanged(QVariantMap, QDBusMessage)));
+    bus.connect(NM_SERVICE, QString(), NM_AP_INTERFACE, "PropertiesChanged",
+                this, SLOT(legacyPropertiesChanged(QVariantMap, QDBusMessage)));
+    bus.connect(NM_SERVICE, QString(), DBUS_PROPERTIES, "PropertiesChanged",
+                this, SLOT(propertiesChanged(QString, QVariantMap, QStringList, QDBusMessage)));
+    bus.connect(NM_SERVICE, QString(), NM_WIRELESS_INTERFACE, "AccessPointAdded",
+                this, SLOT(accessPointAdded(QDBusObjectPath, QDBusMessage)));
+    bus.connect(NM_SERVICE, QString(), NM_WIRELESS_INTERFACE, "AccessPointRemoved",
+                this, SLOT(accessPointRemoved(QDBusObjectPath, QDBusMessage)));
+    bus.connect(NM_SERVICE, NM_SETTINGS_PATH, NM_SETTINGS_INTERFACE, "NewConnection",
+                this, SLOT(connectionAdded(QDBusObjectPath)));
+    bus.connect(NM_SERVICE, NM_SETTINGS_PATH, NM_SETTINGS_INTERFACE, "ConnectionRemoved",
+                this, SLOT(connectionRemoved(QDBusObjectPath)));
+    bus.connect(NM_SERVICE, QString(), NM_CONNECTION_INTERFACE, "Updated",
+                this, SLOT(connectionUpdated(QDBusMessage)));
+
+    getAll(NM_PATH, NM_INTERFACE, [=](const QVariantMap &properties) {
+        updateManager(properties);
+    });
+    loadDevices();
+    loadConnections();
+}
+
+void NetworkModel::requestScan()
+{
+    int pending = 0;
+    for (auto it = mDevices.constBegin(); it != mDevices.constEnd(); it++) {
+        if (it.value() != NM_DEVICE_TYPE_WIFI) {
+            continue;
+        }
+        QDBusMessage msg = QDBusMessage::createMethodCall(NM_SERVICE, it.key(),
+                                                          NM_WIRELESS_INTERFACE, "RequestScan");
+        msg << QVariantMap();
+        pending++;
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(
+                    QDBusConnection::systemBus().asyncCall(msg), this);
+        // 扫描过于频繁时NetworkManager会返回错误，结果仍以热点信号为准
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [=](QDBusPendingCallWatcher *w) {
+            w->deleteLater();
+            Q_EMIT scanRequested();
+        });
+    }
+    if (pending == 0) {
+        Q_EMIT scanRequested();
+    }
+}
+
+bool NetworkModel::hasWirelessDevice() const
+{
+    for (uint type : mDevices) {
+        if (type == NM_DEVICE_TYPE_WIFI) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool NetworkModel::wirelessEnabled() const
+{
+    return mWirelessEnabled;
+}
+
+QMap<QString, int> NetworkModel::wifiNetworks() const
+{
+    return mNetworks;
+}
+
+QStringList NetworkModel::wiredConnections() const
+{
+    QStringList names;
+    for (const Connection &conn : mConnections) {
+        if (conn.type != WIRELESS_TYPE && !conn.id.isEmpty()) {
+            names << conn.id;
+        }
+    }
+    names.sort();
+    return names;
+}
+
+QString NetworkModel::activeWifi() const
+{
+    for (const Connection &conn : mActiveConnections) {
+        if (conn.type != WIRELESS_TYPE) {
+            continue;
+        }
+        // 以正在使用的热点的ssid为准，连接名可能与ssid不同
+        QString ssid = mAccessPoints.value(conn.specificObject).ssid;
+        return ssid.isEmpty() ? conn.id : ssid;
+    }
+    return QString();
+}
+
+QString NetworkModel::activeLan() const
+{
+    for (const Connection &conn : mActiveConnections) {
+        if (conn.type == ETHERNET_TYPE) {
+            return conn.id;
+        }
+    }
+    return QString();
+}
+
+void NetworkModel::asyncCall(const QDBusMessage &msg, std::function<void(const QDBusMessage &)> handler)
+{
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(
+                QDBusConnection::systemBus().asyncCall(msg), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [=](QDBusPendingCallWatcher *w) {
+        QDBusMessage reply = w->reply();
+        if (reply.type() == QDBusMessage::ErrorMessage) {
+            qDebug() << msg.path() << msg.member() << "failed:" << reply.errorMessage();
+        } else if (!reply.arguments().isEmpty()) {
+            handler(reply);
+        }
+        w->deleteLater();
+    });
+}
+
+void NetworkModel::getAll(const QString &path, const QString &interface,
+                          std::function<void(const QVariantMap &)> handler)
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(NM_SERVICE, path, DBUS_PROPERTIES, "GetAll");
+    msg << interface;
+    asyncCall(msg, [=](const QDBusMessage &reply) {
+        handler(qdbus_cast<QVariantMap>(reply.arguments().at(0)));
+    });
+}
+
+void NetworkModel::loadDevices()
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(NM_SERVICE, NM_PATH, NM_INTERFACE, "GetAllDevices");
+    asyncCall(msg, [=](const QDBusMessage &reply) {
+        QList<QDBusObjectPath> paths = qdbus_cast<QList<QDBusObjectPath>>(reply.arguments().at(0));
+        for (const QDBusObjectPath &path : paths) {
+            deviceAdded(path);
+        }
+    });
+}
+
+void NetworkModel::loadConnections()
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(NM_SERVICE, NM_SETTINGS_PATH,
+                                                      NM_SETTINGS_INTERFACE, "ListConnections");
+    asyncCall(msg, [=](const QDBusMessage &reply) {
+        QList<QDBusObjectPath> paths = qdbus_cast<QList<QDBusObjectPath>>(reply.arguments().at(0));
+        for (const QDBusObjectPath &path : paths) {
+            loadConnection(path.path());
+        }
+    });
+}
+
+void NetworkModel::loadConnection(const QString &path)
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(NM_SERVICE, path, NM_CONNECTION_INTERFACE, "GetSettings");
+    asyncCall(msg, [=](const QDBusMessage &reply) {
+        QMap<QString, QVariantMap> settings = qdbus_cast<QMap<QString, QVariantMap>>(reply.arguments().at(0));
+        QVariantMap connection = settings.value("connection");
+
+        Connection conn;
+        conn.id = connection.value("id").toString();
+        conn.type = connection.value("type").toString();
+
+        auto it = mConnections.constFind(path);
+        if (it != mConnections.constEnd() && it->id == conn.id && it->type == conn.type) {
+            return;
+        }
+        mConnections.insert(path, conn);
+        Q_EMIT wiredConnectionsChanged();
+    });
+}
+
+void NetworkModel::loadActiveConnections(const QList<QString> &paths)
+{
+    mActivePaths = QSet<QString>::fromList(paths);
+
+    bool removed = false;
+    for (const QString &path : mActiveConnections.keys()) {
+        if (!paths.contains(path)) {
+            mActiveConnections.remove(path);
+            removed = true;
+        }
+    }
+    if (removed) {
+        Q_EMIT activeConnectionsChanged();
+    }
+
+    for (const QString &path : paths) {
+        if (mActiveConnections.contains(path)) {
+            continue;
+        }
+        getAll(path, NM_ACTIVE_INTERFACE, [=](const QVariantMap &properties) {
+            // 回复到达前连接已断开，或已由更早的回复加入
+            if (!mActivePaths.contains(path) || mActiveConnections.contains(path)) {
+                return;
+            }
+            Connection conn;
+            conn.id = properties.value("Id").toString();
+            conn.type = properties.value("Type").toString();
+            conn.specificObject = qvariant_cast<QDBusObjectPath>(properties.value("SpecificObject")).path();
+            mActiveConnections.insert(path, conn);
+            Q_EMIT activeConnectionsChanged();
+        });
+    }
+}
+
+void NetworkModel::updateManager(const QVariantMap &properties)
+{
+    if (properties.contains("WirelessEnabled")) {
+        bool enabled = properties.value("WirelessEnabled").toBool();
+        if (enabled != mWirelessEnabled) {
+            mWirelessEnabled = enabled;
+            Q_EMIT wirelessChanged();
+        }
+    }
+    if (properties.contains("ActiveConnections")) {
+        QList<QDBusObjectPath> objects;
+        const QVariant value = properties.value("ActiveConnections");
+        if (value.canConvert<QDBusArgument>()) {
+            objects = qdbus_cast<QList<QDBusObjectPath>>(value);
+        } else {
+            objects = value.value<QList<QDBusObjectPath>>();
+        }
+        QList<QString> paths;
+        for (const QDBusObjectPath &obj : objects) {
+            paths << obj.path();
+        }
+        loadActiveConnections(paths);
+    }
+}
+
+void NetworkModel::addAccessPoint(const QString &path, const QString &device)
+{
+    if (mAccessPoints.contains(path)) {
+        return;
+    }
+    AccessPoint ap;
+    ap.device = device;
+    mAccessPoints.insert(path, ap);
+
+    getAll(path, NM_AP_INTERFACE, [=](const QVariantMap &properties) {
+        updateAccessPoint(path, properties);
+    });
+}
+
+void NetworkModel::removeAccessPoint(const QString &path)
+{
+    auto it = mAccessPoints.find(path);
+    if (it == mAccessPoints.end()) {
+        return;
+    }
+    QString ssid = it->ssid;
+    mAccessPoints.erase(it);
+
+    if (!ssid.isEmpty()) {
+        mSsidAccessPoints[ssid].remove(path);
+        updateNetwork(ssid);
+    }
+}
+
+void NetworkModel::updateAccessPoint(const QString &path, const QVariantMap &properties)
+{
+    // 热点已被移除时丢弃迟到的应答
+    auto it = mAccessPoints.find(path);
+    if (it == mAccessPoints.end()) {
+        return;
+    }
+
+    QString oldSsid = it->ssid;
+    if (properties.contains("Ssid")) {
+        it->ssid = QString::fromUtf8(properties.value("Ssid").toByteArray());
+    }
+    if (properties.contains("Strength")) {
+        it->strength = properties.value("Strength").toInt();
+    }
+    QString ssid = it->ssid;
+
+    if (oldSsid != ssid) {
+        if (!oldSsid.isEmpty()) {
+            mSsidAccessPoints[oldSsid].remove(path);
+            updateNetwork(oldSsid);
+        }
+        if (!ssid.isEmpty()) {
+            mSsidAccessPoints[ssid].insert(path);
+        }
+    }
+    if (!ssid.isEmpty()) {
+        updateNetwork(ssid);
+    }
+}
+
+void NetworkModel::updateNetwork(const QString &ssid)
+{
+    int strength = -1;
+    auto aps = mSsidAccessPoints.find(ssid);
+    if (aps != mSsidAccessPoints.end()) {
+        for (const QString &path : aps.value()) {
+            strength = qMax(strength, mAccessPoints.value(path).strength);
+        }
+        if (aps->isEmpty()) {
+            mSsidAccessPoints.erase(aps);
+        }
+    }
+
+    auto it = mNetworks.find(ssid);
+    if (strength < 0) {
+        if (it != mNetworks.end()) {
+            mNetworks.erase(it);
+            Q_EMIT wifiNetworkRemoved(ssid);
+        }
+    } else if (it == mNetworks.end()) {
+        mNetworks.insert(ssid, strength);
+        Q_EMIT wifiNetworkAdded(ssid, strength);
+    } else if (it.value() != strength) {
+        it.value() = strength;
+        Q_EMIT wifiNetworkChanged(ssid, strength);
+    }
+}
+
+void NetworkModel::deviceAdded(const QDBusObjectPath &path)
+{
+    const QString device = path.path();
+    if (mDevices.contains(device) || mPendingDevices.contains(device)) {
+        return;
+    }
+    mPendingDevices.insert(device);
+    getAll(device, NM_DEVICE_INTERFACE, [=](const QVariantMap &properties) {
+        // 回复到达前设备已被移除
+        if (!mPendingDevices.remove(device)) {
+            return;
+        }
+        uint type = properties.value("DeviceType").toUInt();
+        bool hadWireless = hasWirelessDevice();
+        mDevices.insert(device, type);
+        if (type != NM_DEVICE_TYPE_WIFI) {
+            return;
+        }
+        if (!hadWireless) {
+            Q_EMIT wirelessChanged();
+        }
+
+        QDBusMessage msg = QDBusMessage::createMethodCall(NM_SERVICE, device,
+                                                          NM_WIRELESS_INTERFACE, "GetAllAccessPoints");
+        asyncCall(msg, [=](const QDBusMessage &reply) {
+            if (!mDevices.contains(device)) {
+                return;
+            }
+            QList<QDBusObjectPath> aps = qdbus_cast<QList<QDBusObjectPath>>(reply.arguments().at(0));
+            for (const QDBusObjectPath &ap : aps) {
+                addAccessPoint(ap.path(), device);
+            }
+        });
+    });
+}
+
+void NetworkModel::deviceRemoved(const QDBusObjectPath &path)
+{
+    const QString device = path.path();
+    mPendingDevices.remove(device);
+    if (!mDevices.contains(device)) {
+        return;
+    }
+    uint type = mDevices.take(device);
+    if (type != NM_DEVICE_TYPE_WIFI) {
+        return;
+    }
+
+    QStringList aps;
+    for (auto it = mAccessPoints.constBegin(); it != mAccessPoints.constEnd(); it++) {
+        if (it->device == device) {
+            aps << it.key();
+        }
+    }
+    for (const QString &ap : aps) {
+        removeAccessPoint(ap);
+    }
+    if (!hasWirelessDevice()) {
+        Q_EMIT wirelessChanged();
+    }
+}
+
+void NetworkModel::accessPointAdded(const QDBusObjectPath &path, const QDBusMessage &msg)
+{
+    if (mDevices.value(msg.path()) == NM_DEVICE_TYPE_WIFI) {
+        addAccessPoint(path.path(), msg.path());
+    }
+}
+
+void NetworkModel::accessPointRemoved(const QDBusObjectPath &path, const QDBusMessage &msg)
+{
+    Q_UNUSED(msg);
+    removeAccessPoint(path.path());
+}
+
+void NetworkModel::connectionAdded(const QDBusObjectPath &path)
+{
+    loadConnection(path.path());
+}
+
+void NetworkModel::connectionRemoved(const QDBusObjectPath &path)
+{
+    if (mConnections.remove(path.path()) > 0) {
+        Q_EMIT wiredConnectionsChanged();
+    }
+}
+
+void NetworkModel::connectionUpdated(const QDBusMessage &msg)
+{
+    loadConnection(msg.path());
+}
+
+void NetworkModel::propertiesChanged(const QString &interface, const QVariantMap &changed,
+                                     const QStringList &invalidated, const QDBusMessage &msg)
+{
+    Q_UNUSED(invalidated);
+    if (interface == NM_AP_INTERFACE) {
+        updateAccessPoint(msg.path(), changed);
+    } else if (interface == NM_INTERFACE && msg.path() == NM_PATH) {
+        updateManager(changed);
+    }
+}
+
+void NetworkModel::legacyPropertiesChanged(const QVariantMap &changed, const QDBusMessage &msg)
+{
+    if (msg.interface() == NM_AP_INTERFACE) {
+        updateAccessPoint(msg.path(), changed);
+    } else if (msg.path() == NM_PATH) {
+        updateManager(changed);
+    }
+}
@@ -0,0 +1,114 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef NETWORKMODEL_H
+#define NETWORKMODEL_H
+
+#include <QObject>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QStringList>
+#include <QVariantMap>
+#include <QDBusMessage>
+
+#include <functional>
+
+// 通过D-Bus订阅NetworkManager的设备、热点、连接信号，增量维护网络状态
+class NetworkModel : public QObject
+{
+    Q_OBJECT
+public:
+    explicit NetworkModel(QObject *parent = nullptr);
+
+    void start();
+    void requestScan();
+
+    bool hasWirelessDevice() const;
+    bool wirelessEnabled() const;
+
+    QMap<QString, int> wifiNetworks() const;    // <ssid, 信号强度0-100>，同名热点取最强
+    QStringList wiredConnections() const;       // 非无线的已保存连接
+    QString activeWifi() const;
+    QString activeLan() const;
+
+Q_SIGNALS:
+    void wifiNetworkAdded(const QString &ssid, int strength);
+    void wifiNetworkChanged(const QString &ssid, int strength);
+    void wifiNetworkRemoved(const QString &ssid);
+    void wiredConnectionsChanged();
+    void activeConnectionsChanged();
+    void wirelessChanged();
+    void scanRequested();
+
+private:
+    struct AccessPoint {
+        QString device;
+        QString ssid;
+        int strength = 0;
+    };
+
+    struct Connection {
+        QString id;
+        QString type;
+        QString specificObject;
+    };
+
+    void asyncCall(const QDBusMessage &msg, std::function<void(const QDBusMessage &)> handler);
+    void getAll(const QString &path, const QString &interface,
+                std::function<void(const QVariantMap &)> handler);
+
+    void loadDevices();
+    void loadConnections();
+    void loadActiveConnections(const QList<QString> &paths);
+    void loadConnection(const QString &path);
+
+    void addAccessPoint(const QString &path, const QString &device);
+    void removeAccessPoint(const QString &path);
+    void updateAccessPoint(const QString &path, const QVariantMap &properties);
+    void updateNetwork(const QString &ssid);
+    void updateManager(const QVariantMap &properties);
+
+private slots:
+    void deviceAdded(const QDBusObjectPath &path);
+    void deviceRemoved(const QDBusObjectPath &path);
+    void accessPointAdded(const QDBusObjectPath &path, const QDBusMessage &msg);
+    void accessPointRemoved(const QDBusObjectPath &path, const QDBusMessage &msg);
+    void connectionAdded(const QDBusObjectPath &path);
+    void connectionRemoved(const QDBusObjectPath &path);
+    void connectionUpdated(const QDBusMessage &msg);
+    void propertiesChanged(const QString &interface, const QVariantMap &changed,
+                           const QStringList &invalidated, const QDBusMessage &msg);
+    void legacyPropertiesChanged(const QVariantMap &changed, const QDBusMessage &msg);
+
+private:
+    bool mStarted;
+    bool mWirelessEnabled;
+
+    QHash<QString, uint> mDevices;                  // <设备路径, DeviceType>
+    QSet<QString> mPendingDevices;                  // 已添加但属性尚未返回的设备路径
+    QHash<QString, AccessPoint> mAccessPoints;      // <热点路径, 热点>
+    QHash<QString, QSet<QString>> mSsidAccessPoints;// <ssid, 热点路径>
+    QMap<QString, int> mNetworks;                   // <ssid, 信号强度>
+    QHash<QString, Connection> mConnections;        // <连接路径, 已保存连接>
+    QHash<QString, Connection> mActiveConnections;  // <活动连接路径, 活动连接>
+    QSet<QString> mActivePaths;                     // 最近一次ActiveConnections中的路径
+};
+
+#endif // NETWORKMODEL_H
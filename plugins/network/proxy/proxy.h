@@ -67,7 +67,7 @@ class Proxy;
 class Proxy : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "proxy.json")
     Q_INTERFACES(CommonInterface)
 
 public:
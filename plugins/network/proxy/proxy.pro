@@ -43,4 +43,7 @@ FORMS += \
     proxy.ui \
     certificationdialog.ui
 
-INSTALLS += target
\ No newline at end of file
+INSTALLS += target
+
+DISTFILES += \
+    proxy.json
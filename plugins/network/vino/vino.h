@@ -30,7 +30,7 @@
 class Vino : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "vino.json")
     Q_INTERFACES(CommonInterface)
 
 public:
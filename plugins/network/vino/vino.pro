@@ -37,3 +37,6 @@ FORMS +=
 
 # Default rules for deployment.
 INSTALLS += target
+
+DISTFILES += \
+    vino.json
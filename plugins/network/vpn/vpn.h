@@ -34,7 +34,7 @@ class Vpn;
 class Vpn : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "vpn.json")
     Q_INTERFACES(CommonInterface)
 
 public:
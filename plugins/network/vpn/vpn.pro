@@ -34,3 +34,6 @@ FORMS += \
     vpn.ui
 
 INSTALLS += target
+
+DISTFILES += \
+    vpn.json
@@ -23,15 +23,12 @@
 #include <QGSettings>
 #include "SwitchButton/switchbutton.h"
 #include "realizedesktop.h"
+#include "DesktopEntryIndex/desktopentryindex.h"
 #include "commonComponent/listDelegate/listdelegate.h"
 
 #include <QDebug>
 #include <QPushButton>
 #include <QFileInfo>
-#include <QFile>
-#include <QProcess>
-#include <QSettings>
-#include <QTextCodec>
 #include <QtDBus/QDBusConnection>
 
 #define DESKTOP_SCHEMA       "org.ukui.control-center.desktop"
@@ -116,7 +113,6 @@ QWidget *Desktop::get_plugin_ui() {
         if (QGSettings::isSchemaInstalled(id)) {
             dSettings = new QGSettings(id, QByteArray(), this);
         }
-        cmd = QSharedPointer<QProcess>(new QProcess());
         initSearchText();
         initTranslation();
         setupComponent();
@@ -439,49 +435,32 @@ void Desktop::initTraySettings() {
 QMap<QString, QIcon> Desktop::desktopConver(QString processName) {
 
     QMap<QString, QIcon> desktopMap;
-    if (isFileExist("/etc/xdg/autostart/"+processName + ".desktop") ||
-            isFileExist("/usr/share/applications/"+processName+".desktop")) {
-        QString autoName = desktopToName("/etc/xdg/autostart/"+processName+".desktop");
-        QIcon autoIcon   = desktopToIcon("/etc/xdg/autostart/"+processName+".desktop");
-        QString appName  = desktopToName("/usr/share/applications/"+processName+".desktop");
-        QIcon appIcon    = desktopToIcon("/usr/share/applications/"+processName+".desktop");
-        if (autoName != "") {
-            desktopMap.insert(autoName, autoIcon);
-        } else if (appName != "") {
-            desktopMap.insert(appName, appIcon);
+    DesktopEntryIndex * index = DesktopEntryIndex::instance();
+
+    // 先按desktop文件ID查找，autostart中的名称优先；都没有时按Exec程序名查找
+    QStringList ids;
+    ids << processName;
+    if (processName.toLower() != processName) {
+        ids << processName.toLower();
+    }
+    for (const QString &id : ids) {
+        DesktopEntry autoEntry = index->autostartEntry(id, DesktopEntryIndex::SystemAutostart);
+        DesktopEntry appEntry  = index->application(id);
+        if (!autoEntry.isValid() && !appEntry.isValid()) {
+            continue;
         }
-    } else if (isFileExist("/etc/xdg/autostart/" + processName.toLower() + ".desktop") ||
-               isFileExist("/usr/share/applications/" + processName.toLower() + ".desktop")){
-        QString autoName = desktopToName("/etc/xdg/autostart/" + processName.toLower() + ".desktop");
-        QIcon autoIcon = desktopToIcon("/etc/xdg/autostart/" + processName.toLower() + ".desktop");
-
-        QString appName  = desktopToName("/usr/share/applications/" + processName.toLower() + ".desktop");
-        QIcon appIcon  = desktopToIcon("/usr/share/applications/" + processName.toLower() + ".desktop");
-        if (autoName != "") {
-            desktopMap.insert(autoName, autoIcon);
-        } else if (appName != "") {
-            desktopMap.insert(appName, appIcon);
+        if (autoEntry.name != "") {
+            desktopMap.insert(autoEntry.name, QIcon::fromTheme(autoEntry.icon));
+        } else if (appEntry.name != "") {
+            desktopMap.insert(appEntry.name, QIcon::fromTheme(appEntry.icon));
         }
-    } else {
-        connect(cmd.get(), &QProcess::readyReadStandardOutput, this, [&]() {
-            desktopMap = readOuputSlot();
-        });
-        // 异常处理
-        connect(cmd.get() , SIGNAL(readyReadStandardError()) , this , SLOT(readErrorSlot()));
-
-        QString inputCmd = QString("grep -nr %1 /usr/share/applications/  /etc/xdg/autostart/\n").arg(processName);
-        cmd->start(inputCmd);
-        cmd->waitForFinished(-1);
+        return desktopMap;
     }
-    return desktopMap;
-}
 
-bool Desktop::isFileExist(QString fullFileName) {
-    QFileInfo fileInfo(fullFileName);
-    if (fileInfo.isFile()) {
-        return true;
+    for (const DesktopEntry &entry : index->applicationsForExec(processName)) {
+        desktopMap.insert(entry.name, QIcon::fromTheme(entry.icon));
     }
-    return false;
+    return desktopMap;
 }
 
 void Desktop::removeTrayItem(QString itemName) {
@@ -518,65 +497,6 @@ void Desktop::addTrayItem(QGSettings * trayGSetting) {
     }
 }
 
-QString Desktop::desktopToName(QString desktopfile) {
-    const QString locale = QLocale::system().name();
-    const QString localeName = "Name[" + locale +"]";
-    const QString genericName = "GenericName[" + locale +"]";
-    QSettings desktopSettings(desktopfile, QSettings::IniFormat);
-
-    desktopSettings.setIniCodec(QTextCodec::codecForName("UTF-8"));
-    desktopSettings.beginGroup("Desktop Entry");
-
-    QString desktopName = desktopSettings.value(localeName, "").toString();
-    if (desktopName.isEmpty()) {
-        desktopName = desktopSettings.value(genericName, "").toString();
-    }
-
-    desktopSettings.endGroup();
-    return desktopName;
-}
-
-QIcon Desktop::desktopToIcon(const QString &desktopfile) {
-    QSettings desktopSettings(desktopfile, QSettings::IniFormat);
-
-    desktopSettings.setIniCodec(QTextCodec::codecForName("UTF-8"));
-    desktopSettings.beginGroup("Desktop Entry");
-
-    QString iconName = desktopSettings.value("Icon", "").toString();
-
-    desktopSettings.endGroup();
-    return QIcon::fromTheme(iconName);
-}
-
-QMap<QString, QIcon> Desktop::readOuputSlot() {
-    QString str;
-    QMap<QString, QIcon> desktopMap;
-    QFile file("/tmp/desktopprocess.txt");
-    QString output=cmd->readAllStandardOutput().data();
-
-    // 打开文件，不存在则创建
-    file.open(QIODevice::ReadWrite | QIODevice::Text);
-    file.write(output.toUtf8());
-    file.close();
-
-    file.open(QIODevice::ReadWrite | QIODevice::Text);
-    while (!file.atEnd()) {
-        QByteArray line = file.readLine();
-        str = line;
-        if(str.contains(".desktop:") && str.contains(":Exec")){
-            str = str.section(".desktop", 0, 0)+".desktop";
-            desktopMap.insert(desktopToName(str), desktopToIcon(str));
-        }
-    }
-    file.close();
-    file.remove();
-    return desktopMap;
-}
-
-void Desktop::readErrorSlot() {
-    qWarning() << "read desktop file name failed";
-}
-
 void Desktop::initPanelSetUI()
 {
     QFrame * panelSetupFrame = new QFrame();
@@ -27,7 +27,6 @@
 #include <QVector>
 #include <QPushButton>
 #include <QMap>
-#include <QProcess>
 #include <QtWidgets/QHBoxLayout>
 #include <QtWidgets/QComboBox>
 #include <QtWidgets/QHBoxLayout>
@@ -49,7 +48,7 @@ class Desktop;
 class Desktop : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "desktop.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -74,7 +73,6 @@ public:
 
 private:
     QMap<QString, QIcon> desktopConver(QString processName);
-    bool isFileExist(QString fullFileName);
 
 private:
     Ui::Desktop *ui;
@@ -102,8 +100,6 @@ private:
 
     QGSettings * dSettings;
 
-    QSharedPointer<QProcess> cmd;
-
     bool mFirstLoad;
     void initPanelSetUI();
     void initPanelSetItem();
@@ -131,10 +127,6 @@ private:
 private slots:
     void removeTrayItem(QString itemName);
     void addTrayItem(QGSettings * trayGSetting);
-    QString desktopToName(QString desktopfile);
-    QIcon   desktopToIcon(const QString &desktopfile);
-    QMap<QString, QIcon> readOuputSlot();
-    void readErrorSlot();
     void slotCloudAccout(const QString &key);
     void panelSizeComboboxChangedSlot(int );
     void panelPositionComboboxChangedSlot(int );
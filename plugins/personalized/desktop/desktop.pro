@@ -7,6 +7,7 @@
 include(../../../env.pri)
 include($$PROJECT_COMPONENTSOURCE/switchbutton.pri)
 include($$PROJECT_COMPONENTSOURCE/listdelegate.pri)
+include($$PROJECT_COMPONENTSOURCE/desktopentryindex.pri)
 
 QT       += widgets x11extras dbus
 
@@ -48,3 +49,6 @@ FORMS += \
         desktop.ui
 
 INSTALLS += target
+
+DISTFILES += \
+    desktop.json
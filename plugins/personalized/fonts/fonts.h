@@ -50,7 +50,7 @@ class Fonts;
 class Fonts : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "fonts.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -40,3 +40,6 @@ HEADERS += \
 
 FORMS += \
         fonts.ui
+
+DISTFILES += \
+    fonts.json
@@ -1,62 +0,0 @@
-/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
- *
- * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
- *
- * This program is free software; you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation; either version 2 of the License, or
- * (at your option) any later version.
- *
- * This program is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU General Public License for more details.
- *
- * You should have received a copy of the GNU General Public License
- * along with this program; if not, write to the Free Software
- * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
- *
- */
-#ifndef BGFILEPARSE_H
-#define BGFILEPARSE_H
-
-
-#include <QString>
-#include <QMap>
-
-class QXmlStreamReader;
-
-typedef struct _BgInfo{
-
-    QString status;
-    QString name;
-    QString i18nName;
-    QString artist;
-    QString filename;
-    QString option;
-    QString pColor;
-    QString sColor;
-    QString shadeType;
-
-}BgInfo;
-
-class BgFileParse
-{
-
-public:
-    explicit BgFileParse();
-    ~BgFileParse();
-
-
-public:
-
-    static QMap<QString, BgInfo> bgFileReader();
-    static void parseWallpaper(QXmlStreamReader &reader);
-
-
-//private:
-//    static QMap<QString, BgInfo> wholeBgInfo;
-
-};
-
-#endif // BGFILEPARSE_H
@@ -19,7 +19,6 @@
  */
 #include "screenlock.h"
 #include "ui_screenlock.h"
-#include "bgfileparse.h"
 #include "pictureunit.h"
 #include "MaskWidget/maskwidget.h"
 
@@ -211,41 +210,25 @@ void Screenlock::initScreenlockStatus(){
 //    MaskWidget * maskWidget = new MaskWidget(ui->previewLabel);
 //    maskWidget->setGeometry(0, 0, ui->previewLabel->width(), ui->previewLabel->height());
 
-    // 使用线程解析本地壁纸文件；获取壁纸单元
-    pThread = new QThread;
-    pWorker = new BuildPicUnitsWorker;
-    connect(pWorker, &BuildPicUnitsWorker::pixmapGeneral, this, [=](QPixmap pixmap, BgInfo bgInfo){
-        // 设置当前锁屏壁纸的预览
-        if (bgInfo.filename == bgStr){
-            ui->previewLabel->setPixmap(QPixmap(bgStr).scaled(ui->previewLabel->size()));
-        }
-
-        // 线程中构建控件传递会报告event无法install 的警告
-        PictureUnit * picUnit = new PictureUnit;
-        picUnit->setPixmap(pixmap);
-        picUnit->setFilenameText(bgInfo.filename);
-
-        connect(picUnit, &PictureUnit::clicked, [=](QString filename){
-            ui->previewLabel->setPixmap(QPixmap(filename).scaled(ui->previewLabel->size()));
-            lSetting->set(SCREENLOCK_BG_KEY, filename);
-            setLockBackground(loginbgSwitchBtn->isChecked());
-        });
-
-        flowLayout->addWidget(picUnit);
-    });
-    connect(pWorker, &BuildPicUnitsWorker::workerComplete, [=]{
-        pThread->quit(); // 退出事件循环
-        pThread->wait(); // 释放资源
-    });
-
-    pWorker->moveToThread(pThread);
-    connect(pThread, &QThread::started, pWorker, &BuildPicUnitsWorker::run);
-    connect(pThread, &QThread::finished, this, [=] {
-
+    // 缩略图在线程池中并行解码，按批插入布局
+    thumbnailLoader = new ThumbnailLoader(QSize(166, 110), pluginWidget);
+    connect(thumbnailLoader, &ThumbnailLoader::thumbnailsReady, this, &Screenlock::addPictures);
+    updateLoader = new ThumbnailLoader(QSize(166, 110), pluginWidget);
+    connect(updateLoader, &ThumbnailLoader::thumbnailsReady, this, &Screenlock::addPictures);
+    connect(updateLoader, &ThumbnailLoader::finished, this, [=]{
+        updateFiles.clear();
     });
-    connect(pThread, &QThread::finished, pWorker, &BuildPicUnitsWorker::deleteLater);
 
-    pThread->start();
+    // 壁纸目录与背景页共用，在后台解析，外部修改时重新构建，新增壁纸只追加对应缩略图
+    WallpaperCatalog * catalog = WallpaperCatalog::instance();
+    connect(catalog, &WallpaperCatalog::loaded, this, &Screenlock::loadPictures);
+    connect(catalog, &WallpaperCatalog::changed, this, &Screenlock::loadPictures);
+    connect(catalog, &WallpaperCatalog::wallpaperChanged, this, &Screenlock::updatePicture);
+    if (catalog->isLoaded()) {
+        loadPictures();
+    } else {
+        catalog->load();
+    }
 
     // 设置锁屏时间，屏保激活后多久锁定屏幕
     int lDelay = lSetting->get(SCREENLOCK_DELAY_KEY).toInt();
@@ -322,6 +305,57 @@ int Screenlock::lockConvertToSlider(const int value) {
     }
 }
 
+void Screenlock::loadPictures(){
+    updateLoader->cancel();
+    updateFiles.clear();
+    picUnitMap.clear();
+
+    QLayoutItem * item;
+    while ((item = flowLayout->takeAt(0)) != nullptr) {
+        delete item->widget();
+        delete item;
+    }
+
+    QStringList files;
+    for (const WallpaperInfo &info : WallpaperCatalog::instance()->wallpapers()){
+        files.append(info.filename);
+    }
+    thumbnailLoader->load(files);
+}
+
+void Screenlock::addPictures(const QStringList &files, const QList<QPixmap> &pixmaps){
+    ui->backgroundsWidget->setUpdatesEnabled(false);
+    for (int i = 0; i < files.size(); i++) {
+        if (picUnitMap.contains(files.at(i)))
+            continue;
+
+        PictureUnit * picUnit = new PictureUnit;
+        picUnit->setPixmap(pixmaps.at(i));
+        picUnit->setFilenameText(files.at(i));
+
+        connect(picUnit, &PictureUnit::clicked, [=](QString filename){
+            ui->previewLabel->setPixmap(QPixmap(filename).scaled(ui->previewLabel->size()));
+            lSetting->set(SCREENLOCK_BG_KEY, filename);
+            setLockBackground(loginbgSwitchBtn->isChecked());
+        });
+
+        flowLayout->addWidget(picUnit);
+        picUnitMap.insert(files.at(i), picUnit);
+    }
+    ui->backgroundsWidget->setUpdatesEnabled(true);
+}
+
+void Screenlock::updatePicture(const QString &filename){
+    // 锁屏背景不区分壁纸是否被删除，只需补上新增的壁纸
+    if (!WallpaperCatalog::instance()->contains(filename) || picUnitMap.contains(filename)
+            || updateFiles.contains(filename))
+        return;
+
+    // 重新加载会取消未完成的请求，已解码的缩略图有缓存
+    updateFiles.append(filename);
+    updateLoader->load(updateFiles);
+}
+
 void Screenlock::setLockBackground(bool status)
 {
     QString bgStr;
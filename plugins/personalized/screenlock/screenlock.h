@@ -24,7 +24,6 @@
 #include <QtPlugin>
 
 #include <QLabel>
-#include <QThread>
 #include <QGSettings>
 #include <QSettings>
 #include <QtDBus>
@@ -33,18 +32,20 @@
 #include "SwitchButton/switchbutton.h"
 #include "FlowLayout/flowlayout.h"
 #include "Uslider/uslider.h"
-
-#include "buildpicunitsworker.h"
+#include "ThumbnailLoader/thumbnailloader.h"
+#include "WallpaperCatalog/wallpapercatalog.h"
 
 
 namespace Ui {
 class Screenlock;
 }
 
+class PictureUnit;
+
 class Screenlock : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "screenlock.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -66,6 +67,9 @@ private:
     int convertToLocktime(const int value);
     int lockConvertToSlider(const int value);
     void setLockBackground(bool status);
+    void loadPictures();
+    void addPictures(const QStringList &files, const QList<QPixmap> &pixmaps);
+    void updatePicture(const QString &filename);
     bool getLockStatus();
     void connectToServer();
 
@@ -87,14 +91,17 @@ private:
 
     QSize lockbgSize;
 
-    QThread * pThread;
-
     QDBusInterface *m_cloudInterface;
     bool bIsCloudService;
 
     FlowLayout * flowLayout;
 
-    BuildPicUnitsWorker * pWorker;
+    ThumbnailLoader * thumbnailLoader;
+    // 单个壁纸增加时使用，不打断整体加载
+    ThumbnailLoader * updateLoader;
+    QStringList updateFiles;
+
+    QMap<QString, PictureUnit *> picUnitMap;
 
     bool mFirstLoad;
 public Q_SLOTS:
@@ -9,6 +9,8 @@ include($$PROJECT_COMPONENTSOURCE/switchbutton.pri)
 include($$PROJECT_COMPONENTSOURCE/flowlayout.pri)
 include($$PROJECT_COMPONENTSOURCE/maskwidget.pri)
 include($$PROJECT_COMPONENTSOURCE/uslider.pri)
+include($$PROJECT_COMPONENTSOURCE/thumbnailloader.pri)
+include($$PROJECT_COMPONENTSOURCE/wallpapercatalog.pri)
 
 QT       += widgets xml dbus
 
@@ -37,18 +39,15 @@ PKGCONFIG     += gsettings-qt \
 #DEFINES += QT_DEPRECATED_WARNINGS
 
 SOURCES += \
-        bgfileparse.cpp \
-        buildpicunitsworker.cpp \
         pictureunit.cpp \
-        screenlock.cpp \
-        xmlhandle.cpp
+        screenlock.cpp
 
 HEADERS += \
-        bgfileparse.h \
-        buildpicunitsworker.h \
         pictureunit.h \
-        screenlock.h \
-        xmlhandle.h
+        screenlock.h
 
 FORMS += \
         screenlock.ui
+
+DISTFILES += \
+    screenlock.json
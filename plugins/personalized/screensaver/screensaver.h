@@ -79,7 +79,7 @@ protected:
 class Screensaver : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "screensaver.json")
     Q_INTERFACES(CommonInterface)
 
 public:
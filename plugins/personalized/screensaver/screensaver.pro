@@ -43,3 +43,6 @@ HEADERS += \
 
 FORMS += \
         screensaver.ui
+
+DISTFILES += \
+    screensaver.json
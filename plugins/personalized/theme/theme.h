@@ -49,7 +49,7 @@ class Theme;
 class Theme : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "theme.json")
     Q_INTERFACES(CommonInterface)
 
 public:
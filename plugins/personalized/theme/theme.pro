@@ -47,3 +47,6 @@ HEADERS += \
 
 FORMS += \
     theme.ui
+
+DISTFILES += \
+    theme.json
@@ -55,7 +55,6 @@ Wallpaper::~Wallpaper()
         if (settingsCreate){
             delete bgsettings;
         }
-        delete xmlhandleObj;
     }
 }
 
@@ -90,8 +89,6 @@ QWidget *Wallpaper::get_plugin_ui() {
             setupConnect();
             initBgFormStatus();
         }
-        //构建xmlhandle对象
-        xmlhandleObj = new XmlHandle();
     }
     return pluginWidget;
 }
@@ -177,38 +174,25 @@ void Wallpaper::setupComponent(){
 }
 
 void Wallpaper::setupConnect(){
-    //使用线程构建本地壁纸文件；获取壁纸压缩QPixmap
-    pThread = new QThread;
-    pObject = new WorkerObject;
-    connect(pObject, &WorkerObject::pixmapGenerate, this, [=](QPixmap pixmap, QString filename){
-        PictureUnit * picUnit = new PictureUnit;
-        picUnit->setPixmap(pixmap);
-        picUnit->setFilenameText(filename);
-        connect(picUnit, &PictureUnit::clicked, [=](QString fn){
-//            ui->previewLabel->setPixmap(pixmap.scaled(ui->previewLabel->size()));
-            bgsettings->set(FILENAME, fn);
-            ui->previewStackedWidget->setCurrentIndex(PICTURE);
-        });
-
-        picFlowLayout->addWidget(picUnit);
-
-    });
-    connect(pObject, &WorkerObject::workComplete, this, [=](QMap<QString, QMap<QString, QString>> wpInfoMaps){
-        wallpaperinfosMap = wpInfoMaps;
-        pThread->quit(); //退出事件循环
-        pThread->wait(); //释放资源
-    });
-
-    pObject->moveToThread(pThread);
-    connect(pThread, &QThread::started, pObject, &WorkerObject::run);
-    connect(pThread, &QThread::finished, this, [=](){
-
-
+    //缩略图在线程池中并行解码，按批插入布局
+    thumbnailLoader = new ThumbnailLoader(QSize(166, 110), pluginWidget);
+    connect(thumbnailLoader, &ThumbnailLoader::thumbnailsReady, this, &Wallpaper::addPictures);
+    updateLoader = new ThumbnailLoader(QSize(166, 110), pluginWidget);
+    connect(updateLoader, &ThumbnailLoader::thumbnailsReady, this, &Wallpaper::addPictures);
+    connect(updateLoader, &ThumbnailLoader::finished, this, [=]{
+        updateFiles.clear();
     });
 
-    connect(pThread, &QThread::finished, pObject, &WorkerObject::deleteLater);
-
-    pThread->start();
+    //壁纸目录在后台解析，外部修改时重新构建，单个壁纸增删只更新对应缩略图
+    WallpaperCatalog * catalog = WallpaperCatalog::instance();
+    connect(catalog, &WallpaperCatalog::loaded, this, &Wallpaper::loadPictures);
+    connect(catalog, &WallpaperCatalog::changed, this, &Wallpaper::loadPictures);
+    connect(catalog, &WallpaperCatalog::wallpaperChanged, this, &Wallpaper::updatePicture);
+    if (catalog->isLoaded()) {
+        loadPictures();
+    } else {
+        catalog->load();
+    }
 
 
     connect(ui->browserLocalwpBtn, &QPushButton::clicked, [=]{
@@ -373,6 +357,66 @@ void Wallpaper::initPreviewStatus(){
     }
 }
 
+void Wallpaper::loadPictures(){
+    updateLoader->cancel();
+    updateFiles.clear();
+    picUnitMap.clear();
+
+    QLayoutItem * item;
+    while ((item = picFlowLayout->takeAt(0)) != nullptr) {
+        delete item->widget();
+        delete item;
+    }
+
+    QStringList files;
+    for (const WallpaperInfo &info : WallpaperCatalog::instance()->wallpapers()){
+        //跳过被删除的壁纸
+        if (info.deleted)
+            continue;
+
+        files.append(info.filename);
+    }
+    thumbnailLoader->load(files);
+}
+
+void Wallpaper::addPictures(const QStringList &files, const QList<QPixmap> &pixmaps){
+    ui->picListWidget->setUpdatesEnabled(false);
+    for (int i = 0; i < files.size(); i++) {
+        //加载期间已被删除或已有缩略图
+        WallpaperInfo info = WallpaperCatalog::instance()->wallpaper(files.at(i));
+        if (info.deleted || picUnitMap.contains(files.at(i)))
+            continue;
+
+        PictureUnit * picUnit = new PictureUnit;
+        picUnit->setPixmap(pixmaps.at(i));
+        picUnit->setFilenameText(files.at(i));
+        connect(picUnit, &PictureUnit::clicked, [=](QString fn){
+            bgsettings->set(FILENAME, fn);
+            ui->previewStackedWidget->setCurrentIndex(PICTURE);
+        });
+
+        picFlowLayout->addWidget(picUnit);
+        picUnitMap.insert(files.at(i), picUnit);
+    }
+    ui->picListWidget->setUpdatesEnabled(true);
+}
+
+void Wallpaper::updatePicture(const QString &filename){
+    WallpaperCatalog * catalog = WallpaperCatalog::instance();
+    bool visible = catalog->contains(filename) && !catalog->wallpaper(filename).deleted;
+
+    PictureUnit * picUnit = picUnitMap.value(filename);
+    if (!visible && picUnit) {
+        picUnitMap.remove(filename);
+        picFlowLayout->removeWidget(picUnit);
+        picUnit->deleteLater();
+    } else if (visible && !picUnit && !updateFiles.contains(filename)) {
+        //重新加载会取消未完成的请求，已解码的缩略图有缓存
+        updateFiles.append(filename);
+        updateLoader->load(updateFiles);
+    }
+}
+
 //自定义颜色面板选定颜色
 void Wallpaper::colorSelectedSlot(QColor color){
     qDebug() << "colorSelectedSlot" << color << color.name();
@@ -388,18 +432,9 @@ void Wallpaper::colorSelectedSlot(QColor color){
 }
 
 void Wallpaper::wpOptionsChangedSlot(QString op){
-    //获取当前选中的壁纸
-//    QListWidgetItem * currentitem = ui->listWidget->currentItem();
-//    QString filename = currentitem->data(Qt::UserRole).toString();
-
-
-    //更新xml数据
-//    if (wallpaperinfosMap.contains(filename)){
-//        wallpaperinfosMap[filename]["options"] = op;
-//    }
-
-    //将改动保存至文件
-    xmlhandleObj->xmlUpdate(wallpaperinfosMap);
+    //当前使用的壁纸即选中的壁纸，更新壁纸目录，由目录负责写回
+    QString filename = bgsettings->get(FILENAME).toString();
+    WallpaperCatalog::instance()->setOptions(filename, op);
 }
 
 void Wallpaper::setlistview(){
@@ -414,22 +449,19 @@ void Wallpaper::setlistview(){
 }
 
 void Wallpaper::setModeldata(){
-    QMap<QString, QMap<QString, QString> >::iterator iters = wallpaperinfosMap.begin();
-    for (int row = 0; iters != wallpaperinfosMap.end(); iters++, row++){
-        if (QString(iters.key()) == "head") //跳过xml的头部信息
-            continue;
-        QMap<QString, QString> wpMap = (QMap<QString, QString>)iters.value();
-        QString delstatus = QString(wpMap.find("deleted").value());
-        if (delstatus == "true") //跳过被删除的壁纸
+    int row = 0;
+    for (const WallpaperInfo &info : WallpaperCatalog::instance()->wallpapers()){
+        if (info.deleted) //跳过被删除的壁纸
             continue;
 
-        QString filename = QString(iters.key());
+        QString filename = info.filename;
         QPixmap pixmap(filename);
 
         wpListModel.insertRows(row, 1, QModelIndex());
         QModelIndex wpindex = wpListModel.index(row, 0, QModelIndex());
         wpListModel.setData(wpindex, QIcon(pixmap.scaled(QSize(160,100))), Qt::DecorationRole);
-        wpListModel.setData(wpindex, QString("%1\nfolder: %2\n").arg(wpMap.find("name").value()).arg(filename), Qt::ToolTipRole);
+        wpListModel.setData(wpindex, QString("%1\nfolder: %2\n").arg(info.name).arg(filename), Qt::ToolTipRole);
+        row++;
     }
 }
 
@@ -509,23 +541,15 @@ void Wallpaper::add_custom_wallpaper(){
     QPixmap pixmap = QPixmap(selectedfile).scaled(IMAGE_SIZE);
 //    append_item(pixmap, selectedfile);
 
-    if (wallpaperinfosMap.contains(selectedfile)){
-        wallpaperinfosMap[selectedfile]["deleted"] = "false";
-    }
-    else{
-        QMap<QString, QString> tmpinfo;
-        tmpinfo.insert("artist", "(none)");
-        tmpinfo.insert("deleted", "false");
-        tmpinfo.insert("filename", selectedfile);
-        tmpinfo.insert("name", selectedfile.split("/").last());
-        tmpinfo.insert("options", "zoom");
-        tmpinfo.insert("pcolor", "#000000");
-        tmpinfo.insert("scolor", "#000000");
-        tmpinfo.insert("shade_type", "solid");
-        wallpaperinfosMap.insert(selectedfile, tmpinfo);
-
-    }
-    xmlhandleObj->xmlUpdate(wallpaperinfosMap);
+    WallpaperInfo info;
+    info.artist = "(none)";
+    info.filename = selectedfile;
+    info.name = selectedfile.split("/").last();
+    info.options = "zoom";
+    info.pColor = "#000000";
+    info.sColor = "#000000";
+    info.shadeType = "solid";
+    WallpaperCatalog::instance()->addWallpaper(info);
 
     if (picWpItemMap.contains(selectedfile)){
 //        ui->listWidget->setCurrentItem(picWpItemMap.find(selectedfile).value());
@@ -538,9 +562,9 @@ void Wallpaper::del_wallpaper(){
 //    QListWidgetItem * currentitem = ui->listWidget->currentItem();
 //    QString filename = currentitem->data(Qt::UserRole).toString();
 
-    //更新xml数据
-//    if (wallpaperinfosMap.contains(filename)){
-//        wallpaperinfosMap[filename]["deleted"] = "true";
+    //更新壁纸目录，由目录负责写回
+//    if (WallpaperCatalog::instance()->contains(filename)){
+//        WallpaperCatalog::instance()->setDeleted(filename, true);
 
 //        int row = ui->listWidget->row(currentitem);
 
@@ -552,6 +576,4 @@ void Wallpaper::del_wallpaper(){
 
 //    }
 
-//    将改动保存至文件
-    xmlhandleObj->xmlUpdate(wallpaperinfosMap);
 }
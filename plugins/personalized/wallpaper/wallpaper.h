@@ -23,7 +23,6 @@
 #include <QObject>
 #include <QtPlugin>
 
-#include <QThread>
 #include <QPixmap>
 #include <QListWidgetItem>
 #include <QFileDialog>
@@ -35,10 +34,9 @@
 #include "FlowLayout/flowlayout.h"
 #include "HoverWidget/hoverwidget.h"
 #include "ImageUtil/imageutil.h"
-#include "xmlhandle.h"
+#include "ThumbnailLoader/thumbnailloader.h"
+#include "WallpaperCatalog/wallpapercatalog.h"
 #include "component/custdomitemmodel.h"
-#include "simplethread.h"
-#include "workerobject.h"
 #include "colordialog.h"
 
 /* qt会将glib里的signals成员识别为宏，所以取消该宏
@@ -68,10 +66,12 @@ namespace Ui {
 class Wallpaper;
 }
 
+class PictureUnit;
+
 class Wallpaper : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "wallpaper.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -95,6 +95,9 @@ public:
     void showLocalWpDialog();
 
     void showComponent(int index);
+    void loadPictures();
+    void addPictures(const QStringList &files, const QList<QPixmap> &pixmaps);
+    void updatePicture(const QString &filename);
 
 private:
     Ui::Wallpaper *ui;
@@ -111,9 +114,6 @@ private:
 
 private:
 
-    QMap<QString, QMap<QString, QString> > wallpaperinfosMap;
-
-    XmlHandle * xmlhandleObj;
     ColorDialog * colordialog;
     QGSettings * bgsettings;
     QString localwpconf;
@@ -126,8 +126,12 @@ private:
     void setModeldata();
 
 private:
-    QThread * pThread;
-    WorkerObject * pObject;
+    ThumbnailLoader * thumbnailLoader;
+    // 单个壁纸增加时使用，不打断整体加载
+    ThumbnailLoader * updateLoader;
+    QStringList updateFiles;
+
+    QMap<QString, PictureUnit *> picUnitMap;
 
     QMap<QString, QListWidgetItem*> picWpItemMap;
 
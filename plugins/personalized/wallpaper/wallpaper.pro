@@ -9,6 +9,8 @@ include($$PROJECT_COMPONENTSOURCE/maskwidget.pri)
 include($$PROJECT_COMPONENTSOURCE/imageutil.pri)
 include($$PROJECT_COMPONENTSOURCE/hoverwidget.pri)
 include($$PROJECT_COMPONENTSOURCE/closebutton.pri)
+include($$PROJECT_COMPONENTSOURCE/thumbnailloader.pri)
+include($$PROJECT_COMPONENTSOURCE/wallpapercatalog.pri)
 
 QT       += widgets xml dbus
 
@@ -42,10 +44,7 @@ SOURCES += \
     gradientslider.cpp \
     pictureunit.cpp \
     wallpaper.cpp \
-    xmlhandle.cpp \
-    component/custdomitemmodel.cpp \
-    simplethread.cpp \
-    workerobject.cpp
+    component/custdomitemmodel.cpp
 
 HEADERS += \
     colordialog.h \
@@ -54,11 +53,11 @@ HEADERS += \
     gradientslider.h \
     pictureunit.h \
     wallpaper.h \
-    xmlhandle.h \
-    component/custdomitemmodel.h \
-    simplethread.h \
-    workerobject.h
+    component/custdomitemmodel.h
 
 FORMS += \
     colordialog.ui \
     wallpaper.ui
+
+DISTFILES += \
+    wallpaper.json
@@ -32,7 +32,7 @@ class Backup;
 class Backup : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "backup.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -36,3 +36,6 @@ HEADERS += \
 
 FORMS += \
         backup.ui
+
+DISTFILES += \
+    backup.json
@@ -60,7 +60,7 @@ Q_SIGNALS:
 class SecurityCenter : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "securitycenter.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -27,3 +27,6 @@ HEADERS += \
 
 FORMS += \
     securitycenter.ui
+
+DISTFILES += \
+    securitycenter.json
@@ -37,7 +37,7 @@ class Update;
 class Update : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "update.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -29,3 +29,6 @@ HEADERS += \
 
 FORMS += \
     update.ui
+
+DISTFILES += \
+    update.json
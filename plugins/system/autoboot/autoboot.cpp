@@ -23,6 +23,7 @@
 #include "HoverWidget/hoverwidget.h"
 #include "ImageUtil/imageutil.h"
 #include "autobootworker.h"
+#include "DesktopEntryIndex/desktopentryindex.h"
 
 #include <QThread>
 #include <QSignalMapper>
@@ -344,6 +345,7 @@ bool AutoBoot::_delete_local_autoapp(QString bname){
     }
 
     //更新数据
+    DesktopEntryIndex::instance()->reload(QString::fromUtf8(dstpath));
     localappMaps.remove(bname);
 
     QMap<QString, AutoApp>::iterator updateit = statusMaps.find(bname);
@@ -511,105 +513,53 @@ gboolean AutoBoot::_key_file_to_file(GKeyFile *keyfile, const gchar *path){
     if (werror)
         return FALSE;
 
+    // 不等待inotify，随后的刷新即可读到新内容
+    DesktopEntryIndex::instance()->reload(QString::fromUtf8(path));
+
     return res;
 
 }
 
-gboolean AutoBoot::_key_file_get_shown(GKeyFile *keyfile, const char *currentdesktop){
-    char ** only_show_in, ** not_show_in;
-    gboolean found;
-
+bool AutoBoot::_entry_shown(const DesktopEntry &entry, const char *currentdesktop){
     if (!currentdesktop)
-        return TRUE;
-
-    only_show_in = g_key_file_get_string_list(keyfile, G_KEY_FILE_DESKTOP_GROUP,
-                                              G_KEY_FILE_DESKTOP_KEY_ONLY_SHOW_IN, NULL, NULL);
-    if (only_show_in){
-        found = FALSE;
-        for (int i = 0; only_show_in[i] != NULL; i++){
-            if (g_strcmp0(currentdesktop, only_show_in[i]) == 0){
-                found = TRUE;
-                break;
-            }
-        }
-        g_strfreev(only_show_in);
-        if (!found)
-            return FALSE;
-    }
-
-    not_show_in = g_key_file_get_string_list(keyfile, G_KEY_FILE_DESKTOP_GROUP,
-                                             G_KEY_FILE_DESKTOP_KEY_NOT_SHOW_IN, NULL, NULL);
-    if (not_show_in){
-        found = FALSE;
-        for (int i = 0; not_show_in[i] != NULL; i++){
-            if (g_strcmp0(currentdesktop, not_show_in[i]) == 0){
-                found = TRUE;
-                break;
-            }
-        }
-        g_strfreev(not_show_in);
-        if (found)
-            return FALSE;
-    }
-
-    return TRUE;
-}
+        return true;
 
-gboolean AutoBoot::_key_file_get_boolean(GKeyFile *keyfile, const gchar *key, gboolean defaultvalue){
-    GError * error;
-    gboolean retval;
+    QString desktop = QString::fromUtf8(currentdesktop);
+    if (!entry.onlyShowIn.isEmpty() && !entry.onlyShowIn.contains(desktop))
+        return false;
 
-    error = NULL;
-    retval = g_key_file_get_boolean(keyfile, G_KEY_FILE_DESKTOP_GROUP, key, &error);
+    if (entry.notShowIn.contains(desktop))
+        return false;
 
-    if (error != NULL){
-        retval = defaultvalue;
-        g_error_free(error);
-    }
-    return retval;
+    return true;
 }
 
 AutoApp AutoBoot::_app_new(const char *path){
+    return _app_from_entry(DesktopEntryIndex::instance()->reload(QString::fromUtf8(path)));
+}
+
+AutoApp AutoBoot::_app_from_entry(const DesktopEntry &entry){
     AutoApp app;
-    GKeyFile * keyfile;
-    char * bname, * obpath, *name, * comment, * exec, * icon;
-    bool  hidden, no_display, enable, shown;
 
     app.bname = "";
-    keyfile = g_key_file_new();
-    if (!g_key_file_load_from_file(keyfile, path, G_KEY_FILE_NONE, NULL)){
-        g_key_file_free (keyfile);
+    if (!entry.isValid())
         return app;
-    }
-
-    bname = g_path_get_basename(path);
-    obpath = g_strdup(path);
-    hidden = _key_file_get_boolean(keyfile, G_KEY_FILE_DESKTOP_KEY_HIDDEN, FALSE);
-    no_display = _key_file_get_boolean(keyfile, G_KEY_FILE_DESKTOP_KEY_NO_DISPLAY, FALSE);
-//    enable = _key_file_get_boolean(keyfile, APP_KEY_FILE_DESKTOP_KEY_AUTOSTART_ENABLE, TRUE);
-    shown = _key_file_get_shown(keyfile, g_getenv("XDG_CURRENT_DESKTOP"));
-    name = g_key_file_get_locale_string(keyfile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_NAME, NULL, NULL);
-    comment = g_key_file_get_locale_string(keyfile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_COMMENT, NULL, NULL);
-    exec = g_key_file_get_string(keyfile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_EXEC, NULL);    
-    icon = g_key_file_get_locale_string(keyfile, G_KEY_FILE_DESKTOP_GROUP, G_KEY_FILE_DESKTOP_KEY_ICON, NULL, NULL);
 
-    app.bname = QString::fromUtf8(bname);
-    app.path = QString::fromUtf8(obpath);
+    app.bname = entry.id;
+    app.path = entry.path;
 
-    app.hidden = hidden;
-    app.no_display = no_display;
-    app.shown = shown;
-//    app.enable = enable;
+    app.hidden = entry.hidden;
+    app.no_display = entry.noDisplay;
+    app.shown = _entry_shown(entry, g_getenv("XDG_CURRENT_DESKTOP"));
 
-    app.name = QString::fromUtf8(name);
-    app.comment = QString::fromUtf8(comment);
-    app.exec = QString::fromUtf8(exec);
+    app.name = entry.name;
+    app.comment = entry.comment;
+    app.exec = entry.exec;
 
-    QFileInfo iconfile(static_cast<QString>(icon));
+    QFileInfo iconfile(entry.icon);
 
-
-    if (!QString(icon).isEmpty() && QIcon::hasThemeIcon(QString(icon))){
-        QIcon currenticon = QIcon::fromTheme(QString(icon));
+    if (!entry.icon.isEmpty() && QIcon::hasThemeIcon(entry.icon)){
+        QIcon currenticon = QIcon::fromTheme(entry.icon);
         app.pixmap = currenticon.pixmap(QSize(32, 32));
     }  else if (iconfile.exists()) {
         app.pixmap = QPixmap(iconfile.filePath()).scaled(32, 32);
@@ -617,59 +567,28 @@ AutoApp AutoBoot::_app_new(const char *path){
         app.pixmap = QPixmap(QString(":/img/plugins/autoboot/desktop.png"));
     }
 
-    g_free(bname);
-    g_free(obpath);
-    g_key_file_free(keyfile);
-
     return app;
 }
 
 void AutoBoot::_walk_config_dirs(){
-    const char * const * systemconfigdirs;
-    GDir * dir;
-    const char * name;
+    DesktopEntryIndex * index = DesktopEntryIndex::instance();
 
     appMaps.clear();
-
-    systemconfigdirs = g_get_system_config_dirs(); //获取系统配置目录
-    for (int i = 0; systemconfigdirs[i]; i++){
-        char * path;
-        path = g_build_filename(systemconfigdirs[i], "autostart", NULL);
-        dir = g_dir_open(path, 0, NULL);
-        if (!dir)
-            continue;
-        while ((name = g_dir_read_name(dir))) {
-            AutoApp app;
-            char * desktopfilepath;
-            if (!g_str_has_suffix(name, ".desktop"))
-                continue;
-            desktopfilepath = g_build_filename(path, name, NULL);
-            app = _app_new(desktopfilepath);
-//            if (app.bname == "" || app.hidden || app.no_display || !app.shown ||
-//                    app.exec == "/usr/bin/ukui-settings-daemon") //gtk控制面板屏蔽ukui-settings-daemon,猜测禁止用户关闭
-//                continue;
-            app.xdg_position = SYSTEMPOS;
-            appMaps.insert(app.bname, app);
-            g_free (desktopfilepath);
-        }
-        g_dir_close(dir);
+    //系统配置目录下的autostart
+    for (const DesktopEntry &entry : index->autostartEntries(DesktopEntryIndex::SystemAutostart)) {
+        AutoApp app = _app_from_entry(entry);
+//        if (app.bname == "" || app.hidden || app.no_display || !app.shown ||
+//                app.exec == "/usr/bin/ukui-settings-daemon") //gtk控制面板屏蔽ukui-settings-daemon,猜测禁止用户关闭
+//            continue;
+        app.xdg_position = SYSTEMPOS;
+        appMaps.insert(app.bname, app);
     }
 
     localappMaps.clear();
-    dir = g_dir_open(localconfigdir, 0, NULL);
-    if (dir){
-        while ((name = g_dir_read_name(dir))) {
-            AutoApp localapp;
-            char * localdesktopfilepath;
-            if (!g_str_has_suffix(name, ".desktop"))
-                continue;
-            localdesktopfilepath = g_build_filename(localconfigdir, name, NULL);
-            localapp = _app_new(localdesktopfilepath);
-            localapp.xdg_position = LOCALPOS;
-            localappMaps.insert(localapp.bname, localapp); 
-            g_free(localdesktopfilepath);
-        }
-        g_dir_close(dir);
+    for (const DesktopEntry &entry : index->autostartEntries(DesktopEntryIndex::UserAutostart)) {
+        AutoApp localapp = _app_from_entry(entry);
+        localapp.xdg_position = LOCALPOS;
+        localappMaps.insert(localapp.bname, localapp);
     }
     update_app_status();
 }
@@ -27,6 +27,7 @@
 #include "datadefined.h"
 #include "addautoboot.h"
 #include "HoverWidget/hoverwidget.h"
+#include "DesktopEntryIndex/desktopentryindex.h"
 #include <QtDBus>
 
 namespace Ui {
@@ -36,7 +37,7 @@ class AutoBoot;
 class AutoBoot : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "autoboot.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -61,8 +62,8 @@ private:
 
     void _walk_config_dirs();
     AutoApp _app_new(const char * path);
-    gboolean _key_file_get_boolean(GKeyFile * keyfile, const gchar * key, gboolean defaultvalue);
-    gboolean _key_file_get_shown(GKeyFile * keyfile, const char * currentdesktop);
+    AutoApp _app_from_entry(const DesktopEntry &entry);
+    bool _entry_shown(const DesktopEntry &entry, const char * currentdesktop);
     bool _stop_autoapp(QString bname);
     bool _delete_autoapp(QString bname);
     bool _enable_autoapp(QString bname, bool status);
@@ -8,6 +8,7 @@ include($$PROJECT_COMPONENTSOURCE/switchbutton.pri)
 include($$PROJECT_COMPONENTSOURCE/hoverwidget.pri)
 include($$PROJECT_COMPONENTSOURCE/imageutil.pri)
 include($$PROJECT_COMPONENTSOURCE/closebutton.pri)
+include($$PROJECT_COMPONENTSOURCE/desktopentryindex.pri)
 
 QT       += widgets svg dbus
 TEMPLATE = lib
@@ -45,3 +46,6 @@ HEADERS += \
 FORMS += \
     autoboot.ui \
     addautoboot.ui
+
+DISTFILES += \
+    autoboot.json
@@ -23,6 +23,7 @@
 #include "defaultapp.h"
 #include "ui_defaultapp.h"
 #include "addappdialog.h"
+#include "DesktopEntryIndex/desktopentryindex.h"
 
 #define BROWSERTYPE "x-scheme-handler/http"
 #define MAILTYPE    "x-scheme-handler/mailto"
@@ -31,8 +32,6 @@
 #define VIDEOTYPE   "video/x-ogm+ogg"
 #define TEXTTYPE    "text/plain"
 
-#define DESKTOPPATH "/usr/share/applications/"
-
 DefaultApp::DefaultApp() {
     pluginName = tr("Default App");
     pluginType = SYSTEM;
@@ -120,12 +119,9 @@ void DefaultApp::initUI() {
         if (list) {
             for (int i = 0; list[i].appid != NULL; i++) {
                 QString single(list[i].appid);
-                QByteArray ba = QString(DESKTOPPATH + single).toUtf8();
-                GDesktopAppInfo * browserinfo = g_desktop_app_info_new_from_filename(ba.constData());
-                QString appname = g_app_info_get_name(G_APP_INFO(browserinfo));
-                const char * iconname = g_icon_to_string(g_app_info_get_icon(G_APP_INFO(browserinfo)));
-                QIcon appicon;
-                appicon = QIcon::fromTheme(QString(iconname));
+                DesktopEntry entry = DesktopEntryIndex::instance()->application(single);
+                QString appname = entry.name;
+                QIcon appicon = QIcon::fromTheme(entry.icon);
 
                 ui->browserComBoBox->addItem(appicon, appname, single);
                 if (currentbrowser == single) {
@@ -148,12 +144,9 @@ void DefaultApp::initUI() {
         if (maillist) {
             for (int i = 0; maillist[i].appid != NULL; i++) {
                 QString single(maillist[i].appid);
-                QByteArray ba = QString(DESKTOPPATH + single).toUtf8();
-                GDesktopAppInfo * mailinfo = g_desktop_app_info_new_from_filename(ba.constData());
-                QString appname = g_app_info_get_name(G_APP_INFO(mailinfo));
-                const char * iconname = g_icon_to_string(g_app_info_get_icon(G_APP_INFO(mailinfo)));
-                QIcon appicon;
-                appicon = QIcon::fromTheme(QString(iconname));
+                DesktopEntry entry = DesktopEntryIndex::instance()->application(single);
+                QString appname = entry.name;
+                QIcon appicon = QIcon::fromTheme(entry.icon);
 
                 ui->mailComBoBox->addItem(appicon, appname, single);
                 if (currentmail == single) {
@@ -181,12 +174,9 @@ void DefaultApp::initUI() {
         if (imagelist) {
             for (int i = 0; imagelist[i].appid != NULL; i++) {
                 QString single(imagelist[i].appid);
-                QByteArray ba = QString(DESKTOPPATH + single).toUtf8();
-                GDesktopAppInfo * imageinfo = g_desktop_app_info_new_from_filename(ba.constData());
-                QString appname = g_app_info_get_name(G_APP_INFO(imageinfo));
-                const char * iconname = g_icon_to_string(g_app_info_get_icon(G_APP_INFO(imageinfo)));
-                QIcon appicon;
-                appicon = QIcon::fromTheme(QString(iconname));
+                DesktopEntry entry = DesktopEntryIndex::instance()->application(single);
+                QString appname = entry.name;
+                QIcon appicon = QIcon::fromTheme(entry.icon);
 
                 if(!browserList.contains(appname)){
                     ui->imageComBoBox->addItem(appicon, appname, single);
@@ -214,12 +204,9 @@ void DefaultApp::initUI() {
         if (audiolist) {
             for (int i = 0; audiolist[i].appid != NULL; i++) {
                 QString single(audiolist[i].appid);
-                QByteArray ba = QString(DESKTOPPATH + single).toUtf8();
-                GDesktopAppInfo * audioinfo = g_desktop_app_info_new_from_filename(ba.constData());
-                QString appname = g_app_info_get_name(G_APP_INFO(audioinfo));
-                const char * iconname = g_icon_to_string(g_app_info_get_icon(G_APP_INFO(audioinfo)));
-                QIcon appicon;
-                appicon = QIcon::fromTheme(QString(iconname));
+                DesktopEntry entry = DesktopEntryIndex::instance()->application(single);
+                QString appname = entry.name;
+                QIcon appicon = QIcon::fromTheme(entry.icon);
 
                 ui->audioComBoBox->addItem(appicon, appname, single);
                 if (currentaudio == single) {
@@ -242,12 +229,9 @@ void DefaultApp::initUI() {
         if (videolist) {
             for (int i = 0; videolist[i].appid != NULL; i++) {
                 QString single(videolist[i].appid);
-                QByteArray ba = QString(DESKTOPPATH + single).toUtf8();
-                GDesktopAppInfo * videoinfo = g_desktop_app_info_new_from_filename(ba.constData());
-                QString appname = g_app_info_get_name(G_APP_INFO(videoinfo));
-                const char * iconname = g_icon_to_string(g_app_info_get_icon(G_APP_INFO(videoinfo)));
-                QIcon appicon;
-                appicon = QIcon::fromTheme(QString(iconname));
+                DesktopEntry entry = DesktopEntryIndex::instance()->application(single);
+                QString appname = entry.name;
+                QIcon appicon = QIcon::fromTheme(entry.icon);
 
                 ui->videoComBoBox->addItem(appicon, appname, single);
                 if (currentvideo == single) {
@@ -270,12 +254,9 @@ void DefaultApp::initUI() {
         if (textlist){
             for (int i = 0; textlist[i].appid != NULL; i++) {
                 QString single(textlist[i].appid);
-                QByteArray ba = QString(DESKTOPPATH + single).toUtf8();
-                GDesktopAppInfo * textinfo = g_desktop_app_info_new_from_filename(ba.constData());
-                QString appname = g_app_info_get_name(G_APP_INFO(textinfo));
-                const char * iconname = g_icon_to_string(g_app_info_get_icon(G_APP_INFO(textinfo)));
-                QIcon appicon;
-                appicon = QIcon::fromTheme(QString(iconname));
+                DesktopEntry entry = DesktopEntryIndex::instance()->application(single);
+                QString appname = entry.name;
+                QIcon appicon = QIcon::fromTheme(entry.icon);
 
                 ui->textComBoBox->addItem(appicon, appname, single);
                 if (currenttext == single) {
@@ -58,7 +58,7 @@ class DefaultAppWindow;
 class DefaultApp : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "defaultapp.json")
     Q_INTERFACES(CommonInterface)
 
 public:
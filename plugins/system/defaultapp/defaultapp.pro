@@ -5,6 +5,8 @@
 #-------------------------------------------------
 
 include(../../../env.pri)
+include($$PROJECT_COMPONENTSOURCE/desktopentryindex.pri)
+
 QT            += widgets dbus concurrent
 TEMPLATE = lib
 CONFIG        += plugin
@@ -21,6 +23,7 @@ PKGCONFIG     += gio-2.0 \
                  gio-unix-2.0
 
 INCLUDEPATH   +=  \
+                 $$PROJECT_COMPONENTSOURCE \
                  $$PROJECT_ROOTDIR \
 
 #LIBS          += -L$$[QT_INSTALL_LIBS] -ldefaultprograms \
@@ -38,3 +41,6 @@ HEADERS += \
 FORMS += \
     defaultapp.ui \
     addappdialog.ui
+
+DISTFILES += \
+    defaultapp.json
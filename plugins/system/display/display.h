@@ -34,7 +34,7 @@ class DisplayWindow;
 
 class DisplaySet : public QObject, CommonInterface{
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "display.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -66,3 +66,6 @@ FORMS += \
 
 RESOURCES += \
     qml.qrc
+
+DISTFILES += \
+    display.json
@@ -37,7 +37,7 @@ class Power;
 
 class Power : public QObject, CommonInterface {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "power.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -30,3 +30,6 @@ HEADERS += \
 
 SOURCES += \
     power.cpp
+
+DISTFILES += \
+    power.json
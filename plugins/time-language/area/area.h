@@ -54,7 +54,7 @@ class Area;
 class Area : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "area.json")
     Q_INTERFACES(CommonInterface)
 
 public:
@@ -45,3 +45,6 @@ HEADERS += \
 FORMS += \
         area.ui \
         dataformat.ui
+
+DISTFILES += \
+    area.json
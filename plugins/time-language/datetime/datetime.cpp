@@ -25,14 +25,7 @@
 #include <QDir>
 #include <QDesktopWidget>
 
-#include <locale.h>
-#include <libintl.h>
-
-const char kTimezoneDomain[] = "installer-timezones";
-const char kDefaultLocale[] = "en_US.UTF-8";
-
-const QString kcnBj = "北京";
-const QString kenBj = "Asia/Beijing";
+#include "worldMap/timezonecatalog.h"
 
 #define FORMAT_SCHEMA   "org.ukui.control-center.panel.plugins"
 #define TIME_FORMAT_KEY "hoursystem"
@@ -93,8 +86,7 @@ DateTime::DateTime() {
     connect(m_timezone, &TimeZoneChooser::confirmed, this, [this] (const QString &timezone) {
         changezone_slot(timezone);
         m_timezone->hide();
-        const QString locale = QLocale::system().name();
-        QString localizedTimezone = m_zoneinfo->getLocalTimezoneName(timezone, locale);
+        QString localizedTimezone = TimezoneCatalog::instance()->localizedName(timezone);
         ui->timezoneLabel->setText(localizedTimezone);
     });
     connect(ui->synsystimeBtn,SIGNAL(clicked()),this,SLOT(rsync_with_network_slot()));
@@ -337,26 +329,5 @@ void DateTime::connectGSetting() {
 }
 
 QString DateTime::getLocalTimezoneName(QString timezone, QString locale) {
-
-    (void) setlocale(LC_ALL, QString(locale + ".UTF-8").toStdString().c_str());
-    const QString local_name(dgettext(kTimezoneDomain,
-                                      timezone.toStdString().c_str()));
-    int index = local_name.lastIndexOf('/');
-    if (index == -1) {
-      // Some translations of locale name contains non-standard char.
-      index = local_name.lastIndexOf("∕");
-    }
-
-    // Reset locale.
-    (void) setlocale(LC_ALL, kDefaultLocale);
-
-    if ("Asia/Shanghai" == timezone) {
-        if (QLocale::system().name() == "zh_CN") {
-            return kcnBj;
-        } else {
-            return kenBj;
-        }
-    }
-
-    return (index > -1) ? local_name.mid(index + 1) : local_name;
+    return TimezoneCatalog::translate(timezone, locale);
 }
@@ -64,7 +64,7 @@ class DateTime;
 class DateTime : public QObject, CommonInterface
 {
     Q_OBJECT
-    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface")
+    Q_PLUGIN_METADATA(IID "org.kycc.CommonInterface" FILE "datetime.json")
     Q_INTERFACES(CommonInterface)
 
 public:
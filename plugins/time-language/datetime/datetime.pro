@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += widgets dbus x11extras
+QT       += widgets dbus x11extras concurrent
 
 TEMPLATE = lib
 CONFIG += plugin \
@@ -38,6 +38,8 @@ SOURCES += \
     datetime.cpp \
     changtime.cpp \
     worldMap/zoneinfo.cpp \
+    worldMap/timezonecatalog.cpp \
+    worldMap/zonegrid.cpp \
     worldMap/toolpop.cpp \
     worldMap/timezonemap.cpp \
     worldMap/timezonechooser.cpp \
@@ -48,6 +50,8 @@ HEADERS += \
     datetime.h \
     changtime.h \
     worldMap/zoneinfo.h \
+    worldMap/timezonecatalog.h \
+    worldMap/zonegrid.h \
     worldMap/toolpop.h \
     worldMap/timezonemap.h \
     worldMap/timezonechooser.h \
@@ -60,3 +64,6 @@ FORMS += \
 
 RESOURCES += \
     tz.qrc
+
+DISTFILES += \
+    datetime.json
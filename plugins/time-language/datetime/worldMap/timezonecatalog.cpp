@@ -0,0 +1,131 @@
+#include "timezonecatalog.h"
+
+#include <QCoreApplication>
+#include <QLocale>
+#include <QTimeZone>
+#include <QtConcurrent>
+#include <locale.h>
+#include <libintl.h>
+
+const char kCatalogDomain[] = "installer-timezones";
+
+const QString kShanghai = "Asia/Shanghai";
+const QString kcnBeijing = "北京";
+const QString kenBeijing = "Asia/Beijing";
+
+// 去掉翻译结果中的区域前缀，如 "亚洲/上海" -> "上海"
+static QString stripRegion(const QString &localName) {
+    int index = localName.lastIndexOf('/');
+    if (index == -1) {
+        // Some translations of locale name contains non-standard char.
+        index = localName.lastIndexOf("∕");
+    }
+    return (index > -1) ? localName.mid(index + 1) : localName;
+}
+
+static QString beijingName(const QString &locale) {
+    return locale == "zh_CN" ? kcnBeijing : kenBeijing;
+}
+
+TimezoneCatalog *TimezoneCatalog::instance() {
+    static TimezoneCatalog *catalog = new TimezoneCatalog(qApp);
+    return catalog;
+}
+
+TimezoneCatalog::TimezoneCatalog(QObject *parent) :
+    QObject(parent),
+    mLoaded(false),
+    mWatcher(nullptr) {
+}
+
+void TimezoneCatalog::load() {
+    if (mLoaded || mWatcher) {
+        return;
+    }
+
+    mWatcher = new QFutureWatcher<TimezoneCatalogData>(this);
+    connect(mWatcher, &QFutureWatcher<TimezoneCatalogData>::finished, this, [=]() {
+        mData = mWatcher->result();
+        mLoaded = true;
+        mWatcher->deleteLater();
+        mWatcher = nullptr;
+        Q_EMIT loaded();
+    });
+    mWatcher->setFuture(QtConcurrent::run(&TimezoneCatalog::build, QLocale::system().name()));
+}
+
+bool TimezoneCatalog::isLoaded() const {
+    return mLoaded;
+}
+
+QStringList TimezoneCatalog::completions() const {
+    return mData.completions;
+}
+
+QString TimezoneCatalog::localizedName(const QString &timezone) const {
+    if (mLoaded) {
+        auto it = mData.zoneToName.constFind(timezone);
+        if (it != mData.zoneToName.constEnd()) {
+            return it.value();
+        }
+    }
+    return translate(timezone, QLocale::system().name());
+}
+
+QString TimezoneCatalog::timezoneForName(const QString &name) const {
+    return mData.nameToZone.value(name, name);
+}
+
+QString TimezoneCatalog::translate(const QString &timezone, const QString &locale) {
+    if (kShanghai == timezone) {
+        return beijingName(locale);
+    }
+
+    QByteArray localeName = QString(locale + ".UTF-8").toLatin1();
+    locale_t loc = newlocale(LC_ALL_MASK, localeName.constData(), (locale_t)0);
+    if (loc == (locale_t)0) {
+        return stripRegion(timezone);
+    }
+
+    locale_t oldLoc = uselocale(loc);
+    const QString localName(dgettext(kCatalogDomain, timezone.toUtf8().constData()));
+    uselocale(oldLoc);
+    freelocale(loc);
+
+    return stripRegion(localName);
+}
+
+TimezoneCatalogData TimezoneCatalog::build(const QString &locale) {
+    TimezoneCatalogData data;
+    data.locale = locale;
+
+    const QList<QByteArray> zones = QTimeZone::availableTimeZoneIds();
+    data.completions.reserve(zones.size() * 2 + 2);
+    data.completions << kenBeijing << kcnBeijing;
+    data.nameToZone[kcnBeijing] = kenBeijing;
+    data.zoneToName[kShanghai] = beijingName(locale);
+
+    // 整个表只切换一次线程locale
+    QByteArray localeName = QString(locale + ".UTF-8").toLatin1();
+    locale_t loc = newlocale(LC_ALL_MASK, localeName.constData(), (locale_t)0);
+    locale_t oldLoc = loc ? uselocale(loc) : (locale_t)0;
+
+    for (const QByteArray &zone : zones) {
+        const QString timezone = QString::fromLatin1(zone);
+        if (kShanghai == timezone) {
+            continue;
+        }
+
+        QString localizedTimezone = loc ? stripRegion(QString::fromUtf8(dgettext(kCatalogDomain, zone.constData())))
+                                        : stripRegion(timezone);
+        data.completions << timezone << localizedTimezone;
+        data.zoneToName[timezone] = localizedTimezone;
+        data.nameToZone[localizedTimezone] = timezone;
+    }
+
+    if (loc) {
+        uselocale(oldLoc);
+        freelocale(loc);
+    }
+    return data;
+}
@@ -0,0 +1,47 @@
+#ifndef TIMEZONECATALOG_H
+#define TIMEZONECATALOG_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QFutureWatcher>
+
+struct TimezoneCatalogData {
+    QString locale;
+    QStringList completions;            // 补全列表：时区id与本地化名称
+    QHash<QString, QString> zoneToName; // 时区id -> 本地化名称
+    QHash<QString, QString> nameToZone; // 本地化名称 -> 时区id
+};
+
+// 本地化时区表，首次使用时在后台线程一次性翻译全部时区，之后直接查表
+class TimezoneCatalog : public QObject
+{
+    Q_OBJECT
+public:
+    static TimezoneCatalog *instance();
+
+    void load();
+    bool isLoaded() const;
+
+    QStringList completions() const;
+    QString localizedName(const QString &timezone) const;
+    QString timezoneForName(const QString &name) const;
+
+    // 使用线程私有locale翻译，不修改进程全局的setlocale状态
+    static QString translate(const QString &timezone, const QString &locale);
+
+Q_SIGNALS:
+    void loaded();
+
+private:
+    explicit TimezoneCatalog(QObject *parent = nullptr);
+    static TimezoneCatalogData build(const QString &locale);
+
+private:
+    TimezoneCatalogData mData;
+    bool mLoaded;
+    QFutureWatcher<TimezoneCatalogData> *mWatcher;
+};
+
+#endif // TIMEZONECATALOG_H
@@ -4,8 +4,6 @@
 #include <QApplication>
 #include <QLineEdit>
 #include <QVBoxLayout>
-#include <QTimer>
-#include <QTimeZone>
 #include <QCompleter>
 #include <QDebug>
 #include <QHBoxLayout>
@@ -13,15 +11,13 @@
 #include <QPainterPath>
 
 #include "ImageUtil/imageutil.h"
-
-const QString kcnBj = "北京";
-const QString kenBj = "Asia/Beijing";
+#include "timezonecatalog.h"
 
 TimeZoneChooser::TimeZoneChooser(QWidget *parent) : QFrame(parent)
 {
     m_map = new TimezoneMap(this);
     m_map->show();
-    m_zoneinfo = new ZoneInfo;
+    m_popup = nullptr;
     m_searchInput = new QLineEdit(this);
     m_title = new QLabel(this);
     m_closeBtn = new QPushButton(this);
@@ -104,58 +100,50 @@ TimeZoneChooser::TimeZoneChooser(QWidget *parent) : QFrame(parent)
 
     connect(m_searchInput, &QLineEdit::editingFinished, [this]{
         QString timezone = m_searchInput->text();
-        timezone = m_zoneCompletion.value(timezone,timezone);
+        timezone = TimezoneCatalog::instance()->timezoneForName(timezone);
         m_map->setTimezone(timezone);
     });
 
-    QTimer::singleShot(0, [this] {
-        QStringList completions;
-        completions << kenBj;
-        completions << kcnBj;
-        m_zoneCompletion[kcnBj] = kenBj;
-        for (QString timezone : QTimeZone::availableTimeZoneIds()) {
-            if ("Asia/Shanghai" == timezone) {
-                continue;
-            }
-            completions << timezone;
-
-            const QString locale = QLocale::system().name();
-            QString localizedTimezone = m_zoneinfo->getLocalTimezoneName(timezone, locale);
-            completions << localizedTimezone;
-
-            m_zoneCompletion[localizedTimezone] = timezone;
-        }
+    // 时区表首次在后台线程构建，之后再打开对话框直接复用
+    TimezoneCatalog *catalog = TimezoneCatalog::instance();
+    if (catalog->isLoaded()) {
+        initCompleter();
+    } else {
+        connect(catalog, &TimezoneCatalog::loaded, this, &TimeZoneChooser::initCompleter);
+        catalog->load();
+    }
+}
 
-        QCompleter *completer = new QCompleter(completions, m_searchInput);
-        completer->setCompletionMode(QCompleter::PopupCompletion);
-        completer->setCaseSensitivity(Qt::CaseInsensitive);
-        completer->setFilterMode(Qt::MatchContains);
+void TimeZoneChooser::initCompleter() {
+    QCompleter *completer = new QCompleter(TimezoneCatalog::instance()->completions(), m_searchInput);
+    completer->setCompletionMode(QCompleter::PopupCompletion);
+    completer->setCaseSensitivity(Qt::CaseInsensitive);
+    completer->setFilterMode(Qt::MatchContains);
 
-        m_searchInput->setCompleter(completer);
+    m_searchInput->setCompleter(completer);
 
 #if QT_VERSION <= QT_VERSION_CHECK(5, 12, 0)
-        connect(completer, static_cast<void(QCompleter::*)(const QString &)>(&QCompleter::activated),
-                [=](const QString &text){
+    connect(completer, static_cast<void(QCompleter::*)(const QString &)>(&QCompleter::activated),
+            [=](const QString &text){
 #else
-        //鼠标点击后直接页面跳转(https://doc.qt.io/qt-5/qcompleter.html#activated-1)
-        connect(completer, QOverload<const QString &>::of(&QCompleter::activated),
-                [=](const QString &text) {
+    //鼠标点击后直接页面跳转(https://doc.qt.io/qt-5/qcompleter.html#activated-1)
+    connect(completer, QOverload<const QString &>::of(&QCompleter::activated),
+            [=](const QString &text) {
 #endif
-            Q_UNUSED(text);
-            QString timezone = m_searchInput->text();
-            timezone = m_zoneCompletion.value(timezone,timezone);
-            m_map->setTimezone(timezone);
-        });
-
-        m_popup = completer->popup();
-        m_popup->setAttribute(Qt::WA_TranslucentBackground);
-        m_popup->installEventFilter(this);
-
-        QHBoxLayout *layout = new QHBoxLayout;
-        layout->setSpacing(0);
-        layout->setMargin(0);
-        m_popup->setLayout(layout);
+        Q_UNUSED(text);
+        QString timezone = m_searchInput->text();
+        timezone = TimezoneCatalog::instance()->timezoneForName(timezone);
+        m_map->setTimezone(timezone);
     });
+
+    m_popup = completer->popup();
+    m_popup->setAttribute(Qt::WA_TranslucentBackground);
+    m_popup->installEventFilter(this);
+
+    QHBoxLayout *layout = new QHBoxLayout;
+    layout->setSpacing(0);
+    layout->setMargin(0);
+    m_popup->setLayout(layout);
 }
 
 void TimeZoneChooser::setTitle() {
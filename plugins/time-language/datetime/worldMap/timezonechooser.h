@@ -30,11 +30,9 @@ protected:
 private:
     QSize getFitSize();
     void initSize();
+    void initCompleter();
 
 private:
-    ZoneInfo* m_zoneinfo;
-
-    QMap<QString, QString> m_zoneCompletion;
     QAbstractItemView      *m_popup;
 
     TimezoneMap* m_map;
@@ -1,4 +1,5 @@
 #include "timezonemap.h"
+#include "timezonecatalog.h"
 
 #include <QApplication>
 #include <QPainter>
@@ -6,10 +7,14 @@
 #include <QApplication>
 #include <QImageReader>
 #include <QDebug>
+#include <cmath>
 
 const QString timezoneMapFile =":/images/map.svg";
 const QString dotFile = ":/images/indicator.png";
 
+// 点击点周围的时区距离阈值(像素距离的平方)
+const double kNearestThreshold = 100.0;
+
 
 QPixmap TimezoneMap::loadPixmap(const QString &path)
 {
@@ -108,9 +113,8 @@ void TimezoneMap::mark() {
 
     Q_ASSERT(!m_nearestZones.isEmpty());
 
-    QString locale = QLocale::system().name();
     if (!m_nearestZones.isEmpty()) {
-        m_singleList->setText(m_zoninfo->getLocalTimezoneName(m_currentZone.timezone, locale));
+        m_singleList->setText(TimezoneCatalog::instance()->localizedName(m_currentZone.timezone));
         m_singleList->adjustSize();
 
         QPoint zonePos = this->zoneInfoToPosition(m_currentZone,mapWidth,mapHeight);
@@ -135,11 +139,10 @@ void TimezoneMap::popupZoneList(QPoint pos) {
     m_popLists->hide();
 
 
-    QString locale = QLocale::system().name();
     QStringList zoneNames;
 
     for (ZoneInfo_ zone : m_nearestZones) {
-        zoneNames.append(m_zoninfo->getLocalTimezoneName(zone.timezone, locale));
+        zoneNames.append(TimezoneCatalog::instance()->localizedName(zone.timezone));
     }
 
     m_popLists->setStringList(zoneNames);
@@ -181,16 +184,25 @@ void TimezoneMap::setTimezone(QString timezone) {
     }
 }
 
+// 投影坐标按当前地图尺寸缓存在网格中，尺寸变化后首次查询时重建
+QList<int> TimezoneMap::nearestZoneIndexes(int x, int y) {
+    if (!m_grid.isValid(this->width(), this->height())) {
+        m_grid.build(m_totalZones, this->width(), this->height(), std::sqrt(kNearestThreshold));
+    }
+    return m_grid.nearest(x, y, kNearestThreshold);
+}
+
 void TimezoneMap::mousePressEvent(QMouseEvent *event) {
     if (event->button() == Qt::LeftButton) {
-        m_nearestZones = m_zoninfo->getNearestZones(m_totalZones,100.0,
-                                                    event->x(), event->y(),
-                                                    this->width(), this->height());
+        m_nearestZones.clear();
+        for (int index : nearestZoneIndexes(event->x(), event->y())) {
+            m_nearestZones.append(m_totalZones.at(index));
+        }
         if (m_nearestZones.length() == 1){
             m_currentZone = m_nearestZones.first();
             this->mark();
             emit this->timezoneSelected(m_currentZone.timezone);
-        } else {
+        } else if (!m_nearestZones.isEmpty()) {
             this->popupZoneList(event->pos());
         }
     } else {
@@ -204,6 +216,8 @@ void TimezoneMap::resizeEvent(QResizeEvent *event) {
         m_popLists->hide();
     }
 
+    m_grid.clear();
+
     QLabel *background_label = findChild<QLabel*>("background_label");
     if (background_label) {
         QPixmap timezone_pixmap = loadPixmap(timezoneMapFile);
@@ -10,6 +10,7 @@
 #include "zoneinfo.h"
 #include "poplist.h"
 #include "toolpop.h"
+#include "zonegrid.h"
 
 QDebug& operator<<(QDebug& debug, const ZoneInfo& info);
 
@@ -37,12 +38,14 @@ private:
     void popupZoneList(QPoint pos);
 
     QPoint zoneInfoToPosition(ZoneInfo_ zone, int mapWidth, int mapHeight);
+    QList<int> nearestZoneIndexes(int x, int y);
 
 private:
     ZoneInfo*    m_zoninfo;
     ZoneInfo_    m_currentZone;
     ZoneinfoList m_totalZones;
     ZoneinfoList m_nearestZones;
+    ZoneGrid     m_grid;
 
     // 圆点
     QLabel* m_dot = nullptr;
@@ -0,0 +1,107 @@
+#include "zonegrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+ZoneGrid::ZoneGrid() :
+    m_cellSize(1.0), m_columns(0), m_rows(0) {
+}
+
+void ZoneGrid::build(const ZoneinfoList &zones, int mapWidth, int mapHeight, double cellSize) {
+    ZoneInfo info;
+
+    m_size = QSize(mapWidth, mapHeight);
+    m_cellSize = qMax(cellSize, 1.0);
+    m_columns = qMax(1, int(std::ceil(mapWidth / m_cellSize)));
+    m_rows = qMax(1, int(std::ceil(mapHeight / m_cellSize)));
+
+    m_points.clear();
+    m_points.reserve(zones.size());
+    m_cells.fill(QVector<int>(), m_columns * m_rows);
+
+    for (int index = 0; index < zones.size(); index++) {
+        const ZoneInfo_ &zone = zones.at(index);
+        QPointF point(info.converLongtitudeToX(zone.longtitude, mapWidth),
+                      info.converLatitudeToY(zone.latitude, mapHeight));
+        m_points.append(point);
+        // 超出地图的点归入边缘格子，不影响最近距离的下界判断
+        m_cells[row(point.y()) * m_columns + column(point.x())].append(index);
+    }
+}
+
+bool ZoneGrid::isValid(int mapWidth, int mapHeight) const {
+    return !m_points.isEmpty() && m_size == QSize(mapWidth, mapHeight);
+}
+
+void ZoneGrid::clear() {
+    m_size = QSize();
+    m_points.clear();
+    m_cells.clear();
+}
+
+QList<int> ZoneGrid::nearest(int x, int y, double threshold) const {
+    QList<int> result;
+    if (m_points.isEmpty()) {
+        return result;
+    }
+
+    const int col = column(x);
+    const int rw = row(y);
+    const int reach = int(std::ceil(std::sqrt(qMax(threshold, 0.0)) / m_cellSize));
+
+    int nearestIndex = -1;
+    double minimum = -1;
+
+    // 从点击所在格子向外逐圈扫描
+    const int maxRing = qMax(m_columns, m_rows);
+    for (int ring = 0; ring <= maxRing; ring++) {
+        for (int r = rw - ring; r <= rw + ring; r++) {
+            if (r < 0 || r >= m_rows) {
+                continue;
+            }
+            const bool edgeRow = (r == rw - ring || r == rw + ring);
+            for (int c = col - ring; c <= col + ring; c += (edgeRow ? 1 : 2 * ring)) {
+                if (c >= 0 && c < m_columns) {
+                    for (int index : m_cells.at(r * m_columns + c)) {
+                        const double dx = m_points.at(index).x() - x;
+                        const double dy = m_points.at(index).y() - y;
+                        const double distance = dx * dx + dy * dy;
+                        if (minimum < 0 || distance < minimum) {
+                            minimum = distance;
+                            nearestIndex = index;
+                        }
+                        if (distance <= threshold) {
+                            result.append(index);
+                        }
+                    }
+                }
+                if (ring == 0) {
+                    break;
+                }
+            }
+        }
+
+        // 阈值内的格子已全部扫描，且下一圈不可能有更近的点
+        const double bound = ring * m_cellSize;
+        if (ring >= reach && nearestIndex >= 0 && minimum <= bound * bound) {
+            break;
+        }
+    }
+
+    if (result.isEmpty()) {
+        if (nearestIndex >= 0) {
+            result.append(nearestIndex);
+        }
+    } else {
+        std::sort(result.begin(), result.end());
+    }
+    return result;
+}
+
+int ZoneGrid::column(double x) const {
+    return qBound(0, int(std::floor(x / m_cellSize)), m_columns - 1);
+}
+
+int ZoneGrid::row(double y) const {
+    return qBound(0, int(std::floor(y / m_cellSize)), m_rows - 1);
+}
@@ -0,0 +1,35 @@
+#ifndef ZONEGRID_H
+#define ZONEGRID_H
+
+#include <QPointF>
+#include <QSize>
+#include <QVector>
+
+#include "zoneinfo.h"
+
+// 按地图尺寸缓存各时区的投影坐标，并以均匀网格索引，用于点击/悬停时查找附近时区
+class ZoneGrid {
+public:
+    ZoneGrid();
+
+    void build(const ZoneinfoList &zones, int mapWidth, int mapHeight, double cellSize);
+    bool isValid(int mapWidth, int mapHeight) const;
+    void clear();
+
+    // 返回距离平方不大于threshold的时区下标(按原顺序)，没有时返回最近的一个
+    QList<int> nearest(int x, int y, double threshold) const;
+
+private:
+    int column(double x) const;
+    int row(double y) const;
+
+private:
+    QSize            m_size;
+    double           m_cellSize;
+    int              m_columns;
+    int              m_rows;
+    QVector<QPointF> m_points;
+    QVector<QVector<int>> m_cells;
+};
+
+#endif // ZONEGRID_H
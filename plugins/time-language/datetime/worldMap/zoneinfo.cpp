@@ -1,19 +1,11 @@
 #include "zoneinfo.h"
+#include "timezonecatalog.h"
 
 #include <cmath>
 #include <QDebug>
-#include <locale.h>
-#include <libintl.h>
 
 const QString zoneTabFile = "/usr/share/zoneinfo/zone.tab";
 
-const char kTimezoneDomain[] = "installer-timezones";
-
-const char kDefaultLocale[] = "en_US.UTF-8";
-
-const QString kcnBj = "北京";
-const QString kenBj = "Asia/Beijing";
-
 QString ZoneInfo::readRile(const QString& filepath) {
     QFile file(filepath);
     if(file.exists()) {
@@ -102,28 +94,7 @@ int ZoneInfo::getZoneInfoByZone(ZoneinfoList list, QString timezone) {
 
 
 QString ZoneInfo::getLocalTimezoneName(QString timezone, QString locale) {
-    (void) setlocale(LC_ALL, QString(locale + ".UTF-8").toStdString().c_str());
-    const QString local_name(dgettext(kTimezoneDomain,
-                                      timezone.toStdString().c_str()));
-    int index = local_name.lastIndexOf('/');
-    if (index == -1) {
-      // Some translations of locale name contains non-standard char.
-      index = local_name.lastIndexOf("∕");
-    }
-
-    // Reset locale.
-    (void) setlocale(LC_ALL, kDefaultLocale);
-
-
-    if ("Asia/Shanghai" == timezone) {
-        if (QLocale::system().name() == "zh_CN") {
-            return kcnBj;
-        } else {
-            return kenBj;
-        }
-    }
-
-    return (index > -1) ? local_name.mid(index + 1) : local_name;
+    return TimezoneCatalog::translate(timezone, locale);
 }
 
 double ZoneInfo::radians(double degrees) {
@@ -153,34 +124,3 @@ double ZoneInfo::converLatitudeToY(double latitude, double map_height) {
     y = y * map_height;
     return y;
 }
-
-ZoneinfoList ZoneInfo::getNearestZones(ZoneinfoList total_zones, double threshold, int x, int y, int map_width, int map_height) {
-
-    ZoneinfoList zones;
-    double minimum_distance = map_width * map_width + map_height * map_height;
-    int nearest_zone_index = -1;
-    for (int index = 0; index < total_zones.length(); index++) {
-      const ZoneInfo_& zone = total_zones.at(index);
-      const double point_x = converLongtitudeToX(zone.longtitude, map_width);
-      const double point_y = converLatitudeToY(zone.latitude, map_height);
-      const double dx = point_x - x;
-      const double dy = point_y - y;
-      const double distance = dx * dx + dy * dy;
-      if (distance < minimum_distance) {
-        minimum_distance = distance;
-        nearest_zone_index = index;
-      }
-      if (distance <= threshold) {
-        zones.append(zone);
-      }
-    }
-
-    // Get the nearest zone.
-    if (zones.isEmpty()) {
-      zones.append(total_zones.at(nearest_zone_index));
-    }
-
-    return zones;
-}
-
-
@@ -34,10 +34,6 @@ public:
     double converLatitudeToY(double latitude, double map_height);
     double converLongtitudeToX(double longitude, double map_width);
 
-    // 在宽度：mapWidth,高度mapHeight地图上获得鼠标周围小于阈值的所有时区
-    ZoneinfoList getNearestZones(ZoneinfoList allZones,double threshold,
-                                 int x, int y, int mapWidth, int mapHeight);
-
 
 
 };
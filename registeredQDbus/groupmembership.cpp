@@ -0,0 +1,209 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "groupmembership.h"
+#include "group_file_editor.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QVector>
+#include <QDebug>
+
+#include <errno.h>
+#include <grp.h>
+#include <pwd.h>
+#include <unistd.h>
+
+#define GROUP_FILE  "/etc/group"
+#define PASSWD_FILE "/etc/passwd"
+
+GroupMembership::GroupMembership(QObject *parent) :
+    QObject(parent)
+{
+    mWatcher = new QFileSystemWatcher(this);
+    connect(mWatcher, &QFileSystemWatcher::fileChanged, this, [=](const QString &){
+        invalidate();
+    });
+    // shadow工具以重命名方式替换文件，需同时监视所在目录
+    connect(mWatcher, &QFileSystemWatcher::directoryChanged, this, [=](const QString &){
+        if (filesChanged()) {
+            invalidate();
+        }
+    });
+    invalidate();
+}
+
+bool GroupMembership::isUserInGroup(const QString &user, const QString &group)
+{
+    const GroupRecord &record = groupRecord(group);
+    if (!record.exists) {
+        return false;
+    }
+    if (record.members.contains(user)) {
+        return true;
+    }
+    // 主组不会出现在成员列表中
+    return userGroups(user).contains(record.gid);
+}
+
+bool GroupMembership::groupExists(const QString &group, gid_t *gid, QStringList *members)
+{
+    const GroupRecord &record = groupRecord(group);
+    if (gid) {
+        *gid = record.gid;
+    }
+    if (members) {
+        *members = record.members;
+    }
+    return record.exists;
+}
+
+QString GroupMembership::setMembership(const QString &group, const QStringList &add, const QStringList &remove)
+{
+    QString error;
+    group_file_editor editor;
+
+    if (!editor.lock(error) || !editor.load(error)) {
+        qWarning() << "edit group" << group << "failed:" << error;
+        return error;
+    }
+
+    QStringList errors;
+    for (const QString &user : add) {
+        QString result = editor.add_member(group, user);
+        if (!result.isEmpty()) {
+            errors << result;
+        }
+    }
+    for (const QString &user : remove) {
+        QString result = editor.del_member(group, user);
+        if (!result.isEmpty()) {
+            errors << result;
+        }
+    }
+
+    if (errors.isEmpty() && !editor.commit(error)) {
+        errors << error;
+    }
+    editor.unlock();
+
+    // 不等待inotify通知，保证随后的查询读到新内容
+    invalidate();
+
+    if (!errors.isEmpty()) {
+        qWarning() << "edit group" << group << "failed:" << errors;
+    }
+    return errors.join("; ");
+}
+
+void GroupMembership::invalidate()
+{
+    mGroups.clear();
+    mUserGroups.clear();
+    mGroupModified = QFileInfo(GROUP_FILE).lastModified();
+    mPasswdModified = QFileInfo(PASSWD_FILE).lastModified();
+    watch();
+}
+
+const GroupMembership::GroupRecord &GroupMembership::groupRecord(const QString &group)
+{
+    auto it = mGroups.constFind(group);
+    if (it != mGroups.constEnd()) {
+        return it.value();
+    }
+
+    GroupRecord record;
+    record.exists = false;
+    record.gid = 0;
+
+    QByteArray name = group.toLocal8Bit();
+    long size = sysconf(_SC_GETGR_R_SIZE_MAX);
+    QByteArray buf(size > 0 ? size : 1024, '\0');
+    struct group grp;
+    struct group *result = nullptr;
+
+    int ret;
+    while ((ret = getgrnam_r(name.constData(), &grp, buf.data(), buf.size(), &result)) == ERANGE) {
+        buf.resize(buf.size() * 2);
+    }
+    if (ret == 0 && result) {
+        record.exists = true;
+        record.gid = result->gr_gid;
+        for (char **member = result->gr_mem; member && *member; member++) {
+            record.members << QString::fromLocal8Bit(*member);
+        }
+    }
+
+    return mGroups.insert(group, record).value();
+}
+
+const QList<gid_t> &GroupMembership::userGroups(const QString &user)
+{
+    auto it = mUserGroups.constFind(user);
+    if (it != mUserGroups.constEnd()) {
+        return it.value();
+    }
+
+    QList<gid_t> gids;
+    QByteArray name = user.toLocal8Bit();
+    long size = sysconf(_SC_GETPW_R_SIZE_MAX);
+    QByteArray buf(size > 0 ? size : 1024, '\0');
+    struct passwd pwd;
+    struct passwd *result = nullptr;
+
+    int ret;
+    while ((ret = getpwnam_r(name.constData(), &pwd, buf.data(), buf.size(), &result)) == ERANGE) {
+        buf.resize(buf.size() * 2);
+    }
+    if (ret == 0 && result) {
+        int ngroups = 32;
+        QVector<gid_t> groups(ngroups);
+        while (getgrouplist(name.constData(), result->pw_gid, groups.data(), &ngroups) == -1) {
+            // ngroups已被更新为实际需要的数量
+            groups.resize(ngroups);
+        }
+        for (int i = 0; i < ngroups; i++) {
+            gids << groups.at(i);
+        }
+    }
+
+    return mUserGroups.insert(user, gids).value();
+}
+
+void GroupMembership::watch()
+{
+    QStringList files;
+    files << GROUP_FILE << PASSWD_FILE;
+    for (const QString &file : files) {
+        if (QFile::exists(file) && !mWatcher->files().contains(file)) {
+            mWatcher->addPath(file);
+        }
+    }
+    QString dir = QFileInfo(GROUP_FILE).absolutePath();
+    if (!mWatcher->directories().contains(dir)) {
+        mWatcher->addPath(dir);
+    }
+}
+
+bool GroupMembership::filesChanged() const
+{
+    return QFileInfo(GROUP_FILE).lastModified() != mGroupModified ||
+            QFileInfo(PASSWD_FILE).lastModified() != mPasswdModified;
+}
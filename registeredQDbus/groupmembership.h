@@ -0,0 +1,75 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef GROUPMEMBERSHIP_H
+#define GROUPMEMBERSHIP_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QDateTime>
+
+#include <sys/types.h>
+
+class QFileSystemWatcher;
+
+/**
+ * \brief GroupMembership
+ * 组成员关系查询与修改：通过getgrnam_r/getgrouplist查询并缓存结果，
+ * /etc/group或/etc/passwd变化时由inotify清空缓存；
+ * 修改时一次加锁编辑/etc/group与/etc/gshadow，不再调用gpasswd。
+ */
+class GroupMembership : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GroupMembership(QObject *parent = nullptr);
+
+    bool isUserInGroup(const QString &user, const QString &group);
+    bool groupExists(const QString &group, gid_t *gid = nullptr, QStringList *members = nullptr);
+
+    // 返回错误信息，成功时为空
+    QString setMembership(const QString &group, const QStringList &add, const QStringList &remove);
+
+    void invalidate();
+
+private:
+    struct GroupRecord {
+        bool exists;
+        gid_t gid;
+        QStringList members;    // /etc/group中显式列出的成员
+    };
+
+    const GroupRecord &groupRecord(const QString &group);
+    const QList<gid_t> &userGroups(const QString &user);
+    void watch();
+    bool filesChanged() const;
+
+private:
+    QHash<QString, GroupRecord> mGroups;
+    QHash<QString, QList<gid_t>> mUserGroups;
+
+    QFileSystemWatcher *mWatcher;
+    QDateTime mGroupModified;
+    QDateTime mPasswdModified;
+};
+
+#endif // GROUPMEMBERSHIP_H
@@ -0,0 +1,244 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "hardwareinfo.h"
+
+#include <QFile>
+#include <QList>
+#include <QDebug>
+
+// 没有入口点信息时按SMBIOS 3.0处理
+#define SMBIOS_DEFAULT_VERSION 0x0300
+
+HardwareInfo::HardwareInfo(const QString &dmiDir, const QString &tablesDir) :
+    mDmiDir(dmiDir),
+    mTablesDir(tablesDir),
+    mLoaded(false)
+{
+}
+
+const HardwareInfoData &HardwareInfo::data() {
+    if (!mLoaded) {
+        load();
+    }
+    return mData;
+}
+
+QVariantMap HardwareInfo::toVariantMap() {
+    const HardwareInfoData &info = data();
+    QVariantMap map;
+
+    // 键名与/sys/class/dmi/id下的属性名一致
+    map.insert("bios_vendor", info.biosVendor);
+    map.insert("bios_version", info.biosVersion);
+    map.insert("bios_date", info.biosDate);
+    map.insert("sys_vendor", info.sysVendor);
+    map.insert("product_name", info.productName);
+    map.insert("product_version", info.productVersion);
+    map.insert("product_serial", info.productSerial);
+    map.insert("product_uuid", info.productUuid);
+    map.insert("product_sku", info.productSku);
+    map.insert("product_family", info.productFamily);
+    map.insert("board_vendor", info.boardVendor);
+    map.insert("board_name", info.boardName);
+    map.insert("board_version", info.boardVersion);
+    map.insert("board_serial", info.boardSerial);
+    return map;
+}
+
+QString HardwareInfo::toDmidecodeText() {
+    const HardwareInfoData &info = data();
+    QString text;
+
+    text += "System Information\n";
+    text += QString("\tManufacturer: %1\n").arg(info.sysVendor);
+    text += QString("\tProduct Name: %1\n").arg(info.productName);
+    text += QString("\tVersion: %1\n").arg(info.productVersion);
+    text += QString("\tSerial Number: %1\n").arg(info.productSerial);
+    text += QString("\tUUID: %1\n").arg(info.productUuid);
+    text += QString("\tSKU Number: %1\n").arg(info.productSku);
+    text += QString("\tFamily: %1\n").arg(info.productFamily);
+    return text;
+}
+
+void HardwareInfo::load() {
+    mLoaded = true;
+
+    mData.biosVendor     = readAttribute("bios_vendor");
+    mData.biosVersion    = readAttribute("bios_version");
+    mData.biosDate       = readAttribute("bios_date");
+    mData.sysVendor      = readAttribute("sys_vendor");
+    mData.productName    = readAttribute("product_name");
+    mData.productVersion = readAttribute("product_version");
+    mData.productSerial  = readAttribute("product_serial");
+    mData.productUuid    = readAttribute("product_uuid");
+    mData.productSku     = readAttribute("product_sku");
+    mData.productFamily  = readAttribute("product_family");
+    mData.boardVendor    = readAttribute("board_vendor");
+    mData.boardName      = readAttribute("board_name");
+    mData.boardVersion   = readAttribute("board_version");
+    mData.boardSerial    = readAttribute("board_serial");
+
+    // 旧内核没有部分属性文件，缺失的字段从SMBIOS表补齐
+    QList<QString *> fields;
+    fields << &mData.biosVendor << &mData.biosVersion << &mData.biosDate
+           << &mData.sysVendor << &mData.productName << &mData.productVersion
+           << &mData.productSerial << &mData.productUuid << &mData.productSku
+           << &mData.productFamily << &mData.boardVendor << &mData.boardName
+           << &mData.boardVersion << &mData.boardSerial;
+
+    bool incomplete = false;
+    for (QString *field : fields) {
+        if (field->isEmpty()) {
+            incomplete = true;
+            break;
+        }
+    }
+    if (!incomplete) {
+        return;
+    }
+
+    HardwareInfoData smbios;
+    parseSmbios(smbios);
+
+    QList<QString *> smbiosFields;
+    smbiosFields << &smbios.biosVendor << &smbios.biosVersion << &smbios.biosDate
+                 << &smbios.sysVendor << &smbios.productName << &smbios.productVersion
+                 << &smbios.productSerial << &smbios.productUuid << &smbios.productSku
+                 << &smbios.productFamily << &smbios.boardVendor << &smbios.boardName
+                 << &smbios.boardVersion << &smbios.boardSerial;
+
+    for (int i = 0; i < fields.size(); i++) {
+        if (fields.at(i)->isEmpty()) {
+            *fields.at(i) = *smbiosFields.at(i);
+        }
+    }
+}
+
+QString HardwareInfo::readAttribute(const QString &name) const {
+    QFile file(mDmiDir + "/" + name);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    return QString::fromUtf8(file.readAll()).trimmed();
+}
+
+void HardwareInfo::parseSmbios(HardwareInfoData &smbios) const {
+    QFile tableFile(mTablesDir + "/DMI");
+    if (!tableFile.open(QIODevice::ReadOnly)) {
+        qDebug() << "read SMBIOS table failed:" << tableFile.errorString();
+        return;
+    }
+    QByteArray table = tableFile.readAll();
+
+    int version = SMBIOS_DEFAULT_VERSION;
+    QFile entryFile(mTablesDir + "/smbios_entry_point");
+    if (entryFile.open(QIODevice::ReadOnly)) {
+        QByteArray entry = entryFile.readAll();
+        const uchar *ep = reinterpret_cast<const uchar *>(entry.constData());
+        if (entry.startsWith("_SM3_") && entry.size() >= 0x18) {
+            version = (ep[0x07] << 8) | ep[0x08];
+        } else if (entry.startsWith("_SM_") && entry.size() >= 0x1F) {
+            version = (ep[0x06] << 8) | ep[0x07];
+            // 32位入口点给出了表的实际长度
+            int tableLength = ep[0x16] | (ep[0x17] << 8);
+            if (tableLength > 0 && tableLength < table.size()) {
+                table.truncate(tableLength);
+            }
+        }
+    }
+
+    const uchar *data = reinterpret_cast<const uchar *>(table.constData());
+    const int size = table.size();
+    bool seenBios = false, seenSystem = false, seenBoard = false;
+
+    int pos = 0;
+    while (pos + 4 <= size) {
+        const uchar type = data[pos];
+        const uchar length = data[pos + 1];
+        if (length < 4 || pos + length > size) {
+            break;
+        }
+
+        // 格式化区之后是以两个0结尾的字符串集合
+        int stringsStart = pos + length;
+        int stringsEnd = stringsStart;
+        while (stringsEnd + 1 < size && !(data[stringsEnd] == 0 && data[stringsEnd + 1] == 0)) {
+            stringsEnd++;
+        }
+        QList<QByteArray> strings = table.mid(stringsStart, stringsEnd - stringsStart).split('\0');
+
+        const uchar *formatted = data + pos;
+        auto stringAt = [&](int offset) -> QString {
+            if (offset >= length) {
+                return QString();
+            }
+            int index = formatted[offset];
+            if (index == 0 || index > strings.size()) {
+                return QString();
+            }
+            return QString::fromLatin1(strings.at(index - 1)).trimmed();
+        };
+
+        if (type == 0 && !seenBios) {
+            seenBios = true;
+            smbios.biosVendor  = stringAt(0x04);
+            smbios.biosVersion = stringAt(0x05);
+            smbios.biosDate    = stringAt(0x08);
+        } else if (type == 1 && !seenSystem) {
+            seenSystem = true;
+            smbios.sysVendor      = stringAt(0x04);
+            smbios.productName    = stringAt(0x05);
+            smbios.productVersion = stringAt(0x06);
+            smbios.productSerial  = stringAt(0x07);
+            smbios.productSku     = stringAt(0x19);
+            smbios.productFamily  = stringAt(0x1A);
+
+            if (length >= 0x19) {
+                const uchar *u = formatted + 0x08;
+                bool allZero = true, allFF = true;
+                for (int i = 0; i < 16; i++) {
+                    allZero = allZero && u[i] == 0x00;
+                    allFF = allFF && u[i] == 0xFF;
+                }
+                if (!allZero && !allFF) {
+                    // SMBIOS 2.6起前三段按小端存放
+                    bool le = version >= 0x0206;
+                    smbios.productUuid = QString::asprintf(
+                                "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+                                le ? u[3] : u[0], le ? u[2] : u[1], le ? u[1] : u[2], le ? u[0] : u[3],
+                                le ? u[5] : u[4], le ? u[4] : u[5],
+                                le ? u[7] : u[6], le ? u[6] : u[7],
+                                u[8], u[9], u[10], u[11], u[12], u[13], u[14], u[15]);
+                }
+            }
+        } else if (type == 2 && !seenBoard) {
+            seenBoard = true;
+            smbios.boardVendor  = stringAt(0x04);
+            smbios.boardName    = stringAt(0x05);
+            smbios.boardVersion = stringAt(0x06);
+            smbios.boardSerial  = stringAt(0x07);
+        } else if (type == 127) {
+            // 表结束
+            break;
+        }
+
+        pos = stringsEnd + 2;
+    }
+}
@@ -0,0 +1,83 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef HARDWAREINFO_H
+#define HARDWAREINFO_H
+
+#include <QString>
+#include <QVariantMap>
+#include <QByteArray>
+
+#define DMI_SYSFS_DIR    "/sys/class/dmi/id"
+#define DMI_TABLES_DIR   "/sys/firmware/dmi/tables"
+
+struct HardwareInfoData
+{
+    // BIOS，SMBIOS type 0
+    QString biosVendor;
+    QString biosVersion;
+    QString biosDate;
+
+    // 整机，SMBIOS type 1
+    QString sysVendor;
+    QString productName;
+    QString productVersion;
+    QString productSerial;
+    QString productUuid;
+    QString productSku;
+    QString productFamily;
+
+    // 主板，SMBIOS type 2
+    QString boardVendor;
+    QString boardName;
+    QString boardVersion;
+    QString boardSerial;
+};
+
+/**
+ * \brief HardwareInfo
+ * 硬件标识信息：优先读取/sys/class/dmi/id下的属性文件，
+ * 缺失的字段再直接解析SMBIOS表，结果在进程生命周期内缓存。
+ * 目录可以指定，便于用测试数据代替/sys。
+ */
+class HardwareInfo
+{
+public:
+    explicit HardwareInfo(const QString &dmiDir = DMI_SYSFS_DIR,
+                          const QString &tablesDir = DMI_TABLES_DIR);
+
+    const HardwareInfoData &data();
+    QVariantMap toVariantMap();
+    // 兼容旧接口，按dmidecode -t system的格式输出
+    QString toDmidecodeText();
+
+private:
+    void load();
+    QString readAttribute(const QString &name) const;
+    void parseSmbios(HardwareInfoData &smbios) const;
+
+private:
+    QString mDmiDir;
+    QString mTablesDir;
+
+    bool mLoaded;
+    HardwareInfoData mData;
+};
+
+#endif // HARDWAREINFO_H
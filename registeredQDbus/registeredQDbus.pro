@@ -9,7 +9,8 @@ CONFIG += console c++11 link_pkgconfig
 CONFIG -= app_bundle
 
 DESTDIR = .
-INCLUDEPATH += .
+INCLUDEPATH += . \
+               ../group-manager-server
 
 inst1.files += conf/com.control.center.qt.systemdbus.service
 inst1.path = /usr/share/dbus-1/system-services/
@@ -24,8 +25,14 @@ INSTALLS += \
     inst2 \
 
 HEADERS += \
+    ../group-manager-server/group_file_editor.h \
+    groupmembership.h \
+    hardwareinfo.h \
     sysdbusregister.h
 
 SOURCES += \
+    ../group-manager-server/group_file_editor.cpp \
+    groupmembership.cpp \
+    hardwareinfo.cpp \
     main.cpp \
     sysdbusregister.cpp
@@ -20,15 +20,22 @@
 #include "sysdbusregister.h"
 
 #include <QDebug>
+#include <QDBusConnectionInterface>
+#include <QDBusReply>
 #include <QSharedPointer>
 #include <QRegExp>
 #include <stdlib.h>
+#include <pwd.h>
+
+#define NOPWD_GROUP "nopasswdlogin"
 
 SysdbusRegister::SysdbusRegister()
 {
     mHibernateFile = "/etc/systemd/sleep.conf";
     mHibernateSet = new QSettings(mHibernateFile, QSettings::IniFormat, this);
     mHibernateSet->setIniCodec("UTF-8");
+
+    mGroupMembership = new GroupMembership(this);
 }
 
 SysdbusRegister::~SysdbusRegister()
@@ -40,53 +47,81 @@ void SysdbusRegister::exitService() {
 }
 
 QString SysdbusRegister::GetComputerInfo() {
-    QByteArray ba;
-    FILE * fp = NULL;
-    char cmd[128];
-    char buf[1024];
-    sprintf(cmd, "dmidecode -t system");
-
-    if ((fp = popen(cmd, "r")) != NULL){
-        rewind(fp);
-        while (!feof(fp)) {
-            fgets(buf, sizeof (buf), fp);
-            ba.append(buf);
-        }
-        pclose(fp);
-        fp = NULL;
-    }
-    return QString(ba);
+    return mHardwareInfo.toDmidecodeText();
+}
+
+QVariantMap SysdbusRegister::GetHardwareInfo() {
+    return mHardwareInfo.toVariantMap();
 }
 
 //获取免密登录状态
 QString SysdbusRegister::getNoPwdLoginStatus(){
-    QByteArray ba;
-    FILE * fp = NULL;
-    char cmd[128];
-    char buf[1024];
-    sprintf(cmd, "cat /etc/group |grep nopasswdlogin");
-    if ((fp = popen(cmd, "r")) != NULL){
-        rewind(fp);
-        fgets(buf, sizeof (buf), fp);
-        ba.append(buf);
-        pclose(fp);
-        fp = NULL;
-    }else{
-        qDebug()<<"popen文件打开失败"<<endl;
+    // 兼容旧接口，返回/etc/group中的对应行
+    gid_t gid;
+    QStringList members;
+    if (!mGroupMembership->groupExists(NOPWD_GROUP, &gid, &members)) {
+        return QString();
+    }
+    return QString("%1:x:%2:%3\n").arg(NOPWD_GROUP).arg(gid).arg(members.join(","));
+}
+
+bool SysdbusRegister::callerMayAccess(const QStringList &users) {
+    // 服务内部调用不经过总线
+    if (!calledFromDBus()) {
+        return true;
+    }
+
+    QDBusReply<uint> reply = connection().interface()->serviceUid(message().service());
+    if (!reply.isValid()) {
+        qWarning() << "get caller uid failed:" << reply.error().message();
+        return false;
+    }
+    uid_t uid = reply.value();
+    if (uid == 0) {
+        return true;
+    }
+
+    struct passwd *pwd = getpwuid(uid);
+    if (!pwd) {
+        return false;
+    }
+    QString caller = QString::fromLocal8Bit(pwd->pw_name);
+    for (const QString &user : users) {
+        if (user != caller) {
+            return false;
+        }
     }
-    return QString(ba);
+    return true;
+}
+
+bool SysdbusRegister::isUserInGroup(QString user, QString group) {
+    // 普通用户只能查询自己
+    if (!callerMayAccess(QStringList() << user)) {
+        sendErrorReply(QDBusError::AccessDenied, QString("not allowed to query user '%1'").arg(user));
+        return false;
+    }
+    return mGroupMembership->isUserInGroup(user, group);
+}
+
+QString SysdbusRegister::setGroupMembership(QString group, QStringList add, QStringList remove) {
+    // 系统总线上的调用者不一定有管理员权限，只开放控制面板自身管理的组
+    if (group != NOPWD_GROUP) {
+        return QString("group '%1' is not managed by this service").arg(group);
+    }
+    // 普通用户只能修改自己的成员关系
+    if (!callerMayAccess(add + remove)) {
+        return QString("not allowed to change other users' membership of '%1'").arg(group);
+    }
+    return mGroupMembership->setMembership(group, add, remove);
 }
 
 //设置免密登录状态
 void SysdbusRegister::setNoPwdLoginStatus(bool status,QString username) {
-
-    QString cmd;
-    if(true == status){
-         cmd = QString("gpasswd  -a %1 nopasswdlogin").arg(username);
-    } else{
-        cmd = QString("gpasswd  -d %1 nopasswdlogin").arg(username);
+    if (true == status) {
+        setGroupMembership(NOPWD_GROUP, QStringList() << username, QStringList());
+    } else {
+        setGroupMembership(NOPWD_GROUP, QStringList(), QStringList() << username);
     }
-    QProcess::execute(cmd);
 }
 
 // 设置自动登录状态
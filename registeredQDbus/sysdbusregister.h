@@ -22,11 +22,16 @@
 
 #include <QObject>
 #include <QCoreApplication>
+#include <QDBusContext>
 #include <QProcess>
 #include <QFile>
 #include <QSettings>
+#include <QVariantMap>
 
-class SysdbusRegister : public QObject
+#include "hardwareinfo.h"
+#include "groupmembership.h"
+
+class SysdbusRegister : public QObject, protected QDBusContext
 {
     Q_OBJECT
 
@@ -41,6 +46,14 @@ private:
 
     QSettings *mHibernateSet;
 
+    // 硬件信息在服务运行期间不变，首次查询后缓存
+    HardwareInfo mHardwareInfo;
+
+    GroupMembership *mGroupMembership;
+
+    // 调用者为root，或者users中只有调用者本人
+    bool callerMayAccess(const QStringList &users);
+
 signals:
     Q_SCRIPTABLE void nameChanged(QString);
     Q_SCRIPTABLE void computerinfo(QString);
@@ -50,12 +63,21 @@ public slots:
     Q_SCRIPTABLE void exitService();
     Q_SCRIPTABLE QString GetComputerInfo();
 
+    // 获取硬件信息，键名同/sys/class/dmi/id下的属性名
+    Q_SCRIPTABLE QVariantMap GetHardwareInfo();
+
     // 设置免密登录状态
     Q_SCRIPTABLE void setNoPwdLoginStatus(bool status,QString username);
 
     // 获取免密登录状态
     Q_SCRIPTABLE QString getNoPwdLoginStatus();
 
+    // 查询用户是否属于某个组（含主组）
+    Q_SCRIPTABLE bool isUserInGroup(QString user, QString group);
+
+    // 批量修改组成员，返回错误信息，成功时为空
+    Q_SCRIPTABLE QString setGroupMembership(QString group, QStringList add, QStringList remove);
+
     // 设置自动登录状态
     Q_SCRIPTABLE void setAutoLoginStatus(QString username);
 
@@ -3,9 +3,34 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
 
-ukccSessionServer::ukccSessionServer() {
+// 合并编辑器保存时连续触发的变化
+#define RELOAD_DELAY 200
 
+ukccSessionServer::ukccSessionServer() :
+    mFileExists(false),
+    mFileSize(-1)
+{
+    mConfigFile = QDir::homePath() + "/.config/ukui-control-center-security-config.json";
+
+    mReloadTimer.setSingleShot(true);
+    mReloadTimer.setInterval(RELOAD_DELAY);
+    connect(&mReloadTimer, &QTimer::timeout, this, [=]{
+        if (loadSecurityConfig()) {
+            Q_EMIT moduleHideStatusChanged(mModuleMap);
+        }
+        watchSecurityConfig();
+    });
+
+    // 同时监视所在目录，文件被整体替换或新建后也能感知
+    mWatcher = new QFileSystemWatcher(this);
+    connect(mWatcher, &QFileSystemWatcher::fileChanged, this, &ukccSessionServer::securityConfigFileChanged);
+    connect(mWatcher, &QFileSystemWatcher::directoryChanged, this, &ukccSessionServer::securityConfigFileChanged);
+
+    loadSecurityConfig();
+    watchSecurityConfig();
 }
 
 QMap<QString, QVariant> ukccSessionServer::getJsonInfo(const QString &configFile) {
@@ -36,27 +61,56 @@ void ukccSessionServer::exitService() {
     qApp->exit();
 }
 
-void ukccSessionServer::ReloadSecurityConfig()
+bool ukccSessionServer::loadSecurityConfig()
 {
-    Q_EMIT configChanged();
+    QFileInfo info(mConfigFile);
+    mFileExists = info.exists();
+    mFileSize = info.size();
+    mFileTime = info.lastModified();
+
+    QVariantMap moduleMap = getJsonInfo(mConfigFile);
+    if (moduleMap == mModuleMap) {
+        return false;
+    }
+    mModuleMap = moduleMap;
+    return true;
 }
 
-QVariantMap ukccSessionServer::getModuleHideStatus() {
-    QString name = qgetenv("USER");
-    if (name.isEmpty()) {
-        name = qgetenv("USERNAME");
+void ukccSessionServer::watchSecurityConfig()
+{
+    QString dirPath = QFileInfo(mConfigFile).absolutePath();
+    if (!mWatcher->directories().contains(dirPath) && QFileInfo(dirPath).isDir()) {
+        mWatcher->addPath(dirPath);
+    }
+    // 文件被替换后原监视项失效，需要重新添加
+    if (!mWatcher->files().contains(mConfigFile) && QFileInfo(mConfigFile).exists()) {
+        mWatcher->addPath(mConfigFile);
     }
-    QString filename = QDir::homePath() + "/.config/ukui-control-center-security-config.json";
+}
 
-    return getJsonInfo(filename);
+void ukccSessionServer::securityConfigFileChanged()
+{
+    QFileInfo info(mConfigFile);
+    if (info.exists() == mFileExists && info.size() == mFileSize &&
+            info.lastModified() == mFileTime) {
+        return;
+    }
+    mReloadTimer.start();
 }
 
-QString ukccSessionServer::GetSecurityConfigPath() {
-    QString name = qgetenv("USER");
-    if (name.isEmpty()) {
-        name = qgetenv("USERNAME");
+void ukccSessionServer::ReloadSecurityConfig()
+{
+    if (loadSecurityConfig()) {
+        Q_EMIT moduleHideStatusChanged(mModuleMap);
     }
-    QString filename = QDir::homePath() + "/.config/ukui-control-center-security-config.json";
+    watchSecurityConfig();
+    Q_EMIT configChanged();
+}
+
+QVariantMap ukccSessionServer::getModuleHideStatus() {
+    return mModuleMap;
+}
 
-    return filename;
+QString ukccSessionServer::GetSecurityConfigPath() {
+    return mConfigFile;
 }
@@ -10,12 +10,16 @@
 #include <QCoreApplication>
 #include <QDBusContext>
 #include <QScopedPointer>
+#include <QDateTime>
+#include <QTimer>
 
 #include "json.h"
 
 using QtJson::JsonObject;
 using QtJson::JsonArray;
 
+class QFileSystemWatcher;
+
 class ukccSessionServer : public QObject
 {
     Q_OBJECT
@@ -26,9 +30,26 @@ public:
 private:
     QMap<QString, QVariant> getJsonInfo(const  QString &confFile);
 
+    bool loadSecurityConfig();
+    void watchSecurityConfig();
+    void securityConfigFileChanged();
+
+private:
+    QString          mConfigFile;
+    // 解析后的隐藏状态，D-Bus调用直接返回，不再每次读文件
+    QVariantMap      mModuleMap;
+
+    // 最近一次解析时文件的状态，用于过滤~/.config目录中无关文件的变化
+    bool             mFileExists;
+    qint64           mFileSize;
+    QDateTime        mFileTime;
+
+    QFileSystemWatcher * mWatcher;
+    QTimer           mReloadTimer;
 
 Q_SIGNALS:
     void configChanged();
+    void moduleHideStatusChanged(QVariantMap status);
 
 public slots:
     void exitService();
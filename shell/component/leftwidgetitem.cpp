@@ -22,9 +22,10 @@
 #include <QPainter>
 #include <QStyleOption>
 #include <QDebug>
-#include <QSvgRenderer>
 #include <QApplication>
 
+#include "../../commonComponent/ImageUtil/imageutil.h"
+
 LeftWidgetItem::LeftWidgetItem(QWidget *parent) :
     QWidget(parent)
 {
@@ -80,7 +81,8 @@ void LeftWidgetItem::isSetLabelPixmapWhite(bool selected) {
         fileName = "://img/secondaryleftmenu/"+this->icoName+".svg";
     }
 //    qDebug()<<"file name is-------->"<<fileName<<endl;
-    QPixmap pix =  loadSvg(fileName, "blue");
+    // 二级菜单图标使用原色，选中态由单独的White图标提供
+    QPixmap pix =  loadSvg(fileName, "default");
     iconLabel->setPixmap(pix);
 }
 
@@ -118,47 +120,5 @@ const QPixmap LeftWidgetItem::loadSvg(const QString &fileName, QString color)
     } else if (3 == ratio) {
         size = 96;
     }
-    QPixmap pixmap(size, size);
-    QSvgRenderer renderer(fileName);
-    pixmap.fill(Qt::transparent);
-
-    QPainter painter;
-    painter.begin(&pixmap);
-    renderer.render(&painter);
-    painter.end();
-
-    pixmap.setDevicePixelRatio(ratio);
-    return drawSymbolicColoredPixmap(pixmap, color);
-}
-
-QPixmap LeftWidgetItem::drawSymbolicColoredPixmap(const QPixmap &source, QString cgColor)
-{
-    QImage img = source.toImage();
-    for (int x = 0; x < img.width(); x++) {
-        for (int y = 0; y < img.height(); y++) {
-            auto color = img.pixelColor(x, y);
-            if (color.alpha() > 0) {
-                if ("white" == cgColor) {
-                    color.setRed(255);
-                    color.setGreen(255);
-                    color.setBlue(255);
-                    img.setPixelColor(x, y, color);
-                } else if ("black" == cgColor) {
-                    color.setRed(0);
-                    color.setGreen(0);
-                    color.setBlue(0);
-                    img.setPixelColor(x, y, color);
-                } else if ("gray" == cgColor) {
-                    color.setRed(152);
-                    color.setGreen(163);
-                    color.setBlue(164);
-                    img.setPixelColor(x, y, color);
-                } else {
-                    return source;
-                }
-            }
-        }
-    }
-    return QPixmap::fromImage(img);
+    return ImageUtil::renderSvg(fileName, color, size);
 }
-
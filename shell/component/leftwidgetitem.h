@@ -23,7 +23,6 @@
 #include <QWidget>
 #include <QLabel>
 #include <QHBoxLayout>
-#include <QSvgRenderer>
 #include <QPixmap>
 
 class LeftWidgetItem : public QWidget
@@ -47,8 +46,6 @@ public:
 private:
     // load svg picture
     const QPixmap loadSvg(const QString &fileName, QString color);
-    // chang svg picture's color
-    QPixmap drawSymbolicColoredPixmap(const QPixmap &source, QString cgcolor);
 
 private:
     QLabel * iconLabel;
@@ -17,32 +17,40 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
  *
  */
-#include "buildpicunitsworker.h"
+#include "pluginpagehost.h"
 
-#include <QMetaType>
+#include <QScrollArea>
 
-BuildPicUnitsWorker::BuildPicUnitsWorker()
+#include "interface.h"
+
+PluginPageHost::PluginPageHost(QWidget *parent) :
+    QStackedWidget(parent)
 {
-    //自定义结构提，线程传递时无法放入列表，注册解决
-    qRegisterMetaType<BgInfo>("BgInfo");
 }
 
-BuildPicUnitsWorker::~BuildPicUnitsWorker()
+PluginPageHost::~PluginPageHost()
 {
-    delete xmlHandleObj;
+    // 插件控件归插件所有，销毁页面前先取出
+    for (QScrollArea * page : mPageMap) {
+        page->takeWidget();
+    }
 }
 
-void BuildPicUnitsWorker::run(){
-    //构建xmlhandle对象
-    xmlHandleObj = new XmlHandle();
-
-    //解析壁纸数据，如果本地xml文件不存在则自动构建
-    xmlHandleObj->init();
+void PluginPageHost::showPlugin(CommonInterface *plugin){
+    QScrollArea * page = mPageMap.value(plugin);
+    if (!page) {
+        page = createPage(plugin);
+        addWidget(page);
+        mPageMap.insert(plugin, page);
+    }
 
-    //获取本地壁纸列表
-    QMap<QString, BgInfo> wholeBgInfo = BgFileParse::bgFileReader();
-    for (BgInfo sinBfInfo : wholeBgInfo){
+    setCurrentWidget(page);
+}
 
-        emit pixmapGeneral(QPixmap(sinBfInfo.filename).scaled(QSize(166, 110)), sinBfInfo);
-    }
+QScrollArea * PluginPageHost::createPage(CommonInterface *plugin){
+    QScrollArea * page = new QScrollArea(this);
+    page->setWidgetResizable(true);
+    page->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    page->setWidget(plugin->get_plugin_ui());
+    return page;
 }
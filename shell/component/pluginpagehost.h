@@ -17,43 +17,37 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
  *
  */
-#ifndef XMLHANDLE_H
-#define XMLHANDLE_H
-
-#include <QXmlStreamReader>
-#include <QXmlStreamWriter>
-#include <QFile>
-#include <QDir>
-#include <QString>
-#include <QMap>
+#ifndef PLUGINPAGEHOST_H
+#define PLUGINPAGEHOST_H
 
-#define WALLPAPERDIR "/usr/share/ukui-background-properties/"
+#include <QStackedWidget>
+#include <QMap>
 
-class XmlHandle{
+class QScrollArea;
+class CommonInterface;
 
-public:
-    XmlHandle();
-    ~XmlHandle();
+/**
+ * \brief PluginPageHost
+ * 功能页容器：每个插件页面包在独立的QScrollArea中常驻，
+ * 切换时只切换当前页，不再反复拆装插件控件，滚动位置随页面保留。
+ * 插件控件本就由插件缓存常驻，页面只多出一层QScrollArea，因此不设数量上限。
+ */
+class PluginPageHost : public QStackedWidget
+{
+    Q_OBJECT
 
 public:
-    void init();
-    void xmlreader(QString filename);
-    void xmlUpdate(QMap<QString, QMap<QString, QString>> wallpaperinfosMap);
-    QMap<QString, QMap<QString, QString> > requireXmlData();
+    explicit PluginPageHost(QWidget *parent = 0);
+    ~PluginPageHost();
 
 public:
-    QString localconf;
+    void showPlugin(CommonInterface * plugin);
 
 private:
-    QDir xmlDir;
+    QScrollArea * createPage(CommonInterface * plugin);
 
 private:
-    QStringList _getXmlFiles(QString path);
-    void _parseWallpaper(QXmlStreamReader &reader);
-    void _xmlGenerate();
-
-    QMap<QString, QMap<QString, QString>> wallpapersMap;
-
+    QMap<CommonInterface *, QScrollArea *> mPageMap;
 };
 
-#endif // XMLHANDLE_H
+#endif // PLUGINPAGEHOST_H
@@ -34,6 +34,7 @@
 #include "utils/functionselect.h"
 #include "component/hoverwidget.h"
 #include "./utils/utils.h"
+#include "../commonComponent/ImageUtil/imageutil.h"
 
 HomePageWidget::HomePageWidget(QWidget *parent) :
     QWidget(parent),
@@ -82,12 +83,6 @@ void HomePageWidget::initUI(){
         QString modulenameString = kvConverter->keycodeTokeystring(moduleIndex).toLower();
         QString modulenamei18nString = kvConverter->keycodeTokeyi18nstring(moduleIndex);
 
-        if (mModuleMap.keys().contains(modulenameString)) {
-            if (!mModuleMap[modulenameString].toBool()) {
-                continue;
-            }
-        }
-
         //构建首页8个模块
         //基础Widget
         QWidget * baseWidget = new QWidget;
@@ -114,17 +109,10 @@ void HomePageWidget::initUI(){
         connect(widget, &ResHoverWidget::widgetClicked, [=](QString moduleName){
             int moduleIndex = kvConverter->keystringTokeycode(moduleName);
 
-            //获取模块的第一项跳转
-            QString firstFunc;
-            QList<FuncInfo> tmpList = FunctionSelect::funcinfoList[moduleIndex];
-            for (FuncInfo tmpStruct : tmpList){
-                if (moduleMap.keys().contains(tmpStruct.namei18nString)){
-                    firstFunc = tmpStruct.namei18nString;
-                    //跳转
-                    pmainWindow->functionBtnClicked(moduleMap.value(firstFunc));
-                    break;
-                }
-            }
+            //获取模块的第一项跳转，跳过被隐藏的功能
+            QObject * firstFunc = pmainWindow->firstVisibleFunc(moduleIndex);
+            if (firstFunc)
+                pmainWindow->functionBtnClicked(firstFunc);
         });
 
         QHBoxLayout * mainHorLayout = new QHBoxLayout(widget);
@@ -163,14 +151,9 @@ void HomePageWidget::initUI(){
             if (!single.mainShow)
                 continue;
 
-            if (mModuleMap.keys().contains(single.nameString.toLower())) {
-                if (!mModuleMap[single.nameString.toLower()].toBool()) {
-                    continue;
-                }
-            }
-
             ClickLabel * label = new ClickLabel(single.namei18nString, widget);
             label->setStyleSheet("color: palette(Shadow);");
+            mFuncLabels.insert(single.nameString.toLower(), label);
 
             connect(label, SIGNAL(clicked()), moduleSignalMapper, SLOT(map()));
             moduleSignalMapper->setMapping(label, moduleMap[single.namei18nString]);
@@ -232,11 +215,32 @@ void HomePageWidget::initUI(){
         item->setSizeHint(QSize(360, 100));
         ui->listWidget->addItem(item);
         ui->listWidget->setItemWidget(item, baseWidget);
+        mModuleItems.insert(modulenameString, item);
     }
     connect(moduleSignalMapper, SIGNAL(mapped(QObject*)), pmainWindow, SLOT(functionBtnClicked(QObject*)));
+
+    updateItemVisible();
     //    connect(ui->listWidget, SIGNAL(itemPressed(QListWidgetItem *)), this, SLOT(slotItemPressed(QListWidgetItem *)));
 }
 
+void HomePageWidget::setModuleHideStatus(const QVariantMap &status) {
+    mModuleMap = status;
+    updateItemVisible();
+}
+
+void HomePageWidget::updateItemVisible() {
+    for (auto it = mModuleItems.constBegin(); it != mModuleItems.constEnd(); it++) {
+        it.value()->setHidden(isHidden(it.key()));
+    }
+    for (auto it = mFuncLabels.constBegin(); it != mFuncLabels.constEnd(); it++) {
+        it.value()->setVisible(!isHidden(it.key()));
+    }
+}
+
+bool HomePageWidget::isHidden(const QString &name) const {
+    return mModuleMap.contains(name) && !mModuleMap.value(name).toBool();
+}
+
 const QPixmap HomePageWidget::loadSvg(const QString &fileName, COLOR color)
 {
     int size = 48;
@@ -246,48 +250,17 @@ const QPixmap HomePageWidget::loadSvg(const QString &fileName, COLOR color)
     } else if (3 == ratio) {
         size = 144;
     }
-    QPixmap pixmap(size, size);
-    QSvgRenderer renderer(fileName);
-    pixmap.fill(Qt::transparent);
-
-    QPainter painter;
-    painter.begin(&pixmap);
-    renderer.render(&painter);
-    painter.end();
-
-    pixmap.setDevicePixelRatio(ratio);
-    return drawSymbolicColoredPixmap(pixmap, color);
-}
 
-QPixmap HomePageWidget::drawSymbolicColoredPixmap(const QPixmap &source, COLOR cgColor)
-{
-    QImage img = source.toImage();
-    for (int x = 0; x < img.width(); x++) {
-        for (int y = 0; y < img.height(); y++) {
-            auto color = img.pixelColor(x, y);
-            if (color.alpha() > 0) {
-                if ( WHITE == cgColor) {
-                    color.setRed(255);
-                    color.setGreen(255);
-                    color.setBlue(255);
-                    img.setPixelColor(x, y, color);
-                } else if( BLACK == cgColor) {
-                    color.setRed(0);
-                    color.setGreen(0);
-                    color.setBlue(0);
-                    img.setPixelColor(x, y, color);
-                } else if (GRAY == cgColor) {
-                    color.setRed(152);
-                    color.setGreen(163);
-                    color.setBlue(164);
-                    img.setPixelColor(x, y, color);
-                } else {
-                    return source;
-                }
-            }
-        }
+    // BLUE为图标原色，不需要着色
+    QString colorName = "default";
+    if (WHITE == color) {
+        colorName = "white";
+    } else if (BLACK == color) {
+        colorName = "black";
+    } else if (GRAY == color) {
+        colorName = "gray";
     }
-    return QPixmap::fromImage(img);
+    return ImageUtil::renderSvg(fileName, colorName, size);
 }
 
 /*
@@ -301,8 +274,6 @@ void HomePageWidget::slotItemPressed(QListWidgetItem *item)
         return;
 
     int moduleIndex = ui->listWidget->currentRow();
-    QMap<QString, QObject *> moduleMap;
-    moduleMap = pmainWindow->exportModule(moduleIndex);
 
     QWidget *currentWidget = QApplication::widgetAt(QCursor::pos());
     QLabel *label = dynamic_cast<QLabel*>(currentWidget);
@@ -313,24 +284,9 @@ void HomePageWidget::slotItemPressed(QListWidgetItem *item)
 
     if(label != nullptr || hoverWidget != nullptr)
     {
-        QString targetString = "";
-        QList<FuncInfo> tmpList = FunctionSelect::funcinfoList[moduleIndex];
-        for (int funcIndex = 0; funcIndex < tmpList.size(); funcIndex++) {
-            FuncInfo single = tmpList.at(funcIndex);
-            //跳过插件不存在的功能项
-            if (!moduleMap.contains(single.namei18nString)) {
-                continue;
-            }
-            // if targetString is already been found, there is no need to continue this cycle
-            if(!targetString.isEmpty())
-                break;
-
-            targetString = single.namei18nString;
-        }
-        if(targetString .isEmpty()) {
-            pmainWindow->functionBtnClicked(moduleMap.first()); //QMap是无序的，不能保证跳转到第一项
-        } else {
-            pmainWindow->functionBtnClicked(moduleMap[targetString]);
-        }
+        //跳过插件不存在及被隐藏的功能项
+        QObject * firstFunc = pmainWindow->firstVisibleFunc(moduleIndex);
+        if (firstFunc)
+            pmainWindow->functionBtnClicked(firstFunc);
     }
 }
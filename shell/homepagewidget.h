@@ -25,6 +25,7 @@
 #include <QPainter>
 #include <QSvgRenderer>
 #include <QVariantMap>
+#include <QMultiMap>
 
 enum COLOR{
     BLUE,
@@ -35,6 +36,7 @@ enum COLOR{
 
 class MainWindow;
 class QListWidgetItem;
+class ClickLabel;
 
 namespace Ui {
 class HomePageWidget;
@@ -50,12 +52,14 @@ public:
 
 public:
     void initUI();
+    void setModuleHideStatus(const QVariantMap &status);
 
 private:
+    void updateItemVisible();
+    bool isHidden(const QString &name) const;
+
     // load svg picture
     const QPixmap loadSvg(const QString &fileName, COLOR color);
-    // chang svg picture's color
-    QPixmap drawSymbolicColoredPixmap(const QPixmap &source, COLOR color);
 
 private slots:
     void slotItemPressed(QListWidgetItem *item);
@@ -65,6 +69,10 @@ private:
     MainWindow * pmainWindow;
 
     QVariantMap mModuleMap;
+
+    // 隐藏的模块和功能同样构建，安全配置变化时只切换可见性
+    QMap<QString, QListWidgetItem *> mModuleItems;
+    QMultiMap<QString, ClickLabel *> mFuncLabels;
 };
 
 #endif // HOMEPAGEWIDGET_H
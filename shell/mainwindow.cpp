@@ -22,6 +22,8 @@
 #include "utils/keyvalueconverter.h"
 #include "utils/functionselect.h"
 #include "utils/utils.h"
+#include "utils/pluginentry.h"
+#include "utils/capabilityprobe.h"
 #include "../commonComponent/ImageUtil/imageutil.h"
 #include "ukccabout.h"
 
@@ -30,7 +32,6 @@
 #include <QPushButton>
 #include <QButtonGroup>
 #include <QHBoxLayout>
-#include <QPluginLoader>
 #include <QPainter>
 #include <QPainterPath>
 #include <QProcess>
@@ -38,14 +39,13 @@
 #include <QMessageBox>
 #include <QGSettings>
 #include <QMenu>
+#include <QDBusConnection>
 
 #ifdef WITHKYSEC
 #include <kysec/libkysec.h>
 #include <kysec/status.h>
 #endif
 
-const QByteArray kVinoSchemas    = "org.gnome.Vino";
-
 /* qt会将glib里的signals成员识别为宏，所以取消该宏
  * 后面如果用到signals时，使用Q_SIGNALS代替即可
  **/
@@ -65,6 +65,10 @@ MainWindow::MainWindow(QWidget *parent) :
     ui(new Ui::MainWindow),
     m_searchWidget(nullptr)
 {
+    // 插件过滤所需的环境探测与界面初始化并行
+    mCapabilityProbe = new CapabilityProbe(this);
+    mCapabilityProbe->start();
+
     mate_mixer_init();
     // 设置初始大小
     this->setMinimumSize(895, 600);
@@ -145,7 +149,7 @@ void MainWindow::bootOptionsSwitch(int moduleNum, int funcNum){
 
     QMap<QString, QObject *> pluginsObjMap = modulesList.at(moduleNum);
 
-    if (pluginsObjMap.keys().contains(funcStr)){
+    if (pluginsObjMap.keys().contains(funcStr) && !modulepageWidget->isPluginHidden(pluginsObjMap.value(funcStr))){
         //开始跳转
         ui->stackedWidget->setCurrentIndex(1);
         modulepageWidget->switchPage(pluginsObjMap.value(funcStr));
@@ -228,6 +232,8 @@ void MainWindow::initUI() {
     ui->centralWidget->setStyleSheet("QWidget#centralWidget{background: palette(base); border-radius: 6px;}");
 
     m_ModuleMap = Utils::getModuleHideStatus();
+    QDBusConnection::sessionBus().connect("org.ukui.ukcc.session", "/", "org.ukui.ukcc.session.interface",
+                                          "moduleHideStatusChanged", this, SLOT(moduleHideStatusChangedSlot(QVariantMap)));
 
     this->installEventFilter(this);
 
@@ -488,49 +494,38 @@ void MainWindow::loadPlugins(){
             continue;
         } else if (fileName == "libexperienceplan.so") {
             continue;
-        } else if ("libnetworkaccount.so" == fileName && !isExitsCloudAccount()) {
+        } else if ("libnetworkaccount.so" == fileName && !mCapabilityProbe->isAvailable(CapabilityProbe::CLOUDACCOUNT)) {
             continue;
-        } else if (!QGSettings::isSchemaInstalled(kVinoSchemas) && "libvino.so" == fileName) {
+        } else if ("libvino.so" == fileName && !mCapabilityProbe->isAvailable(CapabilityProbe::VINO)) {
             continue;
-        } else if ("libbluetooth.so" == fileName && !isExitBluetooth()) {
+        } else if ("libbluetooth.so" == fileName && !mCapabilityProbe->isAvailable(CapabilityProbe::BLUETOOTH)) {
             continue;
         }
 
         qDebug() << "Scan Plugin: " << fileName;
 
-        //ukui-session-manager
-        const char * sessionFile = "/usr/share/glib-2.0/schemas/org.ukui.session.gschema.xml";
-        //ukui-screensaver
-        const char * screensaverFile = "/usr/share/glib-2.0/schemas/org.ukui.screensaver.gschema.xml";
-
         //屏保功能依赖ukui-session-manager
-        if ((!g_file_test(screensaverFile, G_FILE_TEST_EXISTS) ||
-             !g_file_test(sessionFile, G_FILE_TEST_EXISTS)) &&
-                (fileName == "libscreensaver.so" || fileName == "libscreenlock.so"))
+        if ((fileName == "libscreensaver.so" || fileName == "libscreenlock.so") &&
+                !mCapabilityProbe->isAvailable(CapabilityProbe::SCREENSAVER))
             continue;
 
-        const char * securityCmd = "/usr/sbin/ksc-defender";
-
-        if ((!g_file_test(securityCmd, G_FILE_TEST_EXISTS)) && (fileName == "libsecuritycenter.so"))
+        if (fileName == "libsecuritycenter.so" && !mCapabilityProbe->isAvailable(CapabilityProbe::SECURITYCENTER))
             continue;
 
-        QPluginLoader loader(pluginsDir.absoluteFilePath(fileName));
-        QObject * plugin = loader.instance();
-        if (plugin) {
-            CommonInterface * pluginInstance = qobject_cast<CommonInterface *>(plugin);
-            modulesList[pluginInstance->get_plugin_type()].insert(pluginInstance->get_plugin_name(), plugin);
+        //只读取插件元数据，插件在首次切换到对应页面时才加载
+        PluginEntry * plugin = new PluginEntry(pluginsDir.absoluteFilePath(fileName), this);
+        if (plugin->probe()) {
+            modulesList[plugin->pluginType()].insert(plugin->pluginName(), plugin);
 
-            qDebug() << "Load Plugin :" << kvConverter->keycodeTokeyi18nstring(pluginInstance->get_plugin_type()) << "->" << pluginInstance->get_plugin_name() ;
+            qDebug() << "Register Plugin :" << kvConverter->keycodeTokeyi18nstring(plugin->pluginType()) << "->" << plugin->pluginName() ;
 
-            m_searchWidget->addModulesName(pluginInstance->name(), pluginInstance->get_plugin_name(), pluginInstance->translationPath());
+            m_searchWidget->addModulesName(plugin->name(), plugin->pluginName(), plugin->translationPath());
 
-            int moduletypeInt = pluginInstance->get_plugin_type();
+            int moduletypeInt = plugin->pluginType();
             if (!moduleIndexList.contains(moduletypeInt))
                 moduleIndexList.append(moduletypeInt);
         } else {
-            //如果加载错误且文件后缀为so，输出错误
-            if (fileName.endsWith(".so"))
-                qDebug() << fileName << "Load Failed: " << loader.errorString() << "\n";
+            delete plugin;
         }
     }
     m_searchWidget->setLanguage(QLocale::system().name());
@@ -558,12 +553,6 @@ void MainWindow::initLeftsideBar(){
             QString mnameString = kvConverter->keycodeTokeystring(type);
             QString mnamei18nString  = kvConverter->keycodeTokeyi18nstring(type); //设置TEXT
 
-            if (m_ModuleMap.keys().contains(mnameString.toLower())) {
-                if (!m_ModuleMap[mnameString.toLower()].toBool()) {
-                    continue;
-                }
-            }
-
             QPushButton * button;
             QString btnName = "btn" + QString::number(type + 1);
             button = buildLeftsideBtn(mnameString,mnamei18nString);
@@ -582,15 +571,9 @@ void MainWindow::initLeftsideBar(){
                 int selectedInt = leftBtnGroup->id(btn);
 
                 //获取一级菜单列表的第一项
-                QList<FuncInfo> tmpList = FunctionSelect::funcinfoList[selectedInt];
-                QMap<QString, QObject *> currentFuncMap = modulesList[selectedInt];
-
-                for (FuncInfo tmpStruct : tmpList){
-                    if (currentFuncMap.keys().contains(tmpStruct.namei18nString)){
-                        modulepageWidget->switchPage(currentFuncMap.value(tmpStruct.namei18nString));
-                        break;
-                    }
-                }
+                QObject * plugin = firstVisibleFunc(selectedInt);
+                if (plugin)
+                    modulepageWidget->switchPage(plugin);
             });
 
             ui->leftsidebarVerLayout->addWidget(button);
@@ -598,6 +581,22 @@ void MainWindow::initLeftsideBar(){
     }
 
     ui->leftsidebarVerLayout->addStretch();
+
+    //隐藏的模块也构建按钮，安全配置变化时只切换可见性
+    updateLeftsideBarVisible();
+}
+
+void MainWindow::updateLeftsideBarVisible() {
+    for (QAbstractButton * button : leftBtnGroup->buttons()) {
+        QString mnameString = kvConverter->keycodeTokeystring(leftBtnGroup->id(button)).toLower();
+        bool visible = !m_ModuleMap.contains(mnameString) || m_ModuleMap[mnameString].toBool();
+
+        //当前所在模块被隐藏时回到首页
+        if (!visible && button->isChecked() && ui->stackedWidget->currentIndex() != 0) {
+            ui->stackedWidget->setCurrentIndex(0);
+        }
+        button->setVisible(visible);
+    }
 }
 
 QPushButton * MainWindow::buildLeftsideBtn(QString bname,QString tipName) {
@@ -677,23 +676,6 @@ QPushButton * MainWindow::buildLeftsideBtn(QString bname,QString tipName) {
     return leftsidebarBtn;
 }
 
-bool MainWindow::isExitsCloudAccount() {
-    QProcess *wifiPro = new QProcess();
-    QString shellOutput = "";
-    wifiPro->start("dpkg -l  | grep kylin-sso-client");
-    wifiPro->waitForFinished();
-    QString output = wifiPro->readAll();
-    shellOutput += output;
-    QStringList slist = shellOutput.split("\n");
-
-    for (QString res : slist) {
-        if (res.contains("kylin-sso-client")) {
-            return true;
-        }
-    }
-    return false;
-}
-
 bool MainWindow::dblOnEdge(QMouseEvent *event) {
     QPoint pos = event->globalPos();
     int globalMouseY = pos.y();
@@ -749,15 +731,6 @@ void MainWindow::initStyleSheet() {
     closeBtn->setIcon(QIcon::fromTheme("window-close-symbolic"));
 }
 
-bool MainWindow::isExitBluetooth() {
-    QProcess process;
-    process.start("rfkill list");
-    process.waitForFinished();
-    QByteArray output = process.readAllStandardOutput();
-    QString str_output = output;
-    return str_output.contains(QString("bluetooth"), Qt::CaseInsensitive);
-}
-
 void MainWindow::setModuleBtnHightLight(int id) {
     leftBtnGroup->button(id)->setChecked(true);
     leftMicBtnGroup->button(id)->setChecked(true);
@@ -771,7 +744,31 @@ QMap<QString, QObject *> MainWindow::exportModule(int type) {
         return emptyMaps;
 }
 
+// 按功能列表顺序返回模块下第一个存在且未被隐藏的功能，隐藏状态可能在运行时变化，需在点击时查询
+QObject * MainWindow::firstVisibleFunc(int moduleIndex) {
+    QMap<QString, QObject *> moduleMap = exportModule(moduleIndex);
+    for (const FuncInfo &tmpStruct : FunctionSelect::funcinfoList.value(moduleIndex)) {
+        QObject * plugin = moduleMap.value(tmpStruct.namei18nString);
+        if (plugin && !modulepageWidget->isPluginHidden(plugin))
+            return plugin;
+    }
+    return nullptr;
+}
+
+void MainWindow::moduleHideStatusChangedSlot(QVariantMap status) {
+    Utils::setModuleHideStatus(status);
+    m_ModuleMap = status;
+    homepageWidget->setModuleHideStatus(status);
+    //当前模块的功能全部被隐藏时回到首页
+    if (!modulepageWidget->updateModuleHideStatus(status) && ui->stackedWidget->currentIndex() != 0) {
+        ui->stackedWidget->setCurrentIndex(0);
+    }
+    updateLeftsideBarVisible();
+}
+
 void MainWindow::functionBtnClicked(QObject *plugin) {
+    if (modulepageWidget->isPluginHidden(plugin))
+        return;
     ui->stackedWidget->setCurrentIndex(1);
     modulepageWidget->switchPage(plugin);
 }
@@ -793,7 +790,7 @@ void MainWindow::switchPage(QString moduleName) {
     for (int i = 0; i < modulesList.length(); i++) {
         auto modules = modulesList.at(i);
         //开始跳转
-        if (modules.keys().contains(moduleName)) {
+        if (modules.keys().contains(moduleName) && !modulepageWidget->isPluginHidden(modules.value(moduleName))) {
             ui->stackedWidget->setCurrentIndex(1);
             modulepageWidget->switchPage(modules.value(moduleName));
         }
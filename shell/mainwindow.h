@@ -41,6 +41,7 @@ class QLabel;
 class QPushButton;
 class QButtonGroup;
 class KeyValueConverter;
+class CapabilityProbe;
 
 namespace Ui {
 class MainWindow;
@@ -56,6 +57,7 @@ public:
 
 public:
     QMap<QString, QObject *> exportModule(int);
+    QObject * firstVisibleFunc(int moduleIndex);
     void setModuleBtnHightLight(int id);
 
     void bootOptionsFilter(QString opt);
@@ -79,6 +81,7 @@ private:
     QList<QMap<QString, QObject *>> modulesList;
 
     KeyValueConverter * kvConverter;
+    CapabilityProbe * mCapabilityProbe;
     SearchWidget * m_searchWidget;
 
     QPushButton *backBtn;
@@ -105,11 +108,10 @@ private:
     void loadPlugins();
     void initLeftsideBar();
     QPushButton * buildLeftsideBtn(QString bname, QString tipName);
-    bool isExitsCloudAccount();
+    void updateLeftsideBarVisible();
 
     bool dblOnEdge(QMouseEvent *event);
     void initStyleSheet();
-    bool isExitBluetooth();
 
 public slots:
     void functionBtnClicked(QObject * plugin);
@@ -117,6 +119,7 @@ public slots:
     void switchPage(QString moduleName);
     void animationFinishedSlot();
     void showUkccAboutSlot();
+    void moduleHideStatusChangedSlot(QVariantMap status);
 };
 
 #endif // MAINWINDOW_H
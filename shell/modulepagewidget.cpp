@@ -28,7 +28,9 @@
 #include "utils/keyvalueconverter.h"
 #include "utils/functionselect.h"
 #include "utils/utils.h"
+#include "utils/pluginentry.h"
 #include "component/leftwidgetitem.h"
+#include "component/pluginpagehost.h"
 
 ModulePageWidget::ModulePageWidget(QWidget *parent) :
     QWidget(parent),
@@ -53,8 +55,6 @@ ModulePageWidget::ModulePageWidget(QWidget *parent) :
     ui->leftStackedWidget->setStyleSheet("border: none;");
     // 上侧二级菜单样式
 //    ui->topStackedWidget->setStyleSheet("border: none;");
-    ui->scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-//    ui->scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 
     //初始化记录标志位
     flagBit = true;
@@ -111,12 +111,6 @@ void ModulePageWidget::initUI() {
             if (!moduleMap.contains(single.namei18nString))
                 continue;
 
-            if (mModuleMap.keys().contains(single.nameString.toLower())) {
-                if (!mModuleMap[single.nameString.toLower()].toBool()) {
-                    continue;
-                }
-            }
-
             //填充左侧二级菜单
             LeftWidgetItem * leftWidgetItem = new LeftWidgetItem(this);
             leftWidgetItem->setAttribute(Qt::WA_DeleteOnClose);
@@ -139,9 +133,9 @@ void ModulePageWidget::initUI() {
 
             strItemsMap.insert(single.namei18nString, topitem);
 
-            CommonInterface * pluginInstance = qobject_cast<CommonInterface *>(moduleMap.value(single.namei18nString));
+            PluginEntry * pluginEntry = qobject_cast<PluginEntry *>(moduleMap.value(single.namei18nString));
 
-            pluginInstanceMap.insert(single.namei18nString, pluginInstance);
+            pluginInstanceMap.insert(single.namei18nString, pluginEntry);
 
         }
 
@@ -177,6 +171,9 @@ void ModulePageWidget::initUI() {
         ui->topStackedWidget->addWidget(topListWidget);
     }
 
+    //隐藏的功能同样构建，安全配置变化时只切换可见性
+    updateItemVisible();
+
     //左侧二级菜单标题及上侧二级菜单标题随功能页变化联动
     connect(ui->leftStackedWidget, &QStackedWidget::currentChanged, this, [=](int index){
         QString titleString = mkvConverter->keycodeTokeyi18nstring(index);
@@ -189,10 +186,14 @@ void ModulePageWidget::initUI() {
 
 void ModulePageWidget::switchPage(QObject *plugin, bool recorded){
 
-    CommonInterface * pluginInstance = qobject_cast<CommonInterface *>(plugin);
+    PluginEntry * pluginEntry = qobject_cast<PluginEntry *>(plugin);
+    if (isPluginHidden(plugin)) {
+        qDebug() << "plugin is hidden by security config!";
+        return;
+    }
     QString name; int type;
-    name = pluginInstance->get_plugin_name();
-    type = pluginInstance->get_plugin_type();
+    name = pluginEntry->pluginName();
+    type = pluginEntry->pluginType();
 
     //首次点击设置模块标题后续交给回调函数
     if (ui->mtitleLabel->text().isEmpty() || ui->mmtitleLabel->text().isEmpty()){
@@ -217,7 +218,7 @@ void ModulePageWidget::switchPage(QObject *plugin, bool recorded){
         LeftWidgetItem * widget = dynamic_cast<LeftWidgetItem *>(lefttmpListWidget->itemWidget(lefttmpListWidget->currentItem()));
         //待打开页与QListWidget的CurrentItem相同
         if (QString::compare(widget->text(), name) == 0){
-            refreshPluginWidget(pluginInstance);
+            refreshPluginWidget(pluginEntry);
         }
     }
 
@@ -229,11 +230,15 @@ void ModulePageWidget::switchPage(QObject *plugin, bool recorded){
 
 }
 
-void ModulePageWidget::refreshPluginWidget(CommonInterface *plu){
-    ui->scrollArea->takeWidget();
-    delete(ui->scrollArea->widget());
+void ModulePageWidget::refreshPluginWidget(PluginEntry *entry){
+    //首次打开时才加载插件
+    CommonInterface * plu = entry->instance();
+    if (!plu) {
+        qDebug() << entry->fileName() << "plugin instance not available!";
+        return;
+    }
 
-    ui->scrollArea->setWidget(plu->get_plugin_ui());
+    ui->pageHost->showPlugin(plu);
 
     //延迟操作
     plu->plugin_delay_control();
@@ -266,6 +271,70 @@ void ModulePageWidget::getModuleStatus() {
     mModuleMap = Utils::getModuleHideStatus();
 }
 
+bool ModulePageWidget::isPluginHidden(QObject *plugin) const {
+    PluginEntry * pluginEntry = qobject_cast<PluginEntry *>(plugin);
+    if (pluginEntry == nullptr)
+        return true;
+    return isFunctionHidden(pluginEntry->pluginType(), pluginEntry->pluginName());
+}
+
+bool ModulePageWidget::isFunctionHidden(int type, const QString &name) const {
+    //模块被隐藏时其下所有功能都隐藏
+    QString moduleName = mkvConverter->keycodeTokeystring(type).toLower();
+    if (mModuleMap.contains(moduleName) && !mModuleMap.value(moduleName).toBool())
+        return true;
+
+    for (const FuncInfo &info : FunctionSelect::funcinfoList.value(type)) {
+        if (info.namei18nString == name) {
+            QString funcName = info.nameString.toLower();
+            return mModuleMap.contains(funcName) && !mModuleMap.value(funcName).toBool();
+        }
+    }
+    return false;
+}
+
+void ModulePageWidget::updateItemVisible() {
+    for (int moduleIndex = 0; moduleIndex < TOTALMODULES; moduleIndex++) {
+        QListWidget * leftListWidget = dynamic_cast<QListWidget *>(ui->leftStackedWidget->widget(moduleIndex));
+        QListWidget * topListWidget = dynamic_cast<QListWidget *>(ui->topStackedWidget->widget(moduleIndex));
+        if (leftListWidget == nullptr || topListWidget == nullptr)
+            continue;
+
+        for (int row = 0; row < leftListWidget->count(); row++) {
+            QListWidgetItem * item = leftListWidget->item(row);
+            LeftWidgetItem * widget = dynamic_cast<LeftWidgetItem *>(leftListWidget->itemWidget(item));
+            item->setHidden(isFunctionHidden(moduleIndex, widget->text()));
+        }
+        for (int row = 0; row < topListWidget->count(); row++) {
+            QListWidgetItem * item = topListWidget->item(row);
+            item->setHidden(isFunctionHidden(moduleIndex, item->text()));
+        }
+    }
+}
+
+/*
+ * 安全配置变化时更新二级菜单，当前页被隐藏则切换到同模块第一个可见的功能；
+ * 返回false表示当前模块已没有可显示的功能
+ */
+bool ModulePageWidget::updateModuleHideStatus(const QVariantMap &status) {
+    mModuleMap = status;
+    updateItemVisible();
+
+    QListWidget * leftListWidget = dynamic_cast<QListWidget *>(ui->leftStackedWidget->currentWidget());
+    if (leftListWidget == nullptr || leftListWidget->currentItem() == nullptr || !leftListWidget->currentItem()->isHidden())
+        return true;
+
+    for (int row = 0; row < leftListWidget->count(); row++) {
+        QListWidgetItem * item = leftListWidget->item(row);
+        if (item->isHidden())
+            continue;
+        LeftWidgetItem * widget = dynamic_cast<LeftWidgetItem *>(leftListWidget->itemWidget(item));
+        switchPage(pluginInstanceMap.value(widget->text()));
+        return true;
+    }
+    return false;
+}
+
 void ModulePageWidget::currentLeftitemChanged(QListWidgetItem *cur, QListWidgetItem *pre){
     //获取当前QListWidget
     QListWidget * currentLeftListWidget = dynamic_cast<QListWidget *>(ui->leftStackedWidget->currentWidget());
@@ -281,8 +350,8 @@ void ModulePageWidget::currentLeftitemChanged(QListWidgetItem *cur, QListWidgetI
 
     LeftWidgetItem * curWidgetItem = dynamic_cast<LeftWidgetItem *>(currentLeftListWidget->itemWidget(cur));
     if (pluginInstanceMap.contains(curWidgetItem->text())){
-        CommonInterface * pluginInstance = pluginInstanceMap[curWidgetItem->text()];
-        refreshPluginWidget(pluginInstance);
+        PluginEntry * pluginEntry = pluginInstanceMap[curWidgetItem->text()];
+        refreshPluginWidget(pluginEntry);
         //高亮
         curWidgetItem->setSelected(true);
         curWidgetItem->setLabelTextIsWhite(true);
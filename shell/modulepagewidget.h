@@ -25,7 +25,7 @@
 #include <QVariantMap>
 
 class MainWindow;
-class CommonInterface;
+class PluginEntry;
 class KeyValueConverter;
 
 class QListWidgetItem;
@@ -45,11 +45,16 @@ public:
 public:
     void initUI();
     void switchPage(QObject * plugin, bool recorded = true);
-    void refreshPluginWidget(CommonInterface * plu);
+    void refreshPluginWidget(PluginEntry * entry);
     void highlightItem(QString text);
 
+    bool isPluginHidden(QObject * plugin) const;
+    bool updateModuleHideStatus(const QVariantMap &status);
+
 private:
     void getModuleStatus();
+    bool isFunctionHidden(int type, const QString &name) const;
+    void updateItemVisible();
 
 private:
     Ui::ModulePageWidget *ui;
@@ -62,7 +67,7 @@ private:
     QVariantMap mModuleMap;
 
 private:
-    QMap<QString, CommonInterface*> pluginInstanceMap;
+    QMap<QString, PluginEntry*> pluginInstanceMap;
     // 存储功能名与二级菜单item的Map,为了实现高亮
     QMultiMap<QString, QListWidgetItem*> strItemsMap;
 
@@ -1,57 +1,48 @@
 #include "pinyin.h"
 
-#include <QFile>
-#include <QTextStream>
+//编译期由pinyintable.awk从dpinyin.dict生成的只读码表，随程序映射，无需运行时解析
+#include "pinyintable.h"
 
+static inline const char * PinyinOf(ushort code) {
+    if (code < kPinyinFirst || code > kPinyinLast)
+        return nullptr;
 
-static QHash<uint, QString> dict = {};
-const char kDictFile[] = ":/dpinyin.dict";
-
-static void InitDict() {
-    if (!dict.isEmpty()) {
-        return;
-    }
-
-    dict.reserve(25333);
-
-    QFile file(kDictFile);
-
-    if (!file.open(QIODevice::ReadOnly))
-        return;
-
-    QByteArray content = file.readAll();
-
-    file.close();
+    const unsigned short id = kPinyinIndex[code - kPinyinFirst];
+    return id ? kPinyinPool + kPinyinOffset[id] : nullptr;
+}
 
-    QTextStream stream(&content, QIODevice::ReadOnly);
+QString Chinese2Pinyin(const QString &words)
+{
+    QString result;
+    result.reserve(words.length() * 4);
 
-    while (!stream.atEnd()) {
-        const QString line = stream.readLine();
-        const QStringList items = line.split(QChar(':'));
+    for (const QChar &ch : words) {
+        const char * pinyin = PinyinOf(ch.unicode());
 
-        if (items.size() == 2) {
-            dict.insert(items[0].toInt(nullptr, 16), items[1]);
+        if (pinyin) {
+            result.append(QLatin1String(pinyin));
+        } else {
+            result.append(ch);
         }
     }
+
+    return result;
 }
 
-QString Chinese2Pinyin(const QString &words)
+QString Chinese2PinyinInitials(const QString &words)
 {
-    InitDict();
-
     QString result;
+    result.reserve(words.length());
 
-    for (int i = 0; i < words.length(); ++i) {
-        const uint key = words.at(i).unicode();
-        auto find_result = dict.find(key);
+    for (const QChar &ch : words) {
+        const char * pinyin = PinyinOf(ch.unicode());
 
-        if (find_result != dict.end()) {
-            result.append(find_result.value());
+        if (pinyin) {
+            result.append(QLatin1Char(pinyin[0]));
         } else {
-            result.append(words.at(i));
+            result.append(ch);
         }
     }
 
     return result;
 }
-
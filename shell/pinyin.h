@@ -2,9 +2,9 @@
 #define KPINYIN_H
 
 
-#include <QHash>
 #include <QString>
 
 
 QString Chinese2Pinyin(const QString& words);
+QString Chinese2PinyinInitials(const QString& words);
 #endif // KPINYIN_H
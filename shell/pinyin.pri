@@ -0,0 +1,21 @@
+##汉字转拼音，码表在编译期由dpinyin.dict生成
+PINYIN_DICT = $$PWD/res/dpinyin.dict
+
+pinyintable.input = PINYIN_DICT
+pinyintable.output = $$OUT_PWD/pinyintable.h
+pinyintable.commands = awk -f $$PWD/pinyintable.awk ${QMAKE_FILE_IN} > ${QMAKE_FILE_OUT}
+pinyintable.depends = $$PWD/pinyintable.awk
+pinyintable.CONFIG += no_link target_predeps
+QMAKE_EXTRA_COMPILERS += pinyintable
+
+INCLUDEPATH += $$OUT_PWD
+
+SOURCES += \
+        $$PWD/pinyin.cpp \
+
+HEADERS += \
+        $$PWD/pinyin.h \
+
+DISTFILES += \
+        $$PWD/pinyintable.awk \
+        $$PINYIN_DICT
@@ -0,0 +1,73 @@
+#
+# 由dpinyin.dict("0x3400:qiu1")生成pinyintable.h:
+# kPinyinIndex按码位直接索引音节编号(0表示无读音)，音节字符串集中存放在kPinyinPool中
+#
+# 用法: awk -f pinyintable.awk dpinyin.dict > pinyintable.h
+#
+
+function hex2dec(str,    i, c, n) {
+    n = 0
+    str = tolower(str)
+    sub(/^0x/, "", str)
+    for (i = 1; i <= length(str); i++) {
+        c = index("0123456789abcdef", substr(str, i, 1))
+        n = n * 16 + c - 1
+    }
+    return n
+}
+
+BEGIN {
+    FS = ":"
+    count = 0
+    poolSize = 0
+    first = -1
+    last = -1
+}
+
+NF == 2 {
+    sub(/\r$/, "", $2)
+    code = hex2dec($1)
+    if (!($2 in syllableId)) {
+        count++
+        syllableId[$2] = count
+        syllable[count] = $2
+        offset[count] = poolSize
+        poolSize += length($2) + 1
+    }
+    table[code] = syllableId[$2]
+    if (first < 0 || code < first)
+        first = code
+    if (code > last)
+        last = code
+}
+
+END {
+    print "/* 由 pinyintable.awk 从 dpinyin.dict 生成，请勿手动修改 */"
+    print "#ifndef PINYINTABLE_H"
+    print "#define PINYINTABLE_H"
+    print ""
+    printf "static const unsigned int kPinyinFirst = 0x%x;\n", first
+    printf "static const unsigned int kPinyinLast = 0x%x;\n", last
+    print ""
+    print "static const char kPinyinPool[] ="
+    for (i = 1; i <= count; i++)
+        printf "    \"%s\\0\"\n", syllable[i]
+    print "    ;"
+    print ""
+    print "static const unsigned short kPinyinOffset[] = {"
+    printf "    0,"
+    for (i = 1; i <= count; i++)
+        printf "%s%d,", (i % 16 == 0 ? "\n    " : " "), offset[i]
+    print "\n};"
+    print ""
+    print "static const unsigned short kPinyinIndex[] = {"
+    for (code = first; code <= last; code++) {
+        if ((code - first) % 16 == 0)
+            printf "    "
+        printf "%d,", (code in table) ? table[code] : 0
+        printf "%s", ((code - first) % 16 == 15 || code == last) ? "\n" : " "
+    }
+    print "};"
+    print ""
+    print "#endif // PINYINTABLE_H"
+}
@@ -0,0 +1,55 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include <QCoreApplication>
+#include <QRegularExpression>
+#include <QTextStream>
+
+#include "pinyin.h"
+#include "utils/searchindex.h"
+
+/*
+ * 用法: ukcc-searchindexer <input.ts> <output.idx>
+ * 解析翻译文件中的搜索条目并预先计算拼音，写入SearchIndex格式的索引文件
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream err(stderr);
+
+    const QStringList args = app.arguments();
+    if (args.length() != 3) {
+        err << "usage: " << args.at(0) << " <input.ts> <output.idx>" << endl;
+        return 1;
+    }
+
+    QList<SearchIndex::Entry> entries = SearchIndex::parseTs(args.at(1));
+    for (SearchIndex::Entry &data : entries) {
+        //与搜索框一致，拼音中去掉声调数字
+        data.pinyin = Chinese2Pinyin(data.translateContent).remove(QRegularExpression("[0-9]"));
+        data.initials = Chinese2PinyinInitials(data.translateContent);
+    }
+
+    if (!SearchIndex::write(args.at(2), entries)) {
+        err << "write " << args.at(2) << " failed" << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#-------------------------------------------------
+#
+# 编译期生成设置搜索索引的工具，不安装
+#
+#-------------------------------------------------
+
+QT       = core
+
+TARGET = ukcc-searchindexer
+TEMPLATE = app
+
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+INCLUDEPATH += ..
+
+include(../pinyin.pri)
+
+SOURCES += \
+    main.cpp \
+    ../utils/searchindex.cpp
+
+HEADERS += \
+    ../utils/searchindex.h
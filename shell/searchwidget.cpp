@@ -6,9 +6,11 @@
 #include <QLineEdit>
 #include <QListWidget>
 #include <QPushButton>
-#include <QXmlStreamReader>
 #include <QCompleter>
-#include <QRegularExpression>
+#include <QAbstractItemView>
+
+//下拉框最多显示的搜索结果数
+const int kMaxCompletions = 30;
 
 class ukCompleter : public QCompleter
 {
@@ -24,66 +26,27 @@ public:
 
 SearchWidget::SearchWidget(QWidget *parent)
     : QLineEdit(parent)
-    , m_xmlExplain("")
     , m_bIsChinese(false)
-    , m_searchValue("")
-    , m_bIstextEdited(false)
 {
-    m_model = new QStandardItemModel(this);
+    m_model = new QStringListModel(this);
     m_completer = new ukCompleter(m_model, this);
-    m_completer->setFilterMode(Qt::MatchContains);//设置QCompleter支持匹配字符搜索
-    m_completer->setCaseSensitivity(Qt::CaseInsensitive);//这个属性可设置进行匹配时的大小写敏感性
-    m_completer->setCompletionRole(Qt::UserRole); //设置ItemDataRole
-    this->setCompleter(m_completer);
+    //候选项由SearchEngine排序过滤，QCompleter只负责弹出显示
+    m_completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    m_completer->setWidget(this);
     m_completer->setWrapAround(false);
     m_completer->installEventFilter(this);
 
-    connect(this, &QLineEdit::textEdited, this, [ = ] {
-        if (text() != "") {
-            m_bIstextEdited = true;
-        } else {
-            m_bIstextEdited = false;
-        }
-    });
-
-    connect(this, &QLineEdit::textChanged, this, [ = ] {
-        QString retValue = text();
-        if (m_bIstextEdited) {
-            m_bIstextEdited = false;
-            return ;
-        }
-
-        //避免输入单个字符，直接匹配到第一个完整字符(导致不能匹配正确的字符)
-        if ("" == retValue || m_searchValue.contains(retValue, Qt::CaseInsensitive)) {
-            m_searchValue = retValue;
-            return ;
-        }
-
-        retValue = transPinyinToChinese(text());
-
-        //拼音转化没找到，再搜索字符包含关联字符
-        if (retValue == text()) {
-            retValue = containTxtData(retValue);
-        }
-
-        m_searchValue = retValue;
-
-        this->setText(retValue);
-    });
+    connect(this, &QLineEdit::textEdited, this, &SearchWidget::updateCompletions);
 
     connect(this, &QLineEdit::returnPressed, this, [ = ] {
 
         if (!text().isEmpty()) {
             //enter defalt set first
-            if (!jumpContentPathWidget(text())) {
-                const QString &currentCompletion = this->completer()->currentCompletion();
-                qDebug() << Q_FUNC_INFO << " [SearchWidget] currentCompletion : " << currentCompletion;
-
-                //中文遍历一遍,若没有匹配再遍历将拼音转化为中文再遍历
-                //解决输入拼音时,有配置数据后,直接回车无法进入第一个匹配数据页面的问题
-                if (!jumpContentPathWidget(currentCompletion)) {
-                    jumpContentPathWidget(transPinyinToChinese(currentCompletion));
-                }
+            if (!jumpContentPathWidget(text()) && m_model->rowCount() > 0) {
+                //输入拼音或部分文字时直接回车，进入排序第一的页面
+                const QString &firstCompletion = m_model->index(0, 0).data().toString();
+                qDebug() << Q_FUNC_INFO << " [SearchWidget] firstCompletion : " << firstCompletion;
+                jumpContentPathWidget(firstCompletion);
             }
         }
     });
@@ -95,13 +58,13 @@ SearchWidget::SearchWidget(QWidget *parent)
     connect(m_completer, QOverload<const QString &>::of(&QCompleter::activated),
             [=](const QString &text) {
 #endif
-        Q_UNUSED(text);
+        setText(text);
         Q_EMIT returnPressed();
     });
 }
 
 SearchWidget::~SearchWidget() {
-
+    qDeleteAll(m_searchIndexMap);
 }
 
 bool SearchWidget::jumpContentPathWidget(QString path) {
@@ -135,141 +98,120 @@ bool SearchWidget::jumpContentPathWidget(QString path) {
 }
 
 void SearchWidget::loadxml() {
-    if (!m_EnterNewPagelist.isEmpty()) {
-        m_EnterNewPagelist.clear();
-    }
+    m_EnterNewPagelist.clear();
+    m_searchEngine.clear();
+    m_model->setStringList(QStringList());
 
-    if (!m_inputList.isEmpty()) {
-        m_inputList.clear();
-    }
+    for (const QString i : m_xmlFilePath) {
+        QList<SearchIndex::Entry> entries = loadEntries(i);
+
+        for (const SearchIndex::Entry &entry : entries) {
+            m_searchBoxStruct.translateContent = entry.translateContent;
+            m_searchBoxStruct.translatePinyin = entry.pinyin;
+            m_searchBoxStruct.translateInitials = entry.initials;
+            m_searchBoxStruct.fullPagePath = entry.fullPagePath;
+            // follow path module name to get actual module name  ->  Left module dispaly can support
+            // mulLanguages
+            m_searchBoxStruct.actualModuleName =
+                    getModulesName(m_searchBoxStruct.fullPagePath.section('/', 1, 1));
+
+            //文档id即在m_EnterNewPagelist中的下标
+            QStringList keys;
+            keys << displayText(m_searchBoxStruct);
+            if (m_bIsChinese) {
+                //全拼及拼音首字母，如 "xianshiqi --> fenbianlv" 与 "xsq --> fbl"
+                QString pinyin = m_searchBoxStruct.translatePinyin.isEmpty()
+                        ? toPinyin(m_searchBoxStruct.translateContent) : m_searchBoxStruct.translatePinyin;
+                QString initials = m_searchBoxStruct.translateInitials.isEmpty()
+                        ? toInitials(m_searchBoxStruct.translateContent) : m_searchBoxStruct.translateInitials;
+                keys << QString("%1 --> %2").arg(toPinyin(m_searchBoxStruct.actualModuleName)).arg(pinyin);
+                keys << QString("%1 --> %2").arg(toInitials(m_searchBoxStruct.actualModuleName)).arg(initials);
+            }
+            m_searchEngine.addDocument(m_EnterNewPagelist.count(), keys);
+            m_EnterNewPagelist.append(m_searchBoxStruct);
 
-    if (m_model->rowCount() > 0) {
-        QStandardItem *item = nullptr;
-        for (int i = 0; i < m_model->rowCount(); i++) {
-            item = m_model->takeItem(i);
-            delete item;
-            item = nullptr;
+            clearSearchData();
         }
-        m_model->clear();
-    }
-
-    //添加一项空数据，为了防止使用setText输入错误数据时直接跳转到list中正确的第一个页面
-    m_searchBoxStruct.fullPagePath = "";
-    m_searchBoxStruct.actualModuleName = "";
-    m_searchBoxStruct.translateContent = "";
-    m_searchBoxStruct.childPageName = "";
-    m_EnterNewPagelist.append(m_searchBoxStruct);
-    m_inputList.append(SearchDataStruct());
-    m_model->appendRow(new QStandardItem(""));
 
-    auto isChineseFunc = [](const QString &str)->bool {
-        QRegularExpression rex_expression(R"(^[^a-zA-Z]+$)");
-        return rex_expression.match(str).hasMatch();
-    };
+        qDebug() << " [SearchWidget] m_EnterNewPagelist.count : " << m_EnterNewPagelist.count();
+    }
+}
 
+void SearchWidget::updateCompletions(const QString &text) {
+    QStringList completions;
+    for (int id : m_searchEngine.query(text, kMaxCompletions)) {
+        completions << displayText(m_EnterNewPagelist.at(id));
+    }
+    m_model->setStringList(completions);
 
-    for (const QString i : m_xmlFilePath) {
+    if (completions.isEmpty()) {
+        m_completer->popup()->hide();
+    } else {
+        m_completer->complete();
+    }
+}
 
-        QString xmlPath = i.arg(m_lang);
-        QFile file(xmlPath);
+QString SearchWidget::displayText(const SearchBoxStruct &data) {
+    if ("" == data.childPageName) {
+        return QString("%1 --> %2").arg(data.actualModuleName).arg(data.translateContent);
+    }
+    return QString("%1 --> %2 / %3").arg(data.actualModuleName).arg(data.childPageName).arg(data.translateContent);
+}
 
-        if (!file.exists()) {
-            qWarning() << " [SearchWidget] File not exist";
-            continue;
+//优先读取编译期生成的索引，没有索引时再解析翻译文件
+QList<SearchIndex::Entry> SearchWidget::loadEntries(const QString &translationPath) {
+    QList<SearchIndex::Entry> entries;
+
+    QString indexFile = SearchIndex::indexFileFor(translationPath, m_lang);
+    if (!indexFile.isEmpty()) {
+        SearchIndex *index = m_searchIndexMap.value(indexFile);
+        if (!index) {
+            index = new SearchIndex;
+            if (index->open(indexFile)) {
+                m_searchIndexMap.insert(indexFile, index);
+            } else {
+                delete index;
+                index = nullptr;
+            }
         }
 
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            qWarning() << " [SearchWidget] File open failed";
-            continue;
+        if (index) {
+            entries.reserve(index->count());
+            for (int i = 0; i < index->count(); i++) {
+                entries.append(index->entry(i));
+            }
+            return entries;
         }
+    }
 
-        QXmlStreamReader xmlRead(&file);
-        QStringRef dataName;
-        QXmlStreamReader::TokenType type = QXmlStreamReader::Invalid;
+    QString xmlPath = translationPath.arg(m_lang);
+    if (!QFile::exists(xmlPath)) {
+        qWarning() << " [SearchWidget] File not exist";
+        return entries;
+    }
 
-        //遍历XML文件,读取每一行的xml数据都会
-        //先进入StartElement读取出<>中的内容;
-        //再进入Characters读取出中间数据部分;
-        //最后进入时进入EndElement读取出</>中的内容
-        while (!xmlRead.atEnd()) {
-            type = xmlRead.readNext();
+    return SearchIndex::parseTs(xmlPath);
+}
 
-            switch (type) {
-            case QXmlStreamReader::StartElement:
-                m_xmlExplain = xmlRead.name().toString();
-                break;
-            case QXmlStreamReader::Characters:
-                if (!xmlRead.isWhitespace()) {
-                    if (m_xmlExplain == XML_Source) { // get xml source date
-
-                        m_searchBoxStruct.translateContent = xmlRead.text().toString();
-
-                    } else if (m_xmlExplain == XML_Title) {
-                        if (xmlRead.text().toString() != "") // translation not nullptr can set it
-                            m_searchBoxStruct.translateContent = xmlRead.text().toString();
-                    } else if (m_xmlExplain == XML_Numerusform) {
-                        if (xmlRead.text().toString() != "") // translation not nullptr can set it
-                            m_searchBoxStruct.translateContent = xmlRead.text().toString();
-                    } else if (m_xmlExplain == XML_Explain_Path) {
-                        m_searchBoxStruct.fullPagePath = xmlRead.text().toString();
-                        // follow path module name to get actual module name  ->  Left module dispaly can support
-                        // mulLanguages
-                        m_searchBoxStruct.actualModuleName =
-                                getModulesName(m_searchBoxStruct.fullPagePath.section('/', 1, 1));
-
-                        if (!isChineseFunc(m_searchBoxStruct.translateContent)) {
-                            if (!m_TxtList.contains(m_searchBoxStruct.translateContent)) {
-                                m_TxtList.append(m_searchBoxStruct.translateContent);
-                            }
-                        }
-
-                        m_EnterNewPagelist.append(m_searchBoxStruct);
-
-                        // Add search result content
-                        if (!m_bIsChinese) {
-                            if ("" == m_searchBoxStruct.childPageName) {
-                                m_model->appendRow(new QStandardItem(
-                                        QString("%1 --> %2")
-                                                .arg(m_searchBoxStruct.actualModuleName)
-                                                .arg(m_searchBoxStruct.translateContent)));
-                            } else {
-                                m_model->appendRow(new QStandardItem(
-                                        QString("%1 --> %2 / %3")
-                                                .arg(m_searchBoxStruct.actualModuleName)
-                                                .arg(m_searchBoxStruct.childPageName)
-                                                .arg(m_searchBoxStruct.translateContent)));
-                            }
-                        } else {
-                            appendChineseData(m_searchBoxStruct);
-                        }
-
-                        clearSearchData();
-                    } else {
-                        // donthing
-                    }
-                } else {
-                    // qDebug() << "  QXmlStreamReader::Characters with whitespaces.";
-                }
-                break;
-            case QXmlStreamReader::EndElement:
-#if DEBUG_XML_SWITCH
-                qDebug() << " [SearchWidget] -::EndElement: " << xmlRead.name();
-#endif
-                // if (m_xmlExplain != "") {
-                //     m_xmlExplain = "";
-                // }
-                break;
-            default:
-                break;
-            }
-        }
+//拼音转换结果缓存，模块名等重复出现的文本只转换一次
+QString SearchWidget::toPinyin(const QString &txt) {
+    auto it = m_pinyinCache.constFind(txt);
+    if (it != m_pinyinCache.constEnd())
+        return it.value();
 
-        m_xmlExplain = "";
-        clearSearchData();
-        qDebug() << " [SearchWidget] m_EnterNewPagelist.count : " << m_EnterNewPagelist.count();
+    QString pinyin = removeDigital(Chinese2Pinyin(txt));
+    m_pinyinCache.insert(txt, pinyin);
+    return pinyin;
+}
 
-        file.close();
-    }
+QString SearchWidget::toInitials(const QString &txt) {
+    auto it = m_initialsCache.constFind(txt);
+    if (it != m_initialsCache.constEnd())
+        return it.value();
+
+    QString initials = Chinese2PinyinInitials(txt);
+    m_initialsCache.insert(txt, initials);
+    return initials;
 }
 
 //Follow display content to Analysis SearchBoxStruct data
@@ -331,113 +273,10 @@ QString SearchWidget::removeDigital(QString input) {
     return value;
 }
 
-QString SearchWidget::transPinyinToChinese(QString pinyin) {
-    QString value = pinyin;
-
-    //遍历"汉字-拼音"列表,将存在的"拼音"转换为"汉字"
-    for (auto data : m_inputList) {
-        if (value == data.pinyin) {
-            value = data.chiese;
-            break;
-        }
-    }
-
-    return value;
-}
-
-QString SearchWidget::containTxtData(QString txt) {
-    QString value = txt;
-
-    //遍历"汉字-拼音"列表,将存在的"拼音"转换为"汉字"
-    for (auto data : m_inputList) {
-        if (data.chiese.contains(txt, Qt::CaseInsensitive) ||
-               data.pinyin.contains(txt, Qt::CaseInsensitive)) {
-            value = data.chiese;
-            break;
-        }
-    }
-
-    return value;
-}
-
-void SearchWidget::appendChineseData(SearchWidget::SearchBoxStruct data) {
-    if ("" == data.childPageName) {
-        //先添加使用appenRow添加Qt::EditRole数据(用于下拉框显示),然后添加Qt::UserRole数据(用于输入框搜索)
-        //Qt::EditRole数据用于显示搜索到的结果(汉字)
-        //Qt::UserRole数据用于输入框输入的数据(拼音/汉字 均可)
-        //即在输入框搜索Qt::UserRole的数据,就会在下拉框显示Qt::EditRole的数据
-        m_model->appendRow(new QStandardItem(//icon.value(),
-                                             QString("%1 --> %2").arg(data.actualModuleName).arg(data.translateContent)));
-
-        //设置汉字的Qt::UserRole数据
-        m_model->setData(m_model->index(m_model->rowCount() - 1, 0),
-                         QString("%1 --> %2")
-                         .arg(data.actualModuleName)
-                         .arg(data.translateContent),
-                         Qt::UserRole);
-
-        QString hanziTxt = QString("%1 --> %2").arg(data.actualModuleName).arg(data.translateContent);
-
-        for (auto datas : m_TxtList) {
-            for (int i = 0; i < datas.count(); i++) {
-                if( data.translateContent == datas){
-                    return;
-                }
-            }
-        }
-
-        QString pinyinTxt = QString("%1 --> %2")
-                            .arg(removeDigital(Chinese2Pinyin(data.actualModuleName)))
-                            .arg(removeDigital(Chinese2Pinyin(data.translateContent)));
-
-        //添加显示的汉字(用于拼音搜索显示)
-        m_model->appendRow(new QStandardItem(/*icon.value(),*/ hanziTxt));
-        //设置Qt::UserRole搜索的拼音(即搜索拼音会显示上面的汉字)
-        m_model->setData(m_model->index(m_model->rowCount() - 1, 0), pinyinTxt, Qt::UserRole);
-
-        SearchDataStruct transdata;
-        transdata.chiese = hanziTxt;
-        transdata.pinyin = pinyinTxt;
-        //存储 汉字和拼音 : 在选择对应的下拉框数据后,会将Qt::UserRole数据设置到输入框(即pinyin)
-        //而在输入框发送 DSearchEdit::textChanged 信号时,会遍历m_inputList,根据pinyin获取到对应汉字,再将汉字设置到输入框
-        m_inputList.append(transdata);
-    } else {
-        //先添加使用appenRow添加Qt::EditRole数据(用于下拉框显示),然后添加Qt::UserRole数据(用于输入框搜索)
-        //Qt::EditRole数据用于显示搜索到的结果(汉字)
-        //Qt::UserRole数据用于输入框输入的数据(拼音/汉字 均可)
-        //即在输入框搜索Qt::UserRole的数据,就会在下拉框显示Qt::EditRole的数据
-        m_model->appendRow(new QStandardItem(//icon.value(),
-                                             QString("%1 --> %2 / %3").arg(data.actualModuleName).arg(data.childPageName).arg(data.translateContent)));
-
-        //设置汉字的Qt::UserRole数据
-        m_model->setData(m_model->index(m_model->rowCount() - 1, 0),
-                         QString("%1 --> %2 / %3")
-                         .arg(data.actualModuleName)
-                         .arg(data.childPageName)
-                         .arg(data.translateContent),
-                         Qt::UserRole);
-
-        QString hanziTxt = QString("%1 --> %2 / %3").arg(data.actualModuleName).arg(data.childPageName).arg(data.translateContent);
-        QString pinyinTxt = QString("%1 --> %2 / %3")
-                            .arg(removeDigital(Chinese2Pinyin(data.actualModuleName)))
-                            .arg(removeDigital(Chinese2Pinyin(data.childPageName)))
-                            .arg(removeDigital(Chinese2Pinyin(data.translateContent)));
-
-        m_model->appendRow(new QStandardItem(/*icon.value(),*/ hanziTxt));
-        //设置Qt::UserRole搜索的拼音(即搜索拼音会显示上面的汉字)
-        m_model->setData(m_model->index(m_model->rowCount() - 1, 0), pinyinTxt, Qt::UserRole);
-
-        SearchDataStruct transdata;
-        transdata.chiese = hanziTxt;
-        transdata.pinyin = pinyinTxt;
-        //存储 汉字和拼音 : 在选择对应的下拉框数据后,会将Qt::UserRole数据设置到输入框(即pinyin)
-        //而在输入框发送 DSearchEdit::textChanged 信号时,会遍历m_inputList,根据pinyin获取到对应汉字,再将汉字设置到输入框
-        m_inputList.append(transdata);
-    }
-}
-
 void SearchWidget::clearSearchData() {
     m_searchBoxStruct.translateContent = "";
+    m_searchBoxStruct.translatePinyin = "";
+    m_searchBoxStruct.translateInitials = "";
     m_searchBoxStruct.actualModuleName = "";
     m_searchBoxStruct.childPageName = "";
     m_searchBoxStruct.fullPagePath = "";
@@ -448,9 +287,6 @@ void SearchWidget::setLanguage(QString type) {
 
     if (type == "zh_CN" || type == "zh_HK" || type == "zh_TW") {
         m_bIsChinese = true;
-        m_completer->setCompletionRole(Qt::UserRole); //设置ItemDataRole
-    } else {
-        m_completer->setCompletionRole(Qt::DisplayRole);
     }
 
     loadxml();
@@ -11,13 +11,12 @@
 #include <QPushButton>
 #include <QListWidget>
 #include <QListWidgetItem>
-#include <QStandardItemModel>
-#include <QXmlStreamReader>
+#include <QStringListModel>
+#include <QHash>
+
+#include "utils/searchindex.h"
+#include "utils/searchengine.h"
 
-const QString XML_Source = "source";
-const QString XML_Title = "translation";
-const QString XML_Numerusform = "numerusform";
-const QString XML_Explain_Path = "extra-contents_path";
 
 class SearchWidget : public QLineEdit
 {
@@ -25,16 +24,13 @@ class SearchWidget : public QLineEdit
 public:
     struct SearchBoxStruct {
         QString translateContent;
+        QString translatePinyin;
+        QString translateInitials;
         QString actualModuleName;
         QString childPageName;
         QString fullPagePath;
     };
 
-    struct SearchDataStruct {
-        QString chiese;
-        QString pinyin;
-    };
-
 public:
     SearchWidget(QWidget *parent = nullptr);
     ~SearchWidget() override;
@@ -51,28 +47,29 @@ Q_SIGNALS:
 
 private:
     void loadxml();
+    QList<SearchIndex::Entry> loadEntries(const QString &translationPath);
+    void updateCompletions(const QString &text);
+    QString displayText(const SearchBoxStruct &data);
+    QString toPinyin(const QString &txt);
+    QString toInitials(const QString &txt);
     SearchBoxStruct getModuleBtnString(QString value);
     QString getModulesName(QString name, bool state = true);
     QString removeDigital(QString input);
-    QString transPinyinToChinese(QString pinyin);
-    QString containTxtData(QString txt);
-    void appendChineseData(SearchBoxStruct data);
     void clearSearchData();
 
 private:
-    QStandardItemModel *m_model;
+    QStringListModel *m_model;
     QCompleter *m_completer;
     QList<SearchBoxStruct> m_EnterNewPagelist;
     SearchBoxStruct m_searchBoxStruct;
-    QString m_xmlExplain;
     QSet<QString> m_xmlFilePath;
     QString m_lang;
     QList<QPair<QString, QString>> m_moduleNameList;//用于存储如 "update"和"Update"
-    QList<SearchDataStruct> m_inputList;
     bool m_bIsChinese;
-    QString m_searchValue;
-    bool m_bIstextEdited;
     QStringList m_defaultRemoveableList;//存储已知全部模块是否存在
-    QList<QString> m_TxtList;
+    QMap<QString, SearchIndex *> m_searchIndexMap;
+    QHash<QString, QString> m_pinyinCache;
+    QHash<QString, QString> m_initialsCache;
+    SearchEngine m_searchEngine;
 };
 #endif // SEARCHWIDGET_H
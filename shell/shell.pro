@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui network x11extras svg xml dbus
+QT       += core gui network x11extras svg xml dbus concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -18,6 +18,7 @@ DEFINES += QT_DEPRECATED_WARNINGS
 
 include(../env.pri)
 include($$PROJECT_COMPONENTSOURCE/imageutil.pri)
+include(pinyin.pri)
 
 DEFINES += PLUGIN_INSTALL_DIRS='\\"$${PLUGIN_INSTALL_DIRS}\\"'
 
@@ -51,6 +52,21 @@ guideCN.path += /usr/share/kylin-user-guide/data/guide/ukui-control-center/
 target.source += $$TARGET
 target.path = /usr/bin
 
+##编译期由翻译文件生成搜索索引，运行时直接mmap
+SEARCH_INDEXER = $$OUT_PWD/searchindexer/ukcc-searchindexer
+SEARCH_TS_FILES = $$files($$PWD/res/i18n/*.ts)
+
+searchindex.input = SEARCH_TS_FILES
+searchindex.output = $$OUT_PWD/search/${QMAKE_FILE_BASE}.idx
+searchindex.commands = $$SEARCH_INDEXER ${QMAKE_FILE_IN} ${QMAKE_FILE_OUT}
+searchindex.depends = $$SEARCH_INDEXER
+searchindex.CONFIG += no_link target_predeps
+QMAKE_EXTRA_COMPILERS += searchindex
+
+searchidx.files += $$OUT_PWD/search/*.idx
+searchidx.path = /usr/share/ukui-control-center/shell/res/search/
+searchidx.CONFIG += no_check_exist
+
 
 INSTALLS +=  \
             target  \
@@ -58,7 +74,8 @@ INSTALLS +=  \
             schemes \
             face    \
             mo      \
-            guideCN
+            guideCN \
+            searchidx
 
 INCLUDEPATH += qtsingleapplication
 DEPENDPATH += qtsingleapplication
@@ -72,7 +89,6 @@ SOURCES += \
     framelessExtended/widgethandlerealize.cpp \
     homepagewidget.cpp \
     modulepagewidget.cpp \
-    pinyin.cpp \
     prescene.cpp \
     searchwidget.cpp \
     ukccabout.cpp \
@@ -80,7 +96,12 @@ SOURCES += \
     component/leftwidgetitem.cpp \
     component/clicklabel.cpp \
     utils/functionselect.cpp \
+    utils/pluginentry.cpp \
+    utils/capabilityprobe.cpp \
+    utils/searchindex.cpp \
+    utils/searchengine.cpp \
     component/hoverwidget.cpp \
+    component/pluginpagehost.cpp \
     qtsingleapplication/qtsingleapplication.cpp \
     qtsingleapplication/qtlocalpeer.cpp \
     utils/utils.cpp \
@@ -96,7 +117,6 @@ HEADERS += \
     framelessExtended/widgethandlerealize.h \
     homepagewidget.h \
     modulepagewidget.h \
-    pinyin.h \
     prescene.h \
     searchwidget.h \
     ukccabout.h \
@@ -104,7 +124,12 @@ HEADERS += \
     component/leftwidgetitem.h \
     component/clicklabel.h \
     utils/functionselect.h \
+    utils/pluginentry.h \
+    utils/capabilityprobe.h \
+    utils/searchindex.h \
+    utils/searchengine.h \
     component/hoverwidget.h \
+    component/pluginpagehost.h \
     qtsingleapplication/qtsingleapplication_copy.h \
     qtsingleapplication/qtsingleapplication.h \
     qtsingleapplication/qtlocalpeer.h \
@@ -0,0 +1,148 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "capabilityprobe.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSettings>
+#include <QTextStream>
+#include <QStandardPaths>
+#include <QGSettings>
+#include <QtConcurrent>
+#include <QDebug>
+
+//dpkg数据库，用于判断软件包是否安装
+const QString kDpkgStatusFile   = "/var/lib/dpkg/status";
+const QString kRfkillClassDir   = "/sys/class/rfkill";
+//ukui-session-manager
+const QString kSessionSchema    = "/usr/share/glib-2.0/schemas/org.ukui.session.gschema.xml";
+//ukui-screensaver
+const QString kScreensaverSchema = "/usr/share/glib-2.0/schemas/org.ukui.screensaver.gschema.xml";
+const QString kSecurityCmd      = "/usr/sbin/ksc-defender";
+const QString kCloudAccountPkg  = "kylin-sso-client";
+const QByteArray kVinoSchemas   = "org.gnome.Vino";
+
+CapabilityProbe::CapabilityProbe(QObject *parent) :
+    QObject(parent)
+{
+}
+
+CapabilityProbe::~CapabilityProbe()
+{
+    for (QFuture<bool> future : mProbes) {
+        future.waitForFinished();
+    }
+}
+
+void CapabilityProbe::start() {
+    if (!mProbes.isEmpty())
+        return;
+
+    mProbes.insert(CLOUDACCOUNT, QtConcurrent::run(&CapabilityProbe::probeCloudAccount));
+    mProbes.insert(BLUETOOTH, QtConcurrent::run(&CapabilityProbe::probeBluetooth));
+    mProbes.insert(SCREENSAVER, QtConcurrent::run(&CapabilityProbe::probeScreensaver));
+    mProbes.insert(SECURITYCENTER, QtConcurrent::run(&CapabilityProbe::probeSecurityCenter));
+    mProbes.insert(VINO, QtConcurrent::run(&CapabilityProbe::probeVino));
+}
+
+bool CapabilityProbe::isAvailable(Capability capability) {
+    if (mProbes.isEmpty())
+        start();
+
+    //尚未完成的探测在此等待
+    return mProbes.value(capability).result();
+}
+
+bool CapabilityProbe::probeCloudAccount() {
+    return isPackageInstalled(kCloudAccountPkg);
+}
+
+bool CapabilityProbe::probeBluetooth() {
+    //等价于rfkill list，直接读取内核导出的rfkill设备类型
+    QDir rfkillDir(kRfkillClassDir);
+    for (QString device : rfkillDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        QFile typeFile(rfkillDir.absoluteFilePath(device + "/type"));
+        if (!typeFile.open(QIODevice::ReadOnly))
+            continue;
+        if (typeFile.readAll().trimmed() == "bluetooth")
+            return true;
+    }
+    return false;
+}
+
+bool CapabilityProbe::probeScreensaver() {
+    //屏保功能依赖ukui-session-manager
+    return QFileInfo::exists(kScreensaverSchema) && QFileInfo::exists(kSessionSchema);
+}
+
+bool CapabilityProbe::probeSecurityCenter() {
+    return QFileInfo::exists(kSecurityCmd);
+}
+
+bool CapabilityProbe::probeVino() {
+    return QGSettings::isSchemaInstalled(kVinoSchemas);
+}
+
+bool CapabilityProbe::isPackageInstalled(const QString &package) {
+    QFileInfo statusInfo(kDpkgStatusFile);
+    if (!statusInfo.exists())
+        return false;
+
+    //dpkg数据库未变化时直接使用上次的结果
+    QString cacheFile = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+            + "/ukui-control-center/capability.conf";
+    QSettings cache(cacheFile, QSettings::IniFormat);
+    qint64 mtime = statusInfo.lastModified().toMSecsSinceEpoch();
+    cache.beginGroup(package);
+    if (cache.value("mtime").toLongLong() == mtime && cache.contains("installed")) {
+        return cache.value("installed").toBool();
+    }
+
+    QFile statusFile(kDpkgStatusFile);
+    if (!statusFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning() << "open" << kDpkgStatusFile << "failed";
+        return false;
+    }
+
+    bool installed = false;
+    bool inStanza = false;
+    QString packageLine = QString("Package: %1").arg(package);
+    QTextStream stream(&statusFile);
+    while (!stream.atEnd()) {
+        QString line = stream.readLine();
+        if (line.startsWith("Package: ")) {
+            if (inStanza)
+                break;
+            inStanza = (line == packageLine);
+        } else if (inStanza && line.startsWith("Status: ")) {
+            installed = line.endsWith(" installed");
+            break;
+        }
+    }
+    statusFile.close();
+
+    cache.setValue("mtime", mtime);
+    cache.setValue("installed", installed);
+    cache.endGroup();
+
+    return installed;
+}
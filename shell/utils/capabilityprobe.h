@@ -17,34 +17,48 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
  *
  */
-#ifndef WORKEROBJECT_H
-#define WORKEROBJECT_H
+#ifndef CAPABILITYPROBE_H
+#define CAPABILITYPROBE_H
 
 #include <QObject>
-#include <QPixmap>
+#include <QMap>
+#include <QFuture>
 
-#include "xmlhandle.h"
-
-class WorkerObject : public QObject
+/*
+ * 插件加载前的环境探测：各探测项并行运行在全局线程池中，
+ * 不再逐个fork dpkg/rfkill等命令阻塞GUI线程
+ */
+class CapabilityProbe : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit WorkerObject();
-    ~WorkerObject();
+    enum Capability {
+        CLOUDACCOUNT,
+        BLUETOOTH,
+        SCREENSAVER,
+        SECURITYCENTER,
+        VINO,
+    };
+
+    explicit CapabilityProbe(QObject *parent = nullptr);
+    ~CapabilityProbe();
 
 public:
-    void run();
+    void start();
+    bool isAvailable(Capability capability);
 
 private:
-    XmlHandle * xmlHandleObj;
+    static bool probeCloudAccount();
+    static bool probeBluetooth();
+    static bool probeScreensaver();
+    static bool probeSecurityCenter();
+    static bool probeVino();
 
-    QMap<QString, QMap<QString, QString> > wallpaperinfosMap;
-
-Q_SIGNALS:
-    void pixmapGenerate(QPixmap pixmap, QString filename);
-    void workComplete(QMap<QString, QMap<QString, QString>> wpInfoMaps);
+    static bool isPackageInstalled(const QString &package);
 
+private:
+    QMap<Capability, QFuture<bool>> mProbes;
 };
 
-#endif // WORKEROBJECT_H
+#endif // CAPABILITYPROBE_H
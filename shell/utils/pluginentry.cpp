@@ -0,0 +1,138 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "pluginentry.h"
+#include "functionselect.h"
+#include "keyvalueconverter.h"
+#include "../interface.h"
+
+#include <QFileInfo>
+#include <QJsonObject>
+#include <QMetaEnum>
+#include <QDebug>
+
+PluginEntry::PluginEntry(const QString &filePath, QObject *parent) :
+    QObject(parent),
+    mLoader(filePath),
+    mInstance(nullptr),
+    mPluginType(-1),
+    mTranslationPath(QStringLiteral(":/i18n/%1.ts"))
+{
+}
+
+PluginEntry::~PluginEntry()
+{
+}
+
+bool PluginEntry::probe() {
+    if (readMetaData())
+        return true;
+
+    //未提供json元数据的插件，退回到直接加载
+    CommonInterface * pluginInstance = instance();
+    if (!pluginInstance)
+        return false;
+
+    readInterface(pluginInstance);
+    return true;
+}
+
+CommonInterface * PluginEntry::instance() {
+    if (mInstance)
+        return mInstance;
+
+    QObject * plugin = mLoader.instance();
+    if (!plugin) {
+        qDebug() << fileName() << "Load Failed: " << mLoader.errorString() << "\n";
+        return nullptr;
+    }
+
+    mInstance = qobject_cast<CommonInterface *>(plugin);
+    if (!mInstance) {
+        qDebug() << fileName() << "is not a CommonInterface plugin";
+        return nullptr;
+    }
+
+    qDebug() << "Load Plugin :" << fileName() << "->" << mInstance->get_plugin_name();
+    return mInstance;
+}
+
+bool PluginEntry::isLoaded() const {
+    return mInstance != nullptr;
+}
+
+QString PluginEntry::fileName() const {
+    return QFileInfo(mLoader.fileName()).fileName();
+}
+
+QString PluginEntry::name() const {
+    return mName;
+}
+
+QString PluginEntry::pluginName() const {
+    return mPluginName;
+}
+
+int PluginEntry::pluginType() const {
+    return mPluginType;
+}
+
+QString PluginEntry::translationPath() const {
+    return mTranslationPath;
+}
+
+bool PluginEntry::readMetaData() {
+    //QPluginLoader::metaData只读取库文件中的元数据段，不会dlopen插件
+    if (mLoader.metaData().value("IID").toString() != CommonInterface_iid)
+        return false;
+
+    QJsonObject metaData = mLoader.metaData().value("MetaData").toObject();
+    if (metaData.isEmpty())
+        return false;
+
+    QMetaEnum metaModule = QMetaEnum::fromType<KeyValueConverter::FunType>();
+    int type = metaModule.keyToValue(metaData.value("type").toString().toUpper().toLatin1().constData());
+    if (type < 0 || type >= TOTALMODULES || type >= FunctionSelect::funcinfoList.length())
+        return false;
+
+    //功能名与FunctionSelect中的nameString对应，翻译名以主程序为准
+    QString function = metaData.value("function").toString();
+    for (const FuncInfo &info : FunctionSelect::funcinfoList.at(type)) {
+        if (info.nameString == function) {
+            mPluginName = info.namei18nString;
+            break;
+        }
+    }
+    if (mPluginName.isEmpty())
+        return false;
+
+    mName = metaData.value("name").toString();
+    mPluginType = type;
+    if (metaData.contains("translationPath"))
+        mTranslationPath = metaData.value("translationPath").toString();
+
+    return true;
+}
+
+void PluginEntry::readInterface(CommonInterface *pluginInstance) {
+    mName = pluginInstance->name();
+    mPluginName = pluginInstance->get_plugin_name();
+    mPluginType = pluginInstance->get_plugin_type();
+    mTranslationPath = pluginInstance->translationPath();
+}
@@ -0,0 +1,65 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef PLUGINENTRY_H
+#define PLUGINENTRY_H
+
+#include <QObject>
+#include <QPluginLoader>
+
+class CommonInterface;
+
+/*
+ * 插件条目：从Q_PLUGIN_METADATA的json中读取插件名称、类型及搜索翻译路径，
+ * 不实例化插件；首次切换到该功能页时才dlopen插件
+ */
+class PluginEntry : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PluginEntry(const QString &filePath, QObject *parent = nullptr);
+    ~PluginEntry();
+
+public:
+    bool probe();
+    CommonInterface * instance();
+    bool isLoaded() const;
+
+    QString fileName() const;
+    QString name() const;
+    QString pluginName() const;
+    int pluginType() const;
+    QString translationPath() const;
+
+private:
+    bool readMetaData();
+    void readInterface(CommonInterface * pluginInstance);
+
+private:
+    QPluginLoader mLoader;
+    CommonInterface * mInstance;
+
+    QString mName;
+    QString mPluginName;
+    int mPluginType;
+    QString mTranslationPath;
+};
+
+#endif // PLUGINENTRY_H
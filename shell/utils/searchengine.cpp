@@ -0,0 +1,291 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "searchengine.h"
+
+#include <QSet>
+#include <algorithm>
+
+//匹配得分，同一文档取各关键字中的最高分
+const int kScoreExact     = 100;
+const int kScorePrefix    = 90;
+const int kScoreToken     = 70;
+const int kScoreSubstring = 50;
+const int kScoreFuzzy     = 30;
+
+static bool isTokenChar(const QChar &ch) {
+    return ch.isLetterOrNumber();
+}
+
+//汉字没有分词，每个字都可以作为匹配起点
+static bool isHanChar(const QChar &ch) {
+    return ch.script() == QChar::Script_Han;
+}
+
+SearchEngine::SearchEngine()
+{
+    clear();
+}
+
+SearchEngine::~SearchEngine()
+{
+}
+
+void SearchEngine::clear() {
+    mKeys.clear();
+    mTrigrams.clear();
+    mTrie.clear();
+    mTrie.append(TrieNode());
+}
+
+void SearchEngine::addDocument(int id, const QStringList &keys) {
+    for (const QString &key : keys) {
+        QString text = key.toLower();
+        if (text.isEmpty())
+            continue;
+
+        int keyIndex = mKeys.length();
+        mKeys.append(Key{id, text});
+
+        //前缀树：插入每个词及词内每个汉字开始的后缀
+        int start = -1;
+        for (int i = 0; i <= text.length(); i++) {
+            bool tokenChar = i < text.length() && isTokenChar(text.at(i));
+            if (tokenChar && start < 0) {
+                start = i;
+            } else if (!tokenChar && start >= 0) {
+                for (int from = start; from < i; from++) {
+                    if (from == start || isHanChar(text.at(from)))
+                        insertTrie(keyIndex, text, from, i);
+                }
+                start = -1;
+            }
+        }
+
+        //三元组倒排索引
+        for (quint64 gram : trigrams(text)) {
+            QVector<int> &postings = mTrigrams[gram];
+            if (postings.isEmpty() || postings.last() != keyIndex)
+                postings.append(keyIndex);
+        }
+    }
+}
+
+QList<int> SearchEngine::query(const QString &text, int limit) const {
+    struct Score {
+        int score;
+        int length;
+    };
+
+    const QString q = text.trimmed().toLower();
+    QList<int> result;
+    if (q.isEmpty() || limit <= 0)
+        return result;
+
+    QHash<int, Score> scores;
+    auto addScore = [&](int keyIndex, int score) {
+        const Key &key = mKeys.at(keyIndex);
+        if (key.text == q) {
+            score = kScoreExact;
+        } else if (score > kScoreSubstring && key.text.startsWith(q)) {
+            score = kScorePrefix;
+        }
+
+        auto it = scores.find(key.document);
+        if (it == scores.end()) {
+            scores.insert(key.document, Score{score, key.text.length()});
+        } else if (score > it->score || (score == it->score && key.text.length() < it->length)) {
+            it->score = score;
+            it->length = key.text.length();
+        }
+    };
+
+    //1. 前缀树：查询中的每个词都要匹配关键字中某个词的前缀
+    const QStringList tokens = tokenize(q);
+    QSet<int> tokenMatched;
+    for (int i = 0; i < tokens.length(); i++) {
+        const TrieNode * node = findTrie(tokens.at(i));
+        if (!node) {
+            tokenMatched.clear();
+            break;
+        }
+
+        QSet<int> keys;
+        for (int keyIndex : node->keys) {
+            if (i == 0 || tokenMatched.contains(keyIndex))
+                keys.insert(keyIndex);
+        }
+        tokenMatched = keys;
+    }
+    for (int keyIndex : tokenMatched) {
+        addScore(keyIndex, kScoreToken);
+    }
+
+    //2. 子串：候选为包含查询全部三元组的关键字
+    const QVector<quint64> grams = trigrams(q);
+    if (!grams.isEmpty()) {
+        QVector<const QVector<int> *> lists;
+        for (quint64 gram : grams) {
+            auto it = mTrigrams.constFind(gram);
+            if (it == mTrigrams.constEnd()) {
+                lists.clear();
+                break;
+            }
+            lists.append(&it.value());
+        }
+
+        if (!lists.isEmpty()) {
+            std::sort(lists.begin(), lists.end(), [](const QVector<int> *a, const QVector<int> *b) {
+                return a->size() < b->size();
+            });
+            for (int keyIndex : *lists.first()) {
+                if (!tokenMatched.contains(keyIndex) && mKeys.at(keyIndex).text.contains(q))
+                    addScore(keyIndex, kScoreSubstring);
+            }
+        }
+    } else {
+        //不足三个字符时没有三元组，直接扫描全部关键字，保持原有的任意位置子串匹配
+        for (int keyIndex = 0; keyIndex < mKeys.length(); keyIndex++) {
+            if (!tokenMatched.contains(keyIndex) && mKeys.at(keyIndex).text.contains(q))
+                addScore(keyIndex, kScoreSubstring);
+        }
+    }
+
+    //3. 容错：结果不足时，对共享足够三元组的关键字按编辑距离匹配
+    if (scores.size() < limit && tokens.length() == 1 && q.length() >= 4) {
+        const int maxDistance = q.length() >= 8 ? 2 : 1;
+        const int minShared = qMax(1, grams.length() - 3 * maxDistance);
+
+        QHash<int, int> shared;
+        for (quint64 gram : grams) {
+            for (int keyIndex : mTrigrams.value(gram)) {
+                shared[keyIndex]++;
+            }
+        }
+
+        for (auto it = shared.constBegin(); it != shared.constEnd(); ++it) {
+            if (it.value() < minShared || scores.contains(mKeys.at(it.key()).document))
+                continue;
+
+            int best = maxDistance + 1;
+            for (const QString &word : tokenize(mKeys.at(it.key()).text)) {
+                //正在输入时只比较词的同长前缀
+                best = qMin(best, editDistance(q, word.left(q.length()), maxDistance));
+                best = qMin(best, editDistance(q, word, maxDistance));
+            }
+            if (best <= maxDistance)
+                addScore(it.key(), kScoreFuzzy - best * 10);
+        }
+    }
+
+    QList<int> documents = scores.keys();
+    std::sort(documents.begin(), documents.end(), [&scores](int a, int b) {
+        const Score sa = scores.value(a);
+        const Score sb = scores.value(b);
+        if (sa.score != sb.score)
+            return sa.score > sb.score;
+        if (sa.length != sb.length)
+            return sa.length < sb.length;
+        return a < b;
+    });
+
+    return documents.mid(0, limit);
+}
+
+void SearchEngine::insertTrie(int keyIndex, const QString &text, int from, int to) {
+    int node = 0;
+    for (int i = from; i < to; i++) {
+        const QChar ch = text.at(i);
+        int child = mTrie[node].children.value(ch, -1);
+        if (child < 0) {
+            child = mTrie.length();
+            mTrie[node].children.insert(ch, child);
+            mTrie.append(TrieNode());
+        }
+        node = child;
+
+        QVector<int> &keys = mTrie[node].keys;
+        if (keys.isEmpty() || keys.last() != keyIndex)
+            keys.append(keyIndex);
+    }
+}
+
+const SearchEngine::TrieNode * SearchEngine::findTrie(const QString &prefix) const {
+    int node = 0;
+    for (const QChar &ch : prefix) {
+        node = mTrie.at(node).children.value(ch, -1);
+        if (node < 0)
+            return nullptr;
+    }
+    return &mTrie.at(node);
+}
+
+QStringList SearchEngine::tokenize(const QString &text) {
+    QStringList tokens;
+    int start = -1;
+    for (int i = 0; i <= text.length(); i++) {
+        bool tokenChar = i < text.length() && isTokenChar(text.at(i));
+        if (tokenChar && start < 0) {
+            start = i;
+        } else if (!tokenChar && start >= 0) {
+            tokens.append(text.mid(start, i - start));
+            start = -1;
+        }
+    }
+    return tokens;
+}
+
+QVector<quint64> SearchEngine::trigrams(const QString &text) {
+    QVector<quint64> grams;
+    for (int i = 0; i + 2 < text.length(); i++) {
+        quint64 gram = (quint64(text.at(i).unicode()) << 32)
+                | (quint64(text.at(i + 1).unicode()) << 16)
+                | quint64(text.at(i + 2).unicode());
+        if (!grams.contains(gram))
+            grams.append(gram);
+    }
+    return grams;
+}
+
+int SearchEngine::editDistance(const QString &a, const QString &b, int maxDistance) {
+    if (qAbs(a.length() - b.length()) > maxDistance)
+        return maxDistance + 1;
+
+    QVector<int> prev(b.length() + 1);
+    QVector<int> cur(b.length() + 1);
+    for (int j = 0; j <= b.length(); j++) {
+        prev[j] = j;
+    }
+
+    for (int i = 1; i <= a.length(); i++) {
+        cur[0] = i;
+        int rowMin = cur[0];
+        for (int j = 1; j <= b.length(); j++) {
+            int cost = (a.at(i - 1) == b.at(j - 1)) ? 0 : 1;
+            cur[j] = qMin(qMin(prev[j] + 1, cur[j - 1] + 1), prev[j - 1] + cost);
+            rowMin = qMin(rowMin, cur[j]);
+        }
+        //整行都超过阈值时提前结束
+        if (rowMin > maxDistance)
+            return maxDistance + 1;
+        prev.swap(cur);
+    }
+
+    return prev[b.length()];
+}
@@ -0,0 +1,70 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef SEARCHENGINE_H
+#define SEARCHENGINE_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/*
+ * 设置搜索引擎：每个文档由若干关键字(显示文本、全拼、拼音首字母)组成，
+ * 前缀树支持词首/汉字子串匹配，三元组倒排索引支持子串及容错(编辑距离)匹配，
+ * 不足三个字符的查询退化为逐个关键字的子串扫描，
+ * 查询结果按匹配程度排序
+ */
+class SearchEngine
+{
+public:
+    SearchEngine();
+    ~SearchEngine();
+
+public:
+    void clear();
+    void addDocument(int id, const QStringList &keys);
+    QList<int> query(const QString &text, int limit) const;
+
+private:
+    struct Key {
+        int document;
+        QString text;
+    };
+
+    struct TrieNode {
+        QHash<QChar, int> children;
+        QVector<int> keys;
+    };
+
+    void insertTrie(int keyIndex, const QString &text, int from, int to);
+    const TrieNode * findTrie(const QString &prefix) const;
+
+    static QStringList tokenize(const QString &text);
+    static QVector<quint64> trigrams(const QString &text);
+    static int editDistance(const QString &a, const QString &b, int maxDistance);
+
+private:
+    QVector<Key> mKeys;
+    QVector<TrieNode> mTrie;
+    QHash<quint64, QVector<int>> mTrigrams;
+};
+
+#endif // SEARCHENGINE_H
@@ -0,0 +1,226 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "searchindex.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QXmlStreamReader>
+#include <QDebug>
+
+#include <cstring>
+
+const char kIndexMagic[4]   = {'U', 'K', 'S', 'I'};
+const quint16 kIndexVersion = 2;
+const quint16 kByteOrderMark = 0xFEFF;
+
+//内置翻译文件及其对应的编译期索引
+const QString kBuiltinTranslation = ":/i18n/%1.ts";
+const QString kIndexInstallDir    = "/usr/share/ukui-control-center/shell/res/search/";
+
+SearchIndex::SearchIndex() :
+    mData(nullptr),
+    mSize(0),
+    mHeader(nullptr),
+    mRecords(nullptr),
+    mPool(nullptr)
+{
+}
+
+SearchIndex::~SearchIndex()
+{
+    close();
+}
+
+bool SearchIndex::open(const QString &indexFile) {
+    close();
+
+    mFile.setFileName(indexFile);
+    if (!mFile.open(QIODevice::ReadOnly))
+        return false;
+
+    mSize = mFile.size();
+    if (mSize < qint64(sizeof(Header))) {
+        close();
+        return false;
+    }
+
+    mData = mFile.map(0, mSize);
+    if (!mData) {
+        close();
+        return false;
+    }
+
+    mHeader = reinterpret_cast<const Header *>(mData);
+    if (memcmp(mHeader->magic, kIndexMagic, sizeof(kIndexMagic)) != 0
+            || mHeader->version != kIndexVersion
+            || mHeader->byteOrder != kByteOrderMark) {
+        qWarning() << "[SearchIndex]" << indexFile << "has unsupported format";
+        close();
+        return false;
+    }
+
+    qint64 recordsEnd = sizeof(Header) + qint64(mHeader->count) * sizeof(Record);
+    if (recordsEnd > mHeader->poolOffset || mHeader->poolOffset > mSize || mHeader->poolOffset % 2) {
+        qWarning() << "[SearchIndex]" << indexFile << "is corrupted";
+        close();
+        return false;
+    }
+
+    mRecords = reinterpret_cast<const Record *>(mData + sizeof(Header));
+    mPool = reinterpret_cast<const QChar *>(mData + mHeader->poolOffset);
+    return true;
+}
+
+void SearchIndex::close() {
+    if (mData) {
+        mFile.unmap(const_cast<uchar *>(mData));
+    }
+    if (mFile.isOpen()) {
+        mFile.close();
+    }
+
+    mData = nullptr;
+    mSize = 0;
+    mHeader = nullptr;
+    mRecords = nullptr;
+    mPool = nullptr;
+}
+
+bool SearchIndex::isOpen() const {
+    return mData != nullptr;
+}
+
+int SearchIndex::count() const {
+    return mHeader ? int(mHeader->count) : 0;
+}
+
+SearchIndex::Entry SearchIndex::entry(int index) const {
+    Entry data;
+    if (index < 0 || index >= count())
+        return data;
+
+    const Record &record = mRecords[index];
+    data.translateContent = poolString(record.offset[0], record.length[0]);
+    data.fullPagePath = poolString(record.offset[1], record.length[1]);
+    data.pinyin = poolString(record.offset[2], record.length[2]);
+    data.initials = poolString(record.offset[3], record.length[3]);
+    return data;
+}
+
+QString SearchIndex::poolString(quint32 offset, quint32 length) const {
+    qint64 end = mHeader->poolOffset + (qint64(offset) + length) * sizeof(QChar);
+    if (end > mSize)
+        return QString();
+
+    //直接引用映射内存，不拷贝
+    return QString::fromRawData(mPool + offset, int(length));
+}
+
+QList<SearchIndex::Entry> SearchIndex::parseTs(const QString &tsFile) {
+    QList<Entry> entries;
+
+    QFile file(tsFile);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning() << "[SearchIndex]" << tsFile << "open failed";
+        return entries;
+    }
+
+    QXmlStreamReader xmlRead(&file);
+    QString element;
+    Entry data;
+
+    //source为原文，translation/numerusform不为空时覆盖为译文，
+    //读到extra-contents_path时得到一条完整的搜索数据
+    while (!xmlRead.atEnd()) {
+        switch (xmlRead.readNext()) {
+        case QXmlStreamReader::StartElement:
+            element = xmlRead.name().toString();
+            break;
+        case QXmlStreamReader::Characters:
+            if (xmlRead.isWhitespace())
+                break;
+            if (element == "source") {
+                data.translateContent = xmlRead.text().toString();
+            } else if (element == "translation" || element == "numerusform") {
+                if (!xmlRead.text().isEmpty())
+                    data.translateContent = xmlRead.text().toString();
+            } else if (element == "extra-contents_path") {
+                data.fullPagePath = xmlRead.text().toString();
+                entries.append(data);
+                data = Entry();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    file.close();
+    return entries;
+}
+
+bool SearchIndex::write(const QString &indexFile, const QList<Entry> &entries) {
+    QVector<Record> records;
+    QString pool;
+
+    auto addString = [&pool](const QString &str, quint32 &offset, quint32 &length) {
+        offset = quint32(pool.length());
+        length = quint32(str.length());
+        pool.append(str);
+    };
+
+    for (const Entry &data : entries) {
+        Record record;
+        addString(data.translateContent, record.offset[0], record.length[0]);
+        addString(data.fullPagePath, record.offset[1], record.length[1]);
+        addString(data.pinyin, record.offset[2], record.length[2]);
+        addString(data.initials, record.offset[3], record.length[3]);
+        records.append(record);
+    }
+
+    Header header;
+    memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+    header.version = kIndexVersion;
+    header.byteOrder = kByteOrderMark;
+    header.count = quint32(records.count());
+    header.poolOffset = quint32(sizeof(Header) + records.count() * sizeof(Record));
+
+    QDir().mkpath(QFileInfo(indexFile).absolutePath());
+    QFile file(indexFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[SearchIndex]" << indexFile << "open failed";
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char *>(records.constData()), records.count() * sizeof(Record));
+    file.write(reinterpret_cast<const char *>(pool.constData()), pool.length() * sizeof(QChar));
+    file.close();
+
+    return file.error() == QFile::NoError;
+}
+
+QString SearchIndex::indexFileFor(const QString &translationPath, const QString &lang) {
+    //只有主程序内置的翻译文件在编译期生成了索引
+    if (translationPath != kBuiltinTranslation)
+        return QString();
+
+    return kIndexInstallDir + lang + ".idx";
+}
@@ -0,0 +1,83 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ *
+ * Copyright (C) 2019 Tianjin KYLIN Information Technology Co., Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QFile>
+#include <QList>
+#include <QString>
+
+/*
+ * 搜索索引：编译期由ukcc-searchindexer将翻译文件(.ts)中带extra-contents_path的条目
+ * 及其拼音写入紧凑的二进制文件，运行时直接mmap读取，不再解析XML
+ *
+ * 文件布局: Header | Record[count] | UTF-16字符串池
+ */
+class SearchIndex
+{
+public:
+    struct Entry {
+        QString translateContent;
+        QString fullPagePath;
+        QString pinyin;
+        QString initials;
+    };
+
+public:
+    SearchIndex();
+    ~SearchIndex();
+
+    bool open(const QString &indexFile);
+    void close();
+    bool isOpen() const;
+
+    int count() const;
+    Entry entry(int index) const;
+
+    static QList<Entry> parseTs(const QString &tsFile);
+    static bool write(const QString &indexFile, const QList<Entry> &entries);
+    static QString indexFileFor(const QString &translationPath, const QString &lang);
+
+private:
+    struct Header {
+        char magic[4];
+        quint16 version;
+        quint16 byteOrder;
+        quint32 count;
+        quint32 poolOffset;
+    };
+
+    struct Record {
+        quint32 offset[4];
+        quint32 length[4];
+    };
+
+    QString poolString(quint32 offset, quint32 length) const;
+
+private:
+    QFile mFile;
+    const uchar * mData;
+    qint64 mSize;
+    const Header * mHeader;
+    const Record * mRecords;
+    const QChar * mPool;
+};
+
+#endif // SEARCHINDEX_H
@@ -113,7 +113,15 @@ void Utils::setCLIName(QCommandLineParser &parser) {
     parser.addOption(aboutRoleOption);
 }
 
+// 启动时主窗口、首页和模块页都要查询，只向会话服务请求一次，之后由变化信号更新
+static QVariantMap moduleHideStatus;
+static bool moduleHideStatusLoaded = false;
+
 QVariantMap Utils::getModuleHideStatus() {
+    if (moduleHideStatusLoaded) {
+        return moduleHideStatus;
+    }
+
     QDBusInterface m_interface( "org.ukui.ukcc.session",
                                 "/",
                                 "org.ukui.ukcc.session.interface",
@@ -122,6 +130,13 @@ QVariantMap Utils::getModuleHideStatus() {
     QDBusReply<QVariantMap> obj_reply = m_interface.call("getModuleHideStatus");
     if (!obj_reply.isValid()) {
         qDebug()<<"execute dbus method getModuleHideStatus failed";
+        return obj_reply.value();
     }
-    return obj_reply.value();
+    setModuleHideStatus(obj_reply.value());
+    return moduleHideStatus;
+}
+
+void Utils::setModuleHideStatus(const QVariantMap &status) {
+    moduleHideStatus = status;
+    moduleHideStatusLoaded = true;
 }
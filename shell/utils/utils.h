@@ -35,6 +35,7 @@ namespace Utils
     void centerToScreen(QWidget *widget);
     void setCLIName(QCommandLineParser &parser);
     QVariantMap getModuleHideStatus();
+    void setModuleHideStatus(const QVariantMap &status);
 
 }
 #endif // UTILS_H
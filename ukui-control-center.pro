@@ -5,8 +5,11 @@ CONFIG += ordered
 SUBDIRS = \
     checkUserPwd \
     registeredQDbus \
+    commonComponent/DesktopEntryIndex \
+    commonComponent/WallpaperCatalog \
     plugins\
     registeredSession \
+    shell/searchindexer \
     shell \
     group-manager-server \
 #    tastenbrett \